@@ -148,5 +148,28 @@ namespace Chroma
   }
 
 
-}
+  //! Do two sets of params build the same clover term?
+  bool sameCloverTermParams(const CloverFermActParams& a, const CloverFermActParams& b)
+  {
+    if (toBool(a.Mass != b.Mass) ||
+	toBool(a.clovCoeffR != b.clovCoeffR) ||
+	toBool(a.clovCoeffT != b.clovCoeffT))
+      return false;
+
+    if (a.anisoParam.anisoP != b.anisoParam.anisoP)
+      return false;
+
+    if (a.anisoParam.anisoP &&
+	(a.anisoParam.t_dir != b.anisoParam.t_dir ||
+	 toBool(a.anisoParam.xi_0 != b.anisoParam.xi_0) ||
+	 toBool(a.anisoParam.nu != b.anisoParam.nu)))
+      return false;
 
+    if (a.sub_zero_usedP != b.sub_zero_usedP ||
+	(a.sub_zero_usedP && toBool(a.sub_zero != b.sub_zero)))
+      return false;
+
+    return true;
+  }
+
+}
@@ -45,6 +45,16 @@ namespace Chroma
 
   /*! \ingroup fermacts */
   void write(XMLWriter& xml, const string& path, const CloverFermActParams& param);
+
+  //! Do two sets of params build the same clover term?
+  /*!
+   * \ingroup fermacts
+   *
+   * Compares the mass, the clover coefficients, the anisotropy and the
+   * zero point energy. The twisted mass is applied outside the clover
+   * term and is not compared.
+   */
+  bool sameCloverTermParams(const CloverFermActParams& a, const CloverFermActParams& b);
 }
 
 #endif
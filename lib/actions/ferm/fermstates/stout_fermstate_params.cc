@@ -16,6 +16,7 @@ namespace Chroma
     smear_in_this_dirP.resize(Nd);
 
     n_smear = 0;
+    checkpoint_interval = 1;
     rho = sm_fact = zero;
     smear_in_this_dirP = true;
   }
@@ -36,6 +37,11 @@ namespace Chroma
       read(paramtop, "rho", sm_fact);
       read(paramtop, "n_smear", n_smear);
 
+      checkpoint_interval = 1;
+      if( paramtop.count("checkpoint_interval") == 1 ) { 
+	read(paramtop, "checkpoint_interval", checkpoint_interval);
+      }
+
       switch (version) 
       {
       case 1:
@@ -85,6 +91,13 @@ namespace Chroma
     
 
     // Sanity check
+    if (checkpoint_interval < 1)
+    {
+      QDPIO::cerr << __func__ << ": invalid checkpoint_interval = " << checkpoint_interval 
+		  << ", expecting checkpoint_interval >= 1" << endl;
+      QDP_abort(1);
+    }
+
     if (smear_in_this_dirP.size() != Nd)
     {
       QDPIO::cerr << __func__ << ": invalid size of smear_in_this_dirP, expecting size=Nd" << endl;
@@ -136,6 +149,9 @@ namespace Chroma
     write(xml, "rho", p.sm_fact);
     write(xml, "n_smear", p.n_smear);
     write(xml, "smear_in_this_dirP", p.smear_in_this_dirP);
+    if (p.checkpoint_interval > 1) {
+      write(xml, "checkpoint_interval", p.checkpoint_interval);
+    }
     pop(xml);
   }
 
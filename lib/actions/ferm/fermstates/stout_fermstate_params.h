@@ -24,6 +24,11 @@ namespace Chroma
 
     int            n_smear;
     Real           sm_fact;
+
+    //! Keep the links only at every checkpoint_interval-th smearing level
+    /*! The levels in between are recomputed during the force recursion.
+     *  The default of 1 keeps all levels. */
+    int            checkpoint_interval;
   };
 
   void read(XMLReader& xml, const std::string& path, StoutFermStateParams& p);
@@ -30,6 +30,11 @@ namespace Chroma
   /*! @ingroup fermstates
    *
    * Holds a stout smeared state
+   *
+   * If params.checkpoint_interval = k > 1 only the thin links and every
+   * k-th smearing level are kept. The force recursion recomputes the
+   * levels between two checkpoints, one segment at a time, so about
+   * n_smear/k + k copies of the links are held instead of n_smear+1.
    */
   template< typename T, typename P, typename Q>
   class StoutFermState : public FermState<T,P,Q>
@@ -88,9 +93,14 @@ namespace Chroma
       
       // Now if the state is smeared recurse down.
       
+      // Links recomputed between two checkpoints
+      multi1d< Q > segment;
+      int seg_start = -1;
+
       for(int level=params.n_smear; level > 0; level--) {
 	
-	Stouting::deriv_recurse(F_thin, params.smear_in_this_dirP, params.rho, smeared_links[level-1]);
+	Stouting::deriv_recurse(F_thin, params.smear_in_this_dirP, params.rho, 
+				getSmearedLinks(level-1, segment, seg_start));
 	
 	fbc->zero(F_thin);
 	
@@ -133,6 +143,51 @@ namespace Chroma
     // Hide default constructor
     StoutFermState(){}
 
+    //! Is the level kept in smeared_links ?
+    bool isCheckpoint(int level) const
+    {
+      return (level % params.checkpoint_interval) == 0;
+    }
+
+    //! Smear one level up and apply the BCs as in create()
+    void smearUp(const Q& current, Q& next) const
+    {
+      next.resize(Nd);
+      Stouting::smear_links(current, next, params.smear_in_this_dirP, params.rho);
+      if( fbc->nontrivialP() ) {
+	fbc->modify( next );    
+      }
+    }
+
+    //! Get the links at some smearing level
+    /*! If the level is not a checkpoint, the segment of levels starting 
+     *  at the checkpoint below it is recomputed into segment. seg_start
+     *  holds the first level in segment (-1 if none) and is updated. */
+    const Q& getSmearedLinks(int level, multi1d< Q >& segment, int& seg_start) const
+    {
+      if( isCheckpoint(level) ) { 
+	return smeared_links[level];
+      }
+
+      int start = level - (level % params.checkpoint_interval);
+      if( start != seg_start ) { 
+	int len = params.checkpoint_interval;
+	if( start + len > params.n_smear ) { 
+	  len = params.n_smear - start;
+	}
+
+	segment.resize(len);
+	segment[0].resize(Nd);
+	segment[0] = smeared_links[start];
+	for(int i=1; i < len; i++) { 
+	  smearUp(segment[i-1], segment[i]);
+	}
+	seg_start = start;
+      }
+
+      return segment[level - start];
+    }
+
 
     // create function
     void create(Handle< FermBC<T,P,Q> > fbc_,
@@ -144,10 +199,13 @@ namespace Chroma
       fbc = fbc_;
       params = p_;
     
-      // Allocate smeared and thin links
+      // Allocate smeared and thin links. Only the checkpointed
+      // levels are allocated
       smeared_links.resize(params.n_smear + 1);
       for(int i=0; i <= params.n_smear; i++) { 
-	smeared_links[i].resize(Nd);
+	if( isCheckpoint(i) ) {
+	  smeared_links[i].resize(Nd);
+	}
       }
       
       
@@ -161,18 +219,22 @@ namespace Chroma
       }
       
       // Iterate up the smearings
+      Q current(smeared_links[0]);
+      Q next(Nd);
+
       for(int i=1; i <= params.n_smear; i++) {
 	
-	Stouting::smear_links(smeared_links[i-1], smeared_links[i], params.smear_in_this_dirP, params.rho);
-	if( fbc->nontrivialP() ) {
-	  fbc->modify( smeared_links[i] );    
+	smearUp(current, next);
+	if( isCheckpoint(i) ) {
+	  smeared_links[i] = next;
 	}
+	current = next;
 	
       }
 
       // ANTIPERIODIC BCs only -- modify only top level smeared thing
       fat_links_with_bc.resize(Nd);
-      fat_links_with_bc = smeared_links[params.n_smear];
+      fat_links_with_bc = current;
       fbc->modify(fat_links_with_bc);
       
       
@@ -184,7 +246,8 @@ namespace Chroma
     Handle< FermBC<T,P,Q> >  fbc;
     
     // smeared_links[0] are the thin links smeared_links[params.n_smear] 
-    // are the smeared links.
+    // are the smeared links. Only levels that are multiples of 
+    // params.checkpoint_interval are allocated.
     multi1d< Q > smeared_links;
     Q fat_links_with_bc;
     
@@ -2,6 +2,7 @@
 #define BICGSTAB_KERNELS_SCALARSITE_H
 #include "chromabase.h"
 #include "chroma_config.h"
+#include "util/thread/tuned_dispatch.h"
 
 /* The funky kernels used by BiCGStab.
    These versions should always work... */
@@ -97,7 +98,7 @@ namespace Chroma {
 	ord_yxpaymabz_arg arg={x_ptr,y_ptr,z_ptr,a_re,a_im, b_re, b_im,4*3*2};
 
 	int len = (s.end()-s.start()+1);
-	dispatch_to_threads(len,arg,ord_yxpaymabz_kernel);
+	tunedDispatchToThreads("bicgstab_yxpaymabz_f",len,arg,ord_yxpaymabz_kernel);
       }
       else {
 	QDPIO::cerr << "I only work for ordered subsets for now" << endl;
@@ -192,7 +193,7 @@ namespace Chroma {
 	ord_xpaypbz_arg arg={x_ptr,y_ptr,z_ptr,a_re,a_im,b_re,b_im,4*3*2};
 
 	int len=(s.end()-s.start()+1);
-	dispatch_to_threads(len,arg, ord_xpaypbz_kernel);
+	tunedDispatchToThreads("bicgstab_xpaypbz_f",len,arg, ord_xpaypbz_kernel);
       }
       else {
 	QDPIO::cerr << "I only work for ordered subsets for now" << endl;
@@ -295,7 +296,7 @@ namespace Chroma {
 	ord_cxmayf_arg arg={x_ptr,y_ptr,a_re,a_im,4*3*2};
 
 	int len=(s.end()-s.start()+1);
-	dispatch_to_threads(len,arg, ord_cxmayf_kernel);
+	tunedDispatchToThreads("bicgstab_cxmay_f",len,arg, ord_cxmayf_kernel);
       }
       else {
 	QDPIO::cerr << "I only work for ordered subsets for now" << endl;
@@ -381,7 +382,7 @@ namespace Chroma {
 					beta_re, beta_im, delta_re, delta_im,4*3*2};
 
 	  int len=(sub.end()-sub.start()+1);
-	  dispatch_to_threads(len,arg, ord_ib_zvupdates_kernel_real32);
+	  tunedDispatchToThreads("ibicgstab_zvupdates_f",len,arg, ord_ib_zvupdates_kernel_real32);
       }
       else {
 	QDPIO::cerr << "I only work for ordered subsets for now" << endl;
@@ -436,7 +437,7 @@ namespace Chroma {
 					beta_re, beta_im, delta_re, delta_im,4*3*2};
 
 	  int len=(sub.end()-sub.start()+1);
-	  dispatch_to_threads(len,arg, ord_ib_zvupdates_kernel_real64);
+	  tunedDispatchToThreads("ibicgstab_zvupdates_d",len,arg, ord_ib_zvupdates_kernel_real64);
 	}
 	else {
 	  QDPIO::cerr << "I only work for ordered subsets for now" << endl;
@@ -487,7 +488,7 @@ namespace Chroma {
 					omega_re, omega_im,4*3*2};
 
 	  int len=(sub.end()-sub.start()+1);
-	  dispatch_to_threads(len,arg, ord_ib_rxupdate_kernel_real32);
+	  tunedDispatchToThreads("ibicgstab_rxupdate_f",len,arg, ord_ib_rxupdate_kernel_real32);
 	}
 	else {
 	  QDPIO::cerr << "I only work for ordered subsets for now" << endl;
@@ -522,7 +523,7 @@ namespace Chroma {
 					omega_re, omega_im, 4*3*2};
 
 	  int len=(sub.end()-sub.start()+1);
-	  dispatch_to_threads(len,arg, ord_ib_rxupdate_kernel_real64);
+	  tunedDispatchToThreads("ibicgstab_rxupdate_d",len,arg, ord_ib_rxupdate_kernel_real64);
 	}
 	else {
 	  QDPIO::cerr << "I only work for ordered subsets for now" << endl;
@@ -0,0 +1,188 @@
+/*! \file
+ *  \brief Flexible GMRES with a variable right preconditioner
+ */
+
+#include "chromabase.h"
+#include "actions/ferm/invert/invfgmres.h"
+
+namespace Chroma
+{
+
+  //! Flexible GMRES(m) for a generic Linear Operator
+  /*! \ingroup invert
+   *
+   * See invfgmres.h for the algorithm.
+   */
+  template<typename T>
+  SystemSolverResults_t
+  InvFGMRES_a(const LinearOperator<T>& A,
+	      const LinearOperator<T>& Prec,
+	      const T& chi,
+	      T& psi,
+	      int NKrylov,
+	      const Real& RsdTarget,
+	      int MaxIter,
+	      bool verbose)
+  {
+    START_CODE();
+
+    const Subset& s = A.subset();
+
+    SystemSolverResults_t res;
+
+    if (NKrylov < 1)
+    {
+      QDPIO::cerr << "InvFGMRES: invalid NKrylov = " << NKrylov << endl;
+      QDP_abort(1);
+    }
+
+    FlopCounter flopcount;
+    flopcount.reset();
+    StopWatch swatch;
+    swatch.reset();
+    swatch.start();
+
+    multi1d<T> V(NKrylov+1);
+    multi1d<T> Z(NKrylov);
+    multi2d<DComplex> H(NKrylov, NKrylov+1);   // H[j][i] is column j, row i
+    multi1d<DComplex> g(NKrylov+1);
+    multi1d<DComplex> sn(NKrylov);
+    multi1d<Double>   cs(NKrylov);
+    multi1d<DComplex> y(NKrylov);
+
+    T w;
+    T r;
+
+    Double chi_norm = sqrt(norm2(chi, s));
+    Double target = Double(RsdTarget) * chi_norm;
+
+    // r = chi - A psi
+    A(w, psi, PLUS);
+    r[s] = chi - w;
+    Double beta = sqrt(norm2(r, s));
+    flopcount.addFlops(A.nFlops());
+    flopcount.addSiteFlops(6*Nc*Ns, s);
+
+    if (verbose)
+      QDPIO::cout << "InvFGMRES: starting, |r|/|chi| = " << beta/chi_norm << endl;
+
+    int iter = 0;
+    while (toBool(beta > target) && iter < MaxIter)
+    {
+      V[0][s] = r * Real(Double(1) / beta);
+      for(int i=0; i < g.size(); ++i)
+	g[i] = zero;
+      g[0] = cmplx(beta, Double(0));
+
+      int j = 0;
+      for(; j < NKrylov && iter < MaxIter; ++j)
+      {
+	++iter;
+
+	// Flexible step: keep the preconditioned direction
+	Prec(Z[j], V[j], PLUS);
+	A(w, Z[j], PLUS);
+	flopcount.addFlops(Prec.nFlops() + A.nFlops());
+
+	// Modified Gram-Schmidt
+	for(int i=0; i <= j; ++i)
+	{
+	  H[j][i] = innerProduct(V[i], w, s);
+	  w[s] -= V[i] * H[j][i];
+	}
+	Double hnorm = sqrt(norm2(w, s));
+	H[j][j+1] = cmplx(hnorm, Double(0));
+	flopcount.addSiteFlops(8*Nc*Ns*(j+1) + 4*Nc*Ns, s);
+
+	if (toBool(hnorm > Double(0)))
+	  V[j+1][s] = w * Real(Double(1) / hnorm);
+
+	// Apply the earlier rotations to the new column
+	for(int i=0; i < j; ++i)
+	{
+	  DComplex t = cs[i]*H[j][i] + sn[i]*H[j][i+1];
+	  H[j][i+1] = cs[i]*H[j][i+1] - conj(sn[i])*H[j][i];
+	  H[j][i]   = t;
+	}
+
+	// New rotation zeroing H[j][j+1]
+	Double a_abs = sqrt(localNorm2(H[j][j]));
+	Double denom = sqrt(a_abs*a_abs + hnorm*hnorm);
+	if (toBool(a_abs == Double(0)))
+	{
+	  cs[j] = Double(0);
+	  sn[j] = cmplx(Double(1), Double(0));
+	}
+	else
+	{
+	  cs[j] = a_abs / denom;
+	  sn[j] = (H[j][j] / a_abs) * (hnorm / denom);
+	}
+
+	H[j][j]   = cs[j]*H[j][j] + sn[j]*H[j][j+1];
+	H[j][j+1] = zero;
+	g[j+1] = -conj(sn[j]) * g[j];
+	g[j]   = cs[j] * g[j];
+
+	Double rnorm = sqrt(localNorm2(g[j+1]));
+	if (verbose)
+	  QDPIO::cout << "InvFGMRES: iter " << iter << "  |r|/|chi| = " << rnorm/chi_norm << endl;
+
+	if (toBool(rnorm <= target) || toBool(hnorm == Double(0)))
+	{
+	  ++j;
+	  break;
+	}
+      }
+
+      // Back substitution for the upper triangular system
+      for(int i=j-1; i >= 0; --i)
+      {
+	y[i] = g[i];
+	for(int k=i+1; k < j; ++k)
+	  y[i] -= H[k][i] * y[k];
+	y[i] = y[i] / H[i][i];
+      }
+
+      for(int i=0; i < j; ++i)
+	psi[s] += Z[i] * y[i];
+      flopcount.addSiteFlops(8*Nc*Ns*j, s);
+
+      // True residual for the restart
+      A(w, psi, PLUS);
+      r[s] = chi - w;
+      beta = sqrt(norm2(r, s));
+      flopcount.addFlops(A.nFlops());
+      flopcount.addSiteFlops(6*Nc*Ns, s);
+    }
+
+    res.n_count = iter;
+    res.resid   = beta;
+
+    swatch.stop();
+    QDPIO::cout << "InvFGMRES: iters = " << iter << "  |r|/|chi| = " << beta/chi_norm << endl;
+    flopcount.report("invfgmres", swatch.getTimeInSeconds());
+
+    if (toBool(beta > target))
+      QDPIO::cerr << "Nonconvergence Warning" << endl;
+
+    END_CODE();
+    return res;
+  }
+
+
+  template<>
+  SystemSolverResults_t
+  InvFGMRES(const LinearOperator<LatticeFermion>& A,
+	    const LinearOperator<LatticeFermion>& Prec,
+	    const LatticeFermion& chi,
+	    LatticeFermion& psi,
+	    int NKrylov,
+	    const Real& RsdTarget,
+	    int MaxIter,
+	    bool verbose)
+  {
+    return InvFGMRES_a(A, Prec, chi, psi, NKrylov, RsdTarget, MaxIter, verbose);
+  }
+
+}  // end namespace Chroma
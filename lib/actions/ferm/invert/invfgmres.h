@@ -0,0 +1,72 @@
+// -*- C++ -*-
+/*! \file
+ *  \brief Flexible GMRES with a variable right preconditioner
+ */
+
+#ifndef __invfgmres_h__
+#define __invfgmres_h__
+
+#include "linearop.h"
+#include "syssolver.h"
+
+namespace Chroma
+{
+
+  //! Flexible GMRES(m) for a generic Linear Operator
+  /*! \ingroup invert
+   * This subroutine uses restarted flexible GMRES to determine the
+   * solution of the set of linear equations
+   *
+   *   	    Chi  =  A . Psi
+   *
+   * preconditioned from the right by Prec. The preconditioner may change
+   * from one application to the next, e.g. an inner solve to a loose
+   * tolerance, so the preconditioned directions Z are kept along with the
+   * Krylov basis V.
+   *
+   * Algorithm:
+   *
+   *  r    :=  Chi - A . Psi ;  beta := |r| ;   Initial residual
+   *  REPEAT                                    Restart cycles
+   *      V[0]  :=  r / beta ;  g := beta e_0 ;
+   *      FOR j FROM 0 TO NKrylov-1 DO
+   *          Z[j]  :=  Prec . V[j] ;
+   *          w     :=  A . Z[j] ;
+   *          H[i,j] := <V[i],w> ;  w -= H[i,j] V[i] ;  for i <= j
+   *          H[j+1,j] := |w| ;  V[j+1] := w / H[j+1,j] ;
+   *          Givens rotate H[.,j] and g ;
+   *          IF |g[j+1]| <= RsdTarget |Chi| THEN exit loop ;
+   *      Psi  +=  Z . H^{-1} g ;
+   *      r    :=  Chi - A . Psi ;  beta := |r| ;
+   *  UNTIL beta <= RsdTarget |Chi|  or  MaxIter iterations
+   *
+   * Arguments:
+   *
+   *  \param A          Linear Operator             (Read)
+   *  \param Prec       Right preconditioner        (Read)
+   *  \param chi        Source                      (Read)
+   *  \param psi        Solution                    (Modify)
+   *  \param NKrylov    Restart length              (Read)
+   *  \param RsdTarget  Residual accuracy           (Read)
+   *  \param MaxIter    Maximum iterations          (Read)
+   *  \param verbose    Print every iteration, not just the summary (Read)
+   *
+   * @{
+   */
+
+  template<typename T>
+  SystemSolverResults_t
+  InvFGMRES(const LinearOperator<T>& A,
+	    const LinearOperator<T>& Prec,
+	    const T& chi,
+	    T& psi,
+	    int NKrylov,
+	    const Real& RsdTarget,
+	    int MaxIter,
+	    bool verbose = true);
+
+  /*! @} */  // end of group invert
+
+}  // end namespace Chroma
+
+#endif
@@ -0,0 +1,878 @@
+/*! \file
+ *  \brief Aggregation, transfer and coarse operator of the Wilson multigrid
+ */
+
+#include "actions/ferm/invert/mg_coarse_w.h"
+
+#include <algorithm>
+#include <utility>
+
+namespace Chroma
+{
+
+  namespace
+  {
+    typedef LatticeFermion::Subtype_t  FermSite_t;
+
+    //! <a,b> of two fermion sites
+    inline MGComplex siteInner(const FermSite_t& a, const FermSite_t& b)
+    {
+      double re = 0;
+      double im = 0;
+
+      for(int s=0; s < Ns; ++s)
+	for(int c=0; c < Nc; ++c)
+	{
+	  double ar = a.elem(s).elem(c).real();
+	  double ai = a.elem(s).elem(c).imag();
+	  double br = b.elem(s).elem(c).real();
+	  double bi = b.elem(s).elem(c).imag();
+
+	  re += ar*br + ai*bi;
+	  im += ar*bi - ai*br;
+	}
+
+      return MGComplex(re, im);
+    }
+
+    //! y += a x on a fermion site
+    inline void siteAxpy(FermSite_t& y, const MGComplex& a, const FermSite_t& x)
+    {
+      for(int s=0; s < Ns; ++s)
+	for(int c=0; c < Nc; ++c)
+	{
+	  double xr = x.elem(s).elem(c).real();
+	  double xi = x.elem(s).elem(c).imag();
+
+	  y.elem(s).elem(c).real() += a.real()*xr - a.imag()*xi;
+	  y.elem(s).elem(c).imag() += a.real()*xi + a.imag()*xr;
+	}
+    }
+
+    //! x *= a on a fermion site
+    inline void siteScale(FermSite_t& x, double a)
+    {
+      for(int s=0; s < Ns; ++s)
+	for(int c=0; c < Nc; ++c)
+	{
+	  x.elem(s).elem(c).real() *= a;
+	  x.elem(s).elem(c).imag() *= a;
+	}
+    }
+
+    //! Lexicographic index, x fastest
+    int lexIndex(const multi1d<int>& coord, const multi1d<int>& size)
+    {
+      int k = 0;
+      for(int mu=Nd-1; mu >= 0; --mu)
+	k = k*size[mu] + coord[mu];
+
+      return k;
+    }
+
+    //! Single partner node of a hop
+    void checkPartner(int& partner, int node, int h)
+    {
+      if (partner >= 0 && partner != node)
+      {
+	QDPIO::cerr << "MGCoarseOp: hop " << h
+		    << " has more than one partner node" << endl;
+	QDP_abort(1);
+      }
+      partner = node;
+    }
+
+
+    struct OrthoArgs
+    {
+      multi1d<LatticeFermion>&               vecs;
+      const std::vector< multi1d<int> >&     block_sites;
+      int                                    nv;
+    };
+
+    //! Gram-Schmidt of each chirality within each block
+    void orthoBlockLoop(int lo, int hi, int myId, OrthoArgs* a)
+    {
+      for(int b=lo; b < hi; ++b)
+      {
+	const multi1d<int>& sites = a->block_sites[b];
+
+	for(int s=0; s < 2; ++s)
+	  for(int i=0; i < a->nv; ++i)
+	  {
+	    int j = s*a->nv + i;
+
+	    for(int k=s*a->nv; k < j; ++k)
+	    {
+	      MGComplex p = 0;
+	      for(int n=0; n < sites.size(); ++n)
+		p += siteInner(a->vecs[k].elem(sites[n]), a->vecs[j].elem(sites[n]));
+
+	      for(int n=0; n < sites.size(); ++n)
+		siteAxpy(a->vecs[j].elem(sites[n]), -p, a->vecs[k].elem(sites[n]));
+	    }
+
+	    double nrm = 0;
+	    for(int n=0; n < sites.size(); ++n)
+	      nrm += siteInner(a->vecs[j].elem(sites[n]), a->vecs[j].elem(sites[n])).real();
+
+	    if (nrm <= 0)
+	    {
+	      QDPIO::cerr << "MGTransfer: null vector " << j << " vanishes on block " << b << endl;
+	      QDP_abort(1);
+	    }
+
+	    for(int n=0; n < sites.size(); ++n)
+	      siteScale(a->vecs[j].elem(sites[n]), 1.0/std::sqrt(nrm));
+	  }
+      }
+    }
+
+
+    struct RestrictArgs
+    {
+      MGCoarseVector&                        out;
+      const LatticeFermion&                  in;
+      const MGTransfer&                      P;
+    };
+
+    void restrictBlockLoop(int lo, int hi, int myId, RestrictArgs* a)
+    {
+      const int nc = a->P.numDof();
+
+      for(int b=lo; b < hi; ++b)
+      {
+	const multi1d<int>& sites = a->P.blockSites(b);
+
+	for(int j=0; j < nc; ++j)
+	{
+	  const LatticeFermion& v = a->P.basis(j);
+	  MGComplex sum = 0;
+
+	  for(int n=0; n < sites.size(); ++n)
+	    sum += siteInner(v.elem(sites[n]), a->in.elem(sites[n]));
+
+	  a->out[b*nc + j] = sum;
+	}
+      }
+    }
+
+
+    struct ProlongArgs
+    {
+      LatticeFermion&                        out;
+      const MGCoarseVector&                  in;
+      const MGTransfer&                      P;
+    };
+
+    void prolongBlockLoop(int lo, int hi, int myId, ProlongArgs* a)
+    {
+      const int nc = a->P.numDof();
+
+      for(int b=lo; b < hi; ++b)
+      {
+	const multi1d<int>& sites = a->P.blockSites(b);
+
+	for(int n=0; n < sites.size(); ++n)
+	{
+	  FermSite_t r;
+	  zero_rep(r);
+
+	  for(int j=0; j < nc; ++j)
+	    siteAxpy(r, a->in[b*nc + j], a->P.basis(j).elem(sites[n]));
+
+	  a->out.elem(sites[n]) = r;
+	}
+      }
+    }
+
+
+    struct ProbeArgs
+    {
+      const MGTransfer&                      P;
+      const LatticeFermion&                  r;      /*!< A on the probe of colour c */
+      const std::vector<int>&                color;
+      std::vector<MGComplex>&                diag;
+      std::vector<MGComplex>*                link;
+      int                                    c;
+      int                                    j;      /*!< probed dof */
+    };
+
+    //! Project a list of sites of the probe response onto the basis
+    inline void probeColumn(std::vector<MGComplex>& m, int b, const ProbeArgs* a,
+			    const multi1d<int>& sites)
+    {
+      const int nc = a->P.numDof();
+
+      for(int k=0; k < nc; ++k)
+      {
+	const LatticeFermion& v = a->P.basis(k);
+	MGComplex sum = 0;
+
+	for(int n=0; n < sites.size(); ++n)
+	  sum += siteInner(v.elem(sites[n]), a->r.elem(sites[n]));
+
+	m[(b*nc + k)*nc + a->j] = sum;
+      }
+    }
+
+    void probeBlockLoop(int lo, int hi, int myId, ProbeArgs* a)
+    {
+      for(int b=lo; b < hi; ++b)
+      {
+	int dc = a->color[b] ^ a->c;
+
+	if (dc == 0)
+	{
+	  probeColumn(a->diag, b, a, a->P.blockSites(b));
+	  continue;
+	}
+
+	// Neighbours along mu share the probe colour when one bit differs
+	for(int mu=0; mu < Nd; ++mu)
+	{
+	  if (dc == (1 << mu))
+	  {
+	    probeColumn(a->link[2*mu], b, a, a->P.faceSites(2*mu, b));
+	    probeColumn(a->link[2*mu+1], b, a, a->P.faceSites(2*mu+1, b));
+	  }
+	}
+      }
+    }
+
+
+    struct ApplyArgs
+    {
+      MGComplex*                             out;
+      const MGComplex*                       in;
+      const MGComplex*                       diag;
+      const MGComplex*                       link[2*Nd];
+      const int*                             nbr[2*Nd];
+      const MGComplex*                       recv[2*Nd];
+      int                                    nc;
+    };
+
+    //! out = D in + sum_h L_h in(neighbour)
+    void applySiteLoop(int lo, int hi, int myId, ApplyArgs* a)
+    {
+      const int nc = a->nc;
+      const int nc2 = nc*nc;
+
+      for(int b=lo; b < hi; ++b)
+      {
+	MGComplex* o = a->out + b*nc;
+	const MGComplex* m = a->diag + b*nc2;
+	const MGComplex* x = a->in + b*nc;
+
+	for(int k=0; k < nc; ++k)
+	{
+	  MGComplex sum = 0;
+	  for(int j=0; j < nc; ++j)
+	    sum += m[k*nc + j] * x[j];
+	  o[k] = sum;
+	}
+
+	for(int h=0; h < 2*Nd; ++h)
+	{
+	  int y = a->nbr[h][b];
+	  m = a->link[h] + b*nc2;
+	  x = (y >= 0) ? (a->in + y*nc) : (a->recv[h] + (-1-y)*nc);
+
+	  for(int k=0; k < nc; ++k)
+	  {
+	    MGComplex sum = 0;
+	    for(int j=0; j < nc; ++j)
+	      sum += m[k*nc + j] * x[j];
+	    o[k] += sum;
+	  }
+	}
+      }
+    }
+  }
+
+
+  //-------------------------------------------------------------------------------
+  // Relax random vectors towards the near null space of A
+  void mgNullVectors(multi1d<LatticeFermion>& v,
+		     const LinearOperator<LatticeFermion>& A,
+		     int num_vecs, int num_iter)
+  {
+    START_CODE();
+
+    const Subset& s = A.subset();
+
+    v.resize(num_vecs);
+
+    LatticeFermion r;
+    LatticeFermion Ar;
+
+    for(int i=0; i < num_vecs; ++i)
+    {
+      gaussian(v[i]);
+
+      // MR on A v = 0
+      A(Ar, v[i], PLUS);
+      r[s] = -Ar;
+
+      for(int k=0; k < num_iter; ++k)
+      {
+	A(Ar, r, PLUS);
+	DComplex c = innerProduct(Ar, r, s);
+	Double d = norm2(Ar, s);
+	Complex a = c / d;
+
+	v[i][s] += r * a;
+	r[s] -= Ar * a;
+      }
+
+      Double vn = sqrt(norm2(v[i], s));
+      QDPIO::cout << "mgNullVectors: vector " << i << "  |A v|/|v| = "
+		  << sqrt(norm2(r, s))/vn << endl;
+
+      v[i][s] *= Real(Double(1) / vn);
+    }
+
+    END_CODE();
+  }
+
+
+  //-------------------------------------------------------------------------------
+  // Build the blocks and the block orthonormal basis
+  void MGTransfer::create(const multi1d<int>& blocking, const multi1d<LatticeFermion>& null_vecs)
+  {
+    START_CODE();
+
+    const int me = Layout::nodeNumber();
+    const int nodeSites = Layout::sitesOnNode();
+    const multi1d<int>& sub_size = Layout::subgridLattSize();
+    const multi1d<int>& latt_size = Layout::lattSize();
+
+    if (blocking.size() != Nd)
+    {
+      QDPIO::cerr << "MGTransfer: blocking needs " << Nd << " extents" << endl;
+      QDP_abort(1);
+    }
+
+    block = blocking;
+    coarse_size.resize(Nd);
+    local_size.resize(Nd);
+
+    for(int mu=0; mu < Nd; ++mu)
+    {
+      if (block[mu] < 2 || sub_size[mu] % block[mu] != 0 || (latt_size[mu] / block[mu]) % 2 != 0)
+      {
+	QDPIO::cerr << "MGTransfer: block extent " << block[mu] << " in direction " << mu
+		    << " must be at least 2, divide the node extent " << sub_size[mu]
+		    << " and give an even number of blocks" << endl;
+	QDP_abort(1);
+      }
+
+      coarse_size[mu] = latt_size[mu] / block[mu];
+      local_size[mu] = sub_size[mu] / block[mu];
+    }
+
+    int nsites = 1;
+    for(int mu=0; mu < Nd; ++mu)
+      nsites *= local_size[mu];
+
+    // Sites and faces of each block
+    std::vector< std::vector<int> > sites(nsites);
+    std::vector< std::vector<int> > faces[2*Nd];
+    for(int h=0; h < 2*Nd; ++h)
+      faces[h].resize(nsites);
+
+    for(int site=0; site < nodeSites; ++site)
+    {
+      multi1d<int> coord = Layout::siteCoords(me, site);
+      multi1d<int> lb(Nd);
+      for(int mu=0; mu < Nd; ++mu)
+	lb[mu] = (coord[mu] / block[mu]) % local_size[mu];
+
+      int b = lexIndex(lb, local_size);
+      sites[b].push_back(site);
+
+      for(int mu=0; mu < Nd; ++mu)
+      {
+	int r = coord[mu] % block[mu];
+	if (r == block[mu]-1)
+	  faces[2*mu][b].push_back(site);
+	if (r == 0)
+	  faces[2*mu+1][b].push_back(site);
+      }
+    }
+
+    block_sites.resize(nsites);
+    for(int h=0; h < 2*Nd; ++h)
+      face_sites[h].resize(nsites);
+
+    for(int b=0; b < nsites; ++b)
+    {
+      block_sites[b].resize(sites[b].size());
+      for(int n=0; n < sites[b].size(); ++n)
+	block_sites[b][n] = sites[b][n];
+
+      for(int h=0; h < 2*Nd; ++h)
+      {
+	face_sites[h][b].resize(faces[h][b].size());
+	for(int n=0; n < faces[h][b].size(); ++n)
+	  face_sites[h][b][n] = faces[h][b][n];
+      }
+    }
+
+    // Chiral halves of the null vectors
+    const int nv = null_vecs.size();
+    nc = 2*nv;
+    vecs.resize(nc);
+
+    for(int i=0; i < nv; ++i)
+    {
+      LatticeFermion g5v = Gamma(Ns*Ns-1) * null_vecs[i];
+      vecs[i]    = Real(0.5) * (null_vecs[i] + g5v);
+      vecs[nv+i] = Real(0.5) * (null_vecs[i] - g5v);
+    }
+
+    OrthoArgs a = {vecs, block_sites, nv};
+    dispatch_to_threads(nsites, a, orthoBlockLoop);
+
+    QDPIO::cout << "MGTransfer: coarse lattice " << coarse_size[0];
+    for(int mu=1; mu < Nd; ++mu)
+      QDPIO::cout << "x" << coarse_size[mu];
+    QDPIO::cout << " with " << nc << " dofs per site" << endl;
+
+    END_CODE();
+  }
+
+
+  // Global coordinates of a coarse site of this node
+  multi1d<int> MGTransfer::coarseCoords(int b) const
+  {
+    multi1d<int> coord = Layout::siteCoords(Layout::nodeNumber(), block_sites[b][0]);
+    for(int mu=0; mu < Nd; ++mu)
+      coord[mu] /= block[mu];
+
+    return coord;
+  }
+
+
+  // Node of a coarse site given its global coordinates
+  int MGTransfer::coarseNode(const multi1d<int>& cc) const
+  {
+    multi1d<int> coord(Nd);
+    for(int mu=0; mu < Nd; ++mu)
+      coord[mu] = cc[mu] * block[mu];
+
+    return Layout::nodeNumber(coord);
+  }
+
+
+  // Index on its node of a coarse site given its global coordinates
+  int MGTransfer::coarseLocalIndex(const multi1d<int>& cc) const
+  {
+    multi1d<int> lb(Nd);
+    for(int mu=0; mu < Nd; ++mu)
+      lb[mu] = cc[mu] % local_size[mu];
+
+    return lexIndex(lb, local_size);
+  }
+
+
+  // Coarse projection of a fine field
+  void MGTransfer::restrictTo(MGCoarseVector& out, const LatticeFermion& in) const
+  {
+    out.resize(numCoarseSites()*nc);
+
+    RestrictArgs a = {out, in, *this};
+    dispatch_to_threads(numCoarseSites(), a, restrictBlockLoop);
+  }
+
+
+  // Fine field of a coarse vector
+  void MGTransfer::prolongate(LatticeFermion& out, const MGCoarseVector& in) const
+  {
+    ProlongArgs a = {out, in, *this};
+    dispatch_to_threads(numCoarseSites(), a, prolongBlockLoop);
+  }
+
+
+  //-------------------------------------------------------------------------------
+  // Probe the stencil of A on the aggregates of P
+  void MGCoarseOp::create(const LinearOperator<LatticeFermion>& A, const MGTransfer& P)
+  {
+    START_CODE();
+
+    free();
+
+    const int me = Layout::nodeNumber();
+    const multi1d<int>& coarse_size = P.coarseLattSize();
+
+    nc = P.numDof();
+    nsites = P.numCoarseSites();
+
+    diag.assign(nsites*nc*nc, MGComplex(0));
+    for(int h=0; h < 2*Nd; ++h)
+      link[h].assign(nsites*nc*nc, MGComplex(0));
+
+    // Neighbours, receive slots ranked by the sending site
+    int send_node[2*Nd];
+    int recv_node[2*Nd];
+    std::vector< std::pair<int,int> > recv[2*Nd];
+    std::vector< std::pair<int,int> > send[2*Nd];
+
+    for(int h=0; h < 2*Nd; ++h)
+    {
+      send_node[h] = -1;
+      recv_node[h] = -1;
+      nbr[h].resize(nsites);
+    }
+
+    std::vector<int> color(nsites);
+
+    for(int b=0; b < nsites; ++b)
+    {
+      multi1d<int> cc = P.coarseCoords(b);
+      int lex = lexIndex(cc, coarse_size);
+
+      color[b] = 0;
+      for(int mu=0; mu < Nd; ++mu)
+	color[b] |= (cc[mu] % 2) << mu;
+
+      for(int mu=0; mu < Nd; ++mu)
+	for(int back=0; back < 2; ++back)
+	{
+	  int h = 2*mu + back;
+	  int dir = back ? -1 : 1;
+
+	  // Neighbour across the hop
+	  multi1d<int> yc = cc;
+	  yc[mu] = (cc[mu] + dir + coarse_size[mu]) % coarse_size[mu];
+	  int node = P.coarseNode(yc);
+
+	  if (node == me)
+	    nbr[h][b] = P.coarseLocalIndex(yc);
+	  else
+	  {
+	    checkPartner(recv_node[h], node, h);
+	    recv[h].push_back(std::make_pair(lexIndex(yc, coarse_size), b));
+	  }
+
+	  // Receiver of b across the hop
+	  multi1d<int> xc = cc;
+	  xc[mu] = (cc[mu] - dir + coarse_size[mu]) % coarse_size[mu];
+	  node = P.coarseNode(xc);
+
+	  if (node != me)
+	  {
+	    checkPartner(send_node[h], node, h);
+	    send[h].push_back(std::make_pair(lex, b));
+	  }
+	}
+    }
+
+    for(int h=0; h < 2*Nd; ++h)
+    {
+      if (send[h].size() != recv[h].size())
+      {
+	QDPIO::cerr << "MGCoarseOp: hop " << h << " sends " << send[h].size()
+		    << " sites but receives " << recv[h].size() << endl;
+	QDP_abort(1);
+      }
+
+      std::sort(recv[h].begin(), recv[h].end());
+      for(int k=0; k < recv[h].size(); ++k)
+	nbr[h][recv[h][k].second] = -1 - k;
+
+      std::sort(send[h].begin(), send[h].end());
+      send_sites[h].resize(send[h].size());
+      for(int k=0; k < send[h].size(); ++k)
+	send_sites[h][k] = send[h][k].second;
+
+      send_buf[h].resize(std::max(size_t(1), send[h].size()*nc));
+      recv_buf[h].resize(std::max(size_t(1), recv[h].size()*nc));
+    }
+
+#if defined(ARCH_PARSCALAR)
+    for(int h=0; h < 2*Nd; ++h)
+    {
+      if (send_sites[h].empty())
+	continue;
+
+      const size_t nbytes = send_sites[h].size()*nc*sizeof(MGComplex);
+      QMP_msghandle_t mh_a[2];
+
+      msg[h][0] = QMP_declare_msgmem(&(recv_buf[h][0]), nbytes);
+      msg[h][1] = QMP_declare_msgmem(&(send_buf[h][0]), nbytes);
+      mh_a[0] = QMP_declare_receive_from(msg[h][0], recv_node[h], 0);
+      mh_a[1] = QMP_declare_send_to(msg[h][1], send_node[h], 0);
+      mh[h] = QMP_declare_multiple(mh_a, 2);
+
+      if (mh[h] == (QMP_msghandle_t)NULL)
+      {
+	QDPIO::cerr << "MGCoarseOp: failed to declare the messages of hop " << h << endl;
+	QDP_abort(1);
+      }
+    }
+#else
+    for(int h=0; h < 2*Nd; ++h)
+      if (! send_sites[h].empty())
+      {
+	QDPIO::cerr << "MGCoarseOp: off node neighbours without comms" << endl;
+	QDP_abort(1);
+      }
+#endif
+
+    // Probe the stencil, one colour of blocks and one dof at a time
+    StopWatch swatch;
+    swatch.reset();
+    swatch.start();
+
+    LatticeFermion src;
+    LatticeFermion r;
+
+    for(int c=0; c < (1 << Nd); ++c)
+      for(int j=0; j < nc; ++j)
+      {
+	src = zero;
+
+	const LatticeFermion& v = P.basis(j);
+	for(int b=0; b < nsites; ++b)
+	{
+	  if (color[b] != c)
+	    continue;
+
+	  const multi1d<int>& sites = P.blockSites(b);
+	  for(int n=0; n < sites.size(); ++n)
+	    src.elem(sites[n]) = v.elem(sites[n]);
+	}
+
+	A(r, src, PLUS);
+
+	ProbeArgs a = {P, r, color, diag, link, c, j};
+	dispatch_to_threads(nsites, a, probeBlockLoop);
+      }
+
+    swatch.stop();
+    QDPIO::cout << "MGCoarseOp: probed with " << (1 << Nd)*nc << " applications in "
+		<< swatch.getTimeInSeconds() << " secs" << endl;
+
+    END_CODE();
+  }
+
+
+  // out = A_c in
+  void MGCoarseOp::apply(MGCoarseVector& out, const MGCoarseVector& in) const
+  {
+    out.resize(size());
+
+    // Send the faces of all hops
+    for(int h=0; h < 2*Nd; ++h)
+    {
+      if (send_sites[h].empty())
+	continue;
+
+      for(int k=0; k < send_sites[h].size(); ++k)
+	std::copy(in.begin() + send_sites[h][k]*nc, in.begin() + (send_sites[h][k]+1)*nc,
+		  send_buf[h].begin() + k*nc);
+
+#if defined(ARCH_PARSCALAR)
+      QMP_status_t err;
+      if ((err = QMP_start(mh[h])) != QMP_SUCCESS)
+	QDP_error_exit(QMP_error_string(err));
+#endif
+    }
+
+#if defined(ARCH_PARSCALAR)
+    for(int h=0; h < 2*Nd; ++h)
+    {
+      QMP_status_t err;
+      if (! send_sites[h].empty())
+	if ((err = QMP_wait(mh[h])) != QMP_SUCCESS)
+	  QDP_error_exit(QMP_error_string(err));
+    }
+#endif
+
+    ApplyArgs a;
+    a.out  = &out[0];
+    a.in   = &in[0];
+    a.diag = &diag[0];
+    a.nc   = nc;
+    for(int h=0; h < 2*Nd; ++h)
+    {
+      a.link[h] = &link[h][0];
+      a.nbr[h]  = &nbr[h][0];
+      a.recv[h] = &recv_buf[h][0];
+    }
+
+    dispatch_to_threads(nsites, a, applySiteLoop);
+  }
+
+
+  // Release the messages
+  void MGCoarseOp::free()
+  {
+#if defined(ARCH_PARSCALAR)
+    for(int h=0; h < 2*Nd; ++h)
+      if (! send_sites[h].empty())
+      {
+	QMP_free_msghandle(mh[h]);
+	QMP_free_msgmem(msg[h][1]);
+	QMP_free_msgmem(msg[h][0]);
+      }
+#endif
+
+    for(int h=0; h < 2*Nd; ++h)
+      send_sites[h].clear();
+  }
+
+
+  MGCoarseOp::~MGCoarseOp()
+  {
+    free();
+  }
+
+
+  //-------------------------------------------------------------------------------
+  // Inner product of coarse vectors over all nodes
+  MGComplex mgInnerProduct(const MGCoarseVector& a, const MGCoarseVector& b)
+  {
+    MGComplex sum = 0;
+    for(int i=0; i < a.size(); ++i)
+      sum += std::conj(a[i]) * b[i];
+
+    double d[2] = {sum.real(), sum.imag()};
+    QDPInternal::globalSumArray(d, 2);
+
+    return MGComplex(d[0], d[1]);
+  }
+
+
+  // Norm squared of a coarse vector over all nodes
+  double mgNorm2(const MGCoarseVector& a)
+  {
+    double d = 0;
+    for(int i=0; i < a.size(); ++i)
+      d += std::norm(a[i]);
+
+    QDPInternal::globalSumArray(&d, 1);
+
+    return d;
+  }
+
+
+  // GMRES(m) on the coarse operator
+  int mgCoarseGMRES(const MGCoarseOp& A, const MGCoarseVector& b, MGCoarseVector& x,
+		    int NKrylov, double rsd, int MaxIter)
+  {
+    START_CODE();
+
+    const int n = A.size();
+    x.resize(n, MGComplex(0));
+
+    double bnorm = std::sqrt(mgNorm2(b));
+    if (bnorm == 0)
+    {
+      std::fill(x.begin(), x.end(), MGComplex(0));
+      END_CODE();
+      return 0;
+    }
+
+    const double target = rsd * bnorm;
+
+    std::vector<MGCoarseVector> V(NKrylov+1, MGCoarseVector(n));
+    std::vector<MGComplex> H((NKrylov+1)*NKrylov);   // H[j*(NKrylov+1) + i]
+    std::vector<MGComplex> g(NKrylov+1);
+    std::vector<MGComplex> sn(NKrylov);
+    std::vector<double>    cs(NKrylov);
+    std::vector<MGComplex> y(NKrylov);
+    MGCoarseVector w(n);
+    MGCoarseVector r(n);
+
+    A.apply(w, x);
+    for(int i=0; i < n; ++i)
+      r[i] = b[i] - w[i];
+    double beta = std::sqrt(mgNorm2(r));
+
+    int iter = 0;
+    while (beta > target && iter < MaxIter)
+    {
+      for(int i=0; i < n; ++i)
+	V[0][i] = r[i] / beta;
+      std::fill(g.begin(), g.end(), MGComplex(0));
+      g[0] = beta;
+
+      int j = 0;
+      for(; j < NKrylov && iter < MaxIter; ++j)
+      {
+	++iter;
+	MGComplex* hj = &H[j*(NKrylov+1)];
+
+	A.apply(w, V[j]);
+
+	for(int i=0; i <= j; ++i)
+	{
+	  hj[i] = mgInnerProduct(V[i], w);
+	  for(int l=0; l < n; ++l)
+	    w[l] -= hj[i] * V[i][l];
+	}
+	double hnorm = std::sqrt(mgNorm2(w));
+	hj[j+1] = hnorm;
+
+	if (hnorm > 0)
+	  for(int l=0; l < n; ++l)
+	    V[j+1][l] = w[l] / hnorm;
+
+	for(int i=0; i < j; ++i)
+	{
+	  MGComplex t = cs[i]*hj[i] + sn[i]*hj[i+1];
+	  hj[i+1] = cs[i]*hj[i+1] - std::conj(sn[i])*hj[i];
+	  hj[i]   = t;
+	}
+
+	double a_abs = std::abs(hj[j]);
+	double denom = std::sqrt(a_abs*a_abs + hnorm*hnorm);
+	if (a_abs == 0)
+	{
+	  cs[j] = 0;
+	  sn[j] = 1;
+	}
+	else
+	{
+	  cs[j] = a_abs / denom;
+	  sn[j] = (hj[j] / a_abs) * (hnorm / denom);
+	}
+
+	hj[j]   = cs[j]*hj[j] + sn[j]*hj[j+1];
+	hj[j+1] = 0;
+	g[j+1]  = -std::conj(sn[j]) * g[j];
+	g[j]    = cs[j] * g[j];
+
+	if (std::abs(g[j+1]) <= target || hnorm == 0)
+	{
+	  ++j;
+	  break;
+	}
+      }
+
+      for(int i=j-1; i >= 0; --i)
+      {
+	y[i] = g[i];
+	for(int k=i+1; k < j; ++k)
+	  y[i] -= H[k*(NKrylov+1) + i] * y[k];
+	y[i] /= H[i*(NKrylov+1) + i];
+      }
+
+      for(int i=0; i < j; ++i)
+	for(int l=0; l < n; ++l)
+	  x[l] += y[i] * V[i][l];
+
+      A.apply(w, x);
+      for(int i=0; i < n; ++i)
+	r[i] = b[i] - w[i];
+      beta = std::sqrt(mgNorm2(r));
+    }
+
+    END_CODE();
+
+    return iter;
+  }
+
+}  // end namespace Chroma
@@ -0,0 +1,173 @@
+// -*- C++ -*-
+/*! \file
+ *  \brief Aggregation, transfer and coarse operator of the Wilson multigrid
+ */
+
+#ifndef __mg_coarse_w_h__
+#define __mg_coarse_w_h__
+
+#include "chromabase.h"
+#include "linearop.h"
+
+#include <complex>
+#include <vector>
+
+#if defined(ARCH_PARSCALAR)
+#include <qmp.h>
+#endif
+
+namespace Chroma
+{
+
+  //! Complex word of the coarse level
+  typedef std::complex<double>  MGComplex;
+
+  //! Coarse vector: the dofs of each coarse site on this node in turn
+  typedef std::vector<MGComplex>  MGCoarseVector;
+
+
+  //! Relax random vectors towards the near null space of A
+  /*! \ingroup invert
+   *
+   * Each vector starts gaussian and takes num_iter MR steps on A v = 0.
+   */
+  void mgNullVectors(multi1d<LatticeFermion>& v,
+		     const LinearOperator<LatticeFermion>& A,
+		     int num_vecs, int num_iter);
+
+
+  //! Block aggregation with chiral splitting
+  /*! \ingroup invert
+   *
+   * The fine lattice is cut into blocks of the given extents, each inside
+   * one node, and each block holds one coarse site. The null vectors are
+   * split by chirality and orthonormalized block by block, so a coarse
+   * site carries 2*num_vecs dofs, those with gamma_5 = +1 first. Restriction
+   * and prolongation touch only node-local data.
+   */
+  class MGTransfer
+  {
+  public:
+    //! Empty transfer. Must use create later
+    MGTransfer() : nc(0) {}
+
+    //! Build the blocks and the block orthonormal basis
+    void create(const multi1d<int>& blocking, const multi1d<LatticeFermion>& null_vecs);
+
+    //! Dofs per coarse site
+    int numDof() const {return nc;}
+
+    //! Coarse sites on this node
+    int numCoarseSites() const {return block_sites.size();}
+
+    //! Block extents
+    const multi1d<int>& blocking() const {return block;}
+
+    //! Global extents of the coarse lattice
+    const multi1d<int>& coarseLattSize() const {return coarse_size;}
+
+    //! Global coordinates of a coarse site of this node
+    multi1d<int> coarseCoords(int b) const;
+
+    //! Node of a coarse site given its global coordinates
+    int coarseNode(const multi1d<int>& cc) const;
+
+    //! Index on its node of a coarse site given its global coordinates
+    int coarseLocalIndex(const multi1d<int>& cc) const;
+
+    //! Fine sites of a block
+    const multi1d<int>& blockSites(int b) const {return block_sites[b];}
+
+    //! Fine sites of a block whose neighbour across hop h is in another block
+    /*! Hop h = 2*mu is forward along mu and h = 2*mu+1 backward */
+    const multi1d<int>& faceSites(int h, int b) const {return face_sites[h][b];}
+
+    //! Block orthonormal basis vector j
+    const LatticeFermion& basis(int j) const {return vecs[j];}
+
+    //! Coarse projection of a fine field
+    void restrictTo(MGCoarseVector& out, const LatticeFermion& in) const;
+
+    //! Fine field of a coarse vector
+    void prolongate(LatticeFermion& out, const MGCoarseVector& in) const;
+
+  private:
+    int                                    nc;
+    multi1d<int>                           block;
+    multi1d<int>                           coarse_size;
+    multi1d<int>                           local_size;   /*!< coarse extents on a node */
+    multi1d<LatticeFermion>                vecs;
+    std::vector< multi1d<int> >            block_sites;
+    std::vector< multi1d<int> >            face_sites[2*Nd];
+  };
+
+
+  //! Galerkin coarse operator P^dag A P as a nearest neighbour stencil
+  /*! \ingroup invert
+   *
+   * The diagonal and the 2*Nd hopping matrices of each coarse site are
+   * probed from A with the blocks coloured by the parity of their
+   * coordinates, 2^Nd * numDof applications of A in all. This needs blocks
+   * at least 2 sites deep and an even number of blocks in each direction.
+   */
+  class MGCoarseOp
+  {
+  public:
+    //! Empty operator. Must use create later
+    MGCoarseOp() : nc(0), nsites(0) {}
+
+    //! Releases the messages
+    ~MGCoarseOp();
+
+    //! Probe the stencil of A on the aggregates of P
+    void create(const LinearOperator<LatticeFermion>& A, const MGTransfer& P);
+
+    //! out = A_c in
+    void apply(MGCoarseVector& out, const MGCoarseVector& in) const;
+
+    //! Length of a coarse vector on this node
+    int size() const {return nsites*nc;}
+
+  private:
+    //! Hide copies, the messages are owned
+    MGCoarseOp(const MGCoarseOp&) {}
+    void operator=(const MGCoarseOp&) {}
+
+    void free();
+
+    int                                    nc;
+    int                                    nsites;
+    std::vector<MGComplex>                 diag;         /*!< nc x nc per site */
+    std::vector<MGComplex>                 link[2*Nd];   /*!< nc x nc per site */
+    std::vector<int>                       nbr[2*Nd];    /*!< site or -1-slot */
+    std::vector<int>                       send_sites[2*Nd];
+    mutable std::vector<MGComplex>         send_buf[2*Nd];
+    mutable std::vector<MGComplex>         recv_buf[2*Nd];
+
+#if defined(ARCH_PARSCALAR)
+    QMP_msgmem_t                           msg[2*Nd][2];  /*!< receive and send memories */
+    QMP_msghandle_t                        mh[2*Nd];
+#endif
+  };
+
+
+  //! Inner product of coarse vectors over all nodes
+  /*! \ingroup invert */
+  MGComplex mgInnerProduct(const MGCoarseVector& a, const MGCoarseVector& b);
+
+  //! Norm squared of a coarse vector over all nodes
+  /*! \ingroup invert */
+  double mgNorm2(const MGCoarseVector& a);
+
+  //! GMRES(m) on the coarse operator
+  /*! \ingroup invert
+   *
+   * Solves A_c x = b from the initial guess x to a relative residual of
+   * rsd, returning the number of iterations.
+   */
+  int mgCoarseGMRES(const MGCoarseOp& A, const MGCoarseVector& b, MGCoarseVector& x,
+		    int NKrylov, double rsd, int MaxIter);
+
+}  // end namespace Chroma
+
+#endif
@@ -432,4 +432,34 @@ namespace Chroma
     MInvCG_a(M, chi, psi, shifts, RsdCG, MaxCG, n_count);
   }
 
+
+  /*! \ingroup invert */
+  template<>
+  void MInvCG(const LinearOperator<LatticeStaggeredFermion>& M,
+	      const LatticeStaggeredFermion& chi, 
+	      multi1d<LatticeStaggeredFermion>& psi, 
+	      const multi1d<Real>& shifts,
+	      const multi1d<Real>& RsdCG, 
+	      int MaxCG,
+	      int &n_count)
+  {
+    MInvCG_a(M, chi, psi, shifts, RsdCG, MaxCG, n_count);
+  }
+
+
+  /*! \ingroup invert */
+  template<>
+  void MInvCG(const DiffLinearOperator<LatticeStaggeredFermion,
+	                               multi1d<LatticeColorMatrix>,
+	                               multi1d<LatticeColorMatrix> >& M,
+	      const LatticeStaggeredFermion& chi, 
+	      multi1d<LatticeStaggeredFermion>& psi, 
+	      const multi1d<Real>& shifts,
+	      const multi1d<Real>& RsdCG, 
+	      int MaxCG,
+	      int &n_count)
+  {
+    MInvCG_a(M, chi, psi, shifts, RsdCG, MaxCG, n_count);
+  }
+
 }  // end namespace Chroma
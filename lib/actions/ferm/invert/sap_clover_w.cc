@@ -0,0 +1,350 @@
+/*! \file
+ *  \brief Schwarz alternating procedure preconditioner for the clover operator
+ */
+
+#include "chromabase.h"
+#include "actions/ferm/invert/sap_clover_w.h"
+#include "actions/ferm/fermstates/periodic_fermstate.h"
+#include "actions/ferm/linop/spin_proj_site_w.h"
+#include "io/aniso_io.h"
+
+namespace Chroma
+{
+
+  //! Site kernels of the block solves
+  namespace SAPCloverEnv
+  {
+    using SpinProjSiteEnv::projectSite;
+    using SpinProjSiteEnv::addReconstructSite;
+
+    //! Clover operator of a block with Dirichlet boundaries at one site
+    template<typename T, typename Q, typename C>
+    inline void blockOpSite(T& chi, const T& psi, const Q& u, const C& clov,
+			    const SAPBlocks& blocks, int x)
+    {
+      typedef typename WordType<T>::Type_t W;
+      typedef PSpinVector<PColorVector<RComplex<W>, Nc>, (Ns>>1)>  HalfSite_t;
+
+      clov.applySite(chi, psi, PLUS, x);
+
+      for(int mu=0; mu < Nd; ++mu)
+      {
+	HalfSite_t hh;
+	HalfSite_t uh;
+
+	// psi(x+mu) with (1 - gamma_mu)
+	int y = blocks.neighbour(2*mu, x);
+	if (y >= 0)
+	{
+	  projectSite(hh, psi.elem(y), mu, -1);
+	  uh = u[mu].elem(x) * hh;
+	  addReconstructSite(chi.elem(x), uh, mu, -1);
+	}
+
+	// psi(x-mu) with (1 + gamma_mu)
+	y = blocks.neighbour(2*mu+1, x);
+	if (y >= 0)
+	{
+	  projectSite(hh, psi.elem(y), mu, 1);
+	  uh = adj(u[mu].elem(y)) * hh;
+	  addReconstructSite(chi.elem(x), uh, mu, 1);
+	}
+      }
+    }
+
+    template<typename T, typename Q, typename C>
+    struct BlockArgs
+    {
+      T&                       e;
+      T&                       res;
+      T&                       Ares;
+      const T&                 r;
+      const Q&                 u;
+      const C&                 clov;
+      const SAPBlocks&         blocks;
+      const multi1d<int>&      list;    /*!< blocks to solve */
+      int                      niter;
+    };
+
+    //! MR steps on each block of the list, with block local reductions
+    template<typename T, typename Q, typename C>
+    void blockMRLoop(int lo, int hi, int myId, BlockArgs<T,Q,C>* a)
+    {
+      typedef typename WordType<T>::Type_t W;
+      const int n = Ns*Nc;
+
+      for(int k=lo; k < hi; ++k)
+      {
+	const multi1d<int>& sites = a->blocks.blockSites(a->list[k]);
+
+	for(int j=0; j < sites.size(); ++j)
+	{
+	  int x = sites[j];
+	  zero_rep(a->e.elem(x));
+	  a->res.elem(x) = a->r.elem(x);
+	}
+
+	for(int iter=0; iter < a->niter; ++iter)
+	{
+	  double c_re = 0;
+	  double c_im = 0;
+	  double d = 0;
+
+	  for(int j=0; j < sites.size(); ++j)
+	  {
+	    int x = sites[j];
+	    blockOpSite(a->Ares, a->res, a->u, a->clov, a->blocks, x);
+
+	    const RComplex<W>* ar = (const RComplex<W>*)&(a->Ares.elem(x).elem(0).elem(0));
+	    const RComplex<W>* rr = (const RComplex<W>*)&(a->res.elem(x).elem(0).elem(0));
+	    for(int i=0; i < n; ++i)
+	    {
+	      c_re += double(ar[i].real())*double(rr[i].real()) + double(ar[i].imag())*double(rr[i].imag());
+	      c_im += double(ar[i].real())*double(rr[i].imag()) - double(ar[i].imag())*double(rr[i].real());
+	      d    += double(ar[i].real())*double(ar[i].real()) + double(ar[i].imag())*double(ar[i].imag());
+	    }
+	  }
+
+	  if (d == 0)
+	    break;
+
+	  // e += alpha res ; res -= alpha A res
+	  const W a_re = c_re / d;
+	  const W a_im = c_im / d;
+
+	  for(int j=0; j < sites.size(); ++j)
+	  {
+	    int x = sites[j];
+	    RComplex<W>* ee = (RComplex<W>*)&(a->e.elem(x).elem(0).elem(0));
+	    RComplex<W>* rr = (RComplex<W>*)&(a->res.elem(x).elem(0).elem(0));
+	    const RComplex<W>* ar = (const RComplex<W>*)&(a->Ares.elem(x).elem(0).elem(0));
+
+	    for(int i=0; i < n; ++i)
+	    {
+	      ee[i].real() += a_re*rr[i].real() - a_im*rr[i].imag();
+	      ee[i].imag() += a_re*rr[i].imag() + a_im*rr[i].real();
+	      rr[i].real() -= a_re*ar[i].real() - a_im*ar[i].imag();
+	      rr[i].imag() -= a_re*ar[i].imag() + a_im*ar[i].real();
+	    }
+	  }
+	}
+      }
+    }
+  }
+
+
+  // Cut the lattice into blocks
+  void SAPBlocks::create(const multi1d<int>& blocking)
+  {
+    START_CODE();
+
+    const int me = Layout::nodeNumber();
+    const int nodeSites = Layout::sitesOnNode();
+    const multi1d<int>& latt_size = Layout::lattSize();
+    const multi1d<int>& sub_size = Layout::subgridLattSize();
+
+    if (blocking.size() != Nd)
+    {
+      QDPIO::cerr << "SAPBlocks: the blocking needs Nd = " << Nd << " extents" << endl;
+      QDP_abort(1);
+    }
+
+    multi1d<int> num(Nd);
+    int nblocks = 1;
+    for(int mu=0; mu < Nd; ++mu)
+    {
+      if (blocking[mu] < 1 || sub_size[mu] % blocking[mu] != 0)
+      {
+	QDPIO::cerr << "SAPBlocks: block extent " << blocking[mu]
+		    << " does not divide the node extent " << sub_size[mu]
+		    << " in direction " << mu << endl;
+	QDP_abort(1);
+      }
+
+      if ((latt_size[mu] / blocking[mu]) % 2 != 0)
+      {
+	QDPIO::cerr << "SAPBlocks: the blocks cannot be coloured, "
+		    << latt_size[mu] / blocking[mu]
+		    << " blocks in direction " << mu << endl;
+	QDP_abort(1);
+      }
+
+      num[mu] = sub_size[mu] / blocking[mu];
+      nblocks *= num[mu];
+    }
+
+    std::vector< std::vector<int> > sites(nblocks);
+    std::vector<int> colour(nblocks);
+
+    for(int h=0; h < 2*Nd; ++h)
+      nbr[h].resize(nodeSites);
+
+    for(int x=0; x < nodeSites; ++x)
+    {
+      multi1d<int> coord = Layout::siteCoords(me, x);
+      multi1d<int> lb(Nd);
+      int gsum = 0;
+
+      for(int mu=0; mu < Nd; ++mu)
+      {
+	lb[mu] = (coord[mu] % sub_size[mu]) / blocking[mu];
+	gsum += coord[mu] / blocking[mu];
+      }
+
+      int b = local_site(lb, num);
+      sites[b].push_back(x);
+      colour[b] = gsum % 2;
+
+      for(int mu=0; mu < Nd; ++mu)
+	for(int back=0; back < 2; ++back)
+	{
+	  multi1d<int> yc = coord;
+	  yc[mu] = (coord[mu] + (back ? latt_size[mu]-1 : 1)) % latt_size[mu];
+
+	  if (yc[mu] / blocking[mu] == coord[mu] / blocking[mu])
+	    nbr[2*mu+back][x] = Layout::linearSiteIndex(yc);
+	  else
+	    nbr[2*mu+back][x] = -1;
+	}
+    }
+
+    block_sites.resize(nblocks);
+    std::vector<int> by_colour[2];
+
+    for(int b=0; b < nblocks; ++b)
+    {
+      block_sites[b].resize(sites[b].size());
+      for(int j=0; j < sites[b].size(); ++j)
+	block_sites[b][j] = sites[b][j];
+
+      by_colour[colour[b]].push_back(b);
+    }
+
+    for(int c=0; c < 2; ++c)
+    {
+      colour_blocks[c].resize(by_colour[c].size());
+      for(int j=0; j < by_colour[c].size(); ++j)
+	colour_blocks[c][j] = by_colour[c][j];
+    }
+
+    END_CODE();
+  }
+
+
+  // Constructor: blocks, hopping links and the clover term of the block solves
+  SAPCloverPrec::SAPCloverPrec(Handle< LinearOperator<T> > A_,
+			       Handle< FermState<T,Q,Q> > state_,
+			       const SysSolverSAPCloverParams& invParam_) :
+    A(A_), invParam(invParam_)
+  {
+    START_CODE();
+
+    if (A->subset().numSiteTable() != Layout::sitesOnNode())
+    {
+      QDPIO::cerr << "SAPCloverPrec: SAP needs the unpreconditioned operator on all sites" << endl;
+      QDP_abort(1);
+    }
+
+    blocks.create(invParam.Blocking);
+
+    // The links of the state carry the boundary conditions
+    const Q& links = state_->getLinks();
+    multi1d<Real> coeffs = makeFermCoeffs(invParam.clovParams.anisoParam);
+
+    if (invParam.singlePrecBlocks)
+    {
+      QF links_single(Nd);
+      u_f.resize(Nd);
+      for(int mu=0; mu < Nd; ++mu)
+      {
+	links_single[mu] = links[mu];
+	u_f[mu] = Real(-0.5) * coeffs[mu] * links[mu];
+      }
+
+      Handle< FermState<TF,QF,QF> > fstate_single(new PeriodicFermState<TF,QF,QF>(links_single));
+      clov_f = new CloverTermF;
+      clov_f->create(fstate_single, invParam.clovParams);
+    }
+    else
+    {
+      QD links_double(Nd);
+      u_d.resize(Nd);
+      for(int mu=0; mu < Nd; ++mu)
+      {
+	links_double[mu] = links[mu];
+	u_d[mu] = Real(-0.5) * coeffs[mu] * links[mu];
+      }
+
+      Handle< FermState<TD,QD,QD> > fstate_double(new PeriodicFermState<TD,QD,QD>(links_double));
+      clov_d = new CloverTermD;
+      clov_d->create(fstate_double, invParam.clovParams);
+    }
+
+    QDPIO::cout << "SAPCloverPrec: " << blocks.colourBlocks(0).size() << " + "
+		<< blocks.colourBlocks(1).size() << " blocks on each node" << endl;
+
+    END_CODE();
+  }
+
+
+  // e = block MR solves of M e = r on the blocks of a colour, zero elsewhere
+  template<typename TB, typename QB, typename CB>
+  void SAPCloverPrec::solveColour(TB& e, const TB& r, const QB& u, const CB& clov, int colour) const
+  {
+    TB res;
+    TB Ares;
+
+    e = zero;
+
+    const multi1d<int>& list = blocks.colourBlocks(colour);
+    SAPCloverEnv::BlockArgs<TB,QB,CB> a = {e, res, Ares, r, u, clov, blocks, list, invParam.BlockMRIter};
+    dispatch_to_threads(list.size(), a, SAPCloverEnv::blockMRLoop<TB,QB,CB>);
+  }
+
+
+  // chi = K psi, approximately M^-1 psi
+  void SAPCloverPrec::operator() (T& chi, const T& psi, enum PlusMinus isign) const
+  {
+    START_CODE();
+
+    T r;
+    T tmp;
+
+    chi = zero;
+
+    for(int cycle=0; cycle < invParam.NumCycles; ++cycle)
+    {
+      for(int colour=0; colour < 2; ++colour)
+      {
+	// The residual is the only global step
+	if (cycle == 0 && colour == 0)
+	  r = psi;
+	else
+	{
+	  (*A)(tmp, chi, PLUS);
+	  r = psi - tmp;
+	}
+
+	if (invParam.singlePrecBlocks)
+	{
+	  TF r_f = r;
+	  TF e_f;
+	  solveColour(e_f, r_f, u_f, *clov_f, colour);
+	  tmp = e_f;
+	}
+	else
+	{
+	  TD r_d = r;
+	  TD e_d;
+	  solveColour(e_d, r_d, u_d, *clov_d, colour);
+	  tmp = e_d;
+	}
+
+	chi += tmp;
+      }
+    }
+
+    END_CODE();
+  }
+
+}  // end namespace Chroma
@@ -0,0 +1,115 @@
+// -*- C++ -*-
+/*! \file
+ *  \brief Schwarz alternating procedure preconditioner for the clover operator
+ */
+
+#ifndef __sap_clover_w_h__
+#define __sap_clover_w_h__
+
+#include "chromabase.h"
+#include "handle.h"
+#include "state.h"
+#include "linearop.h"
+#include "actions/ferm/linop/clover_term_w.h"
+#include "actions/ferm/invert/syssolver_sap_clover_params.h"
+
+#include <vector>
+
+namespace Chroma
+{
+
+  //! Node-local blocks of the Schwarz alternating procedure
+  /*! \ingroup invert
+   *
+   * The lattice is cut into blocks of the given extents, each inside one
+   * node, and the blocks are coloured by the parity of the sum of their
+   * global block coordinates. Blocks of one colour never touch, so they
+   * can be solved at the same time.
+   */
+  class SAPBlocks
+  {
+  public:
+    //! Empty blocks. Must use create later
+    SAPBlocks() {}
+
+    //! Cut the lattice into blocks
+    void create(const multi1d<int>& blocking);
+
+    //! Blocks on this node
+    int numBlocks() const {return block_sites.size();}
+
+    //! Blocks of one colour on this node
+    const multi1d<int>& colourBlocks(int c) const {return colour_blocks[c];}
+
+    //! Sites of a block
+    const multi1d<int>& blockSites(int b) const {return block_sites[b];}
+
+    //! Neighbour of a site across hop h inside its block, or -1
+    /*! Hop h = 2*mu is forward along mu and h = 2*mu+1 backward */
+    int neighbour(int h, int site) const {return nbr[h][site];}
+
+  private:
+    std::vector< multi1d<int> >  block_sites;
+    multi1d<int>                 colour_blocks[2];
+    multi1d<int>                 nbr[2*Nd];
+  };
+
+
+  //! Schwarz alternating procedure preconditioner for the clover operator
+  /*! \ingroup invert
+   *
+   * Each cycle sweeps the two block colours in turn. A sweep computes the
+   * residual psi - M chi with the operator of the outer solver, the only
+   * step that communicates, and then adds to chi a few MR steps on
+   * the clover operator of every block of that colour with Dirichlet
+   * boundaries, from a zero guess. The block solves are independent,
+   * spread over the threads, and may run in single precision. The fixed
+   * number of MR steps makes this a variable preconditioner, to be used
+   * from a flexible outer solver.
+   */
+  class SAPCloverPrec : public LinearOperator<LatticeFermion>
+  {
+  public:
+    typedef LatticeFermion T;
+    typedef multi1d<LatticeColorMatrix> Q;
+
+    typedef LatticeFermionF TF;
+    typedef multi1d<LatticeColorMatrixF> QF;
+
+    typedef LatticeFermionD TD;
+    typedef multi1d<LatticeColorMatrixD> QD;
+
+    //! Full constructor
+    /*!
+     * \param A_        unpreconditioned clover operator of the outer solver ( Read )
+     * \param state_    gauge field state of A ( Read )
+     * \param invParam_ inverter parameters ( Read )
+     */
+    SAPCloverPrec(Handle< LinearOperator<T> > A_,
+		  Handle< FermState<T,Q,Q> > state_,
+		  const SysSolverSAPCloverParams& invParam_);
+
+    //! Subset of the operator
+    const Subset& subset() const {return A->subset();}
+
+    //! chi = K psi, approximately M^-1 psi
+    void operator() (T& chi, const T& psi, enum PlusMinus isign) const;
+
+  private:
+    //! e = block MR solves of M e = r on the blocks of a colour, zero elsewhere
+    template<typename TB, typename QB, typename CB>
+    void solveColour(TB& e, const TB& r, const QB& u, const CB& clov, int colour) const;
+
+    Handle< LinearOperator<T> > A;
+    SysSolverSAPCloverParams invParam;
+    SAPBlocks blocks;
+
+    QD u_d;                              /*!< hopping links with -1/2 and the anisotropy folded in */
+    QF u_f;
+    Handle< CloverTermD > clov_d;
+    Handle< CloverTermF > clov_f;
+  };
+
+}  // end namespace Chroma
+
+#endif
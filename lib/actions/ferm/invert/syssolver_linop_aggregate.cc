@@ -10,6 +10,7 @@
 #include "actions/ferm/invert/syssolver_linop_ibicgstab.h"
 #include "actions/ferm/invert/syssolver_linop_bicrstab.h"
 #include "actions/ferm/invert/syssolver_linop_mr.h"
+#include "actions/ferm/invert/syssolver_linop_mg_w.h"
 #include "actions/ferm/invert/syssolver_linop_cg_timing.h"
 #include "actions/ferm/invert/syssolver_linop_eigcg.h"
 #include "actions/ferm/invert/syssolver_linop_eigbicg.h"
@@ -17,6 +18,7 @@
 #include "actions/ferm/invert/syssolver_linop_rel_bicgstab_clover.h"
 #include "actions/ferm/invert/syssolver_linop_rel_ibicgstab_clover.h"
 #include "actions/ferm/invert/syssolver_linop_rel_cg_clover.h"
+#include "actions/ferm/invert/syssolver_linop_sap_clover.h"
 
 
 #include "chroma_config.h"
@@ -63,6 +65,7 @@ namespace Chroma
 	success &= LinOpSysSolverBiCRStabEnv::registerAll();
 	success &= LinOpSysSolverIBiCGStabEnv::registerAll();
 	success &= LinOpSysSolverMREnv::registerAll();
+	success &= LinOpSysSolverMGEnv::registerAll();
 	success &= LinOpSysSolverCGTimingEnv::registerAll();
 	success &= LinOpSysSolverEigCGEnv::registerAll();
 	success &= LinOpSysSolverEigBiCGEnv::registerAll();
@@ -70,6 +73,7 @@ namespace Chroma
 	success &= LinOpSysSolverReliableBiCGStabCloverEnv::registerAll();
 	success &= LinOpSysSolverReliableIBiCGStabCloverEnv::registerAll();
 	success &= LinOpSysSolverReliableCGCloverEnv::registerAll();
+	success &= LinOpSysSolverSAPCloverEnv::registerAll();
 #ifdef BUILD_QUDA
 	success &= LinOpSysSolverQUDACloverEnv::registerAll();
 	success &= LinOpSysSolverQUDAWilsonEnv::registerAll();
@@ -0,0 +1,252 @@
+/*! \file
+ *  \brief Solve a M*psi=chi linear system by the native Wilson multigrid
+ */
+
+#include "actions/ferm/invert/syssolver_linop_factory.h"
+#include "actions/ferm/invert/syssolver_linop_aggregate.h"
+
+#include "actions/ferm/invert/syssolver_linop_mg_w.h"
+#include "actions/ferm/invert/invfgmres.h"
+#include "meas/glue/mesplq.h"
+#include "meas/inline/io/named_objmap.h"
+
+namespace Chroma
+{
+
+  //! Native multigrid system solver namespace
+  namespace LinOpSysSolverMGEnv
+  {
+    //! Callback function
+    LinOpSystemSolver<LatticeFermion>* createFerm(XMLReader& xml_in,
+						  const std::string& path,
+						  Handle< FermState< LatticeFermion, multi1d<LatticeColorMatrix>, multi1d<LatticeColorMatrix> > > state, 
+						  Handle< LinearOperator<LatticeFermion> > A)
+    {
+      return new LinOpSysSolverMG(A, state, SysSolverMGParams(xml_in, path));
+    }
+
+    //! Name to be used
+    const std::string name("MULTIGRID_INVERTER");
+
+    //! Local registration flag
+    static bool registered = false;
+
+    //! Register all the factories
+    bool registerAll() 
+    {
+      bool success = true; 
+      if (! registered)
+      {
+	success &= Chroma::TheLinOpFermSystemSolverFactory::Instance().registerObject(name, createFerm);
+	registered = true;
+      }
+      return success;
+    }
+  }
+
+
+  //! Anonymous namespace
+  namespace
+  {
+    //! Does a kept setup have the null vectors of these links and params?
+    bool sameSubspace(const MGSetup& c, const Double& plaq, const Double& link,
+		      const SysSolverMGParams& p)
+    {
+      if (toBool(c.plaq != plaq) || toBool(c.link != link))
+	return false;
+
+      if (c.num_null_vecs != p.NumNullVecs || c.null_max_iter != p.NullMaxIter)
+	return false;
+
+      if (c.blocking.size() != p.Blocking.size())
+	return false;
+
+      for(int mu=0; mu < c.blocking.size(); ++mu)
+	if (c.blocking[mu] != p.Blocking[mu])
+	  return false;
+
+      return true;
+    }
+  }
+
+
+  // e = MR steps on A e = r from e = 0
+  void MGVCycle::smooth(LatticeFermion& e, const LatticeFermion& r, int hits) const
+  {
+    const Subset& s = A->subset();
+
+    LatticeFermion res;
+    LatticeFermion Ares;
+
+    e[s] = zero;
+    res[s] = r;
+
+    for(int k=0; k < hits; ++k)
+    {
+      (*A)(Ares, res, PLUS);
+      DComplex c = innerProduct(Ares, res, s);
+      Double d = norm2(Ares, s);
+      Complex a = c / d;
+      a = a * invParam.SmootherOmega;
+
+      e[s] += res * a;
+      res[s] -= Ares * a;
+    }
+  }
+
+
+  // chi = V psi, approximately A^-1 psi
+  void MGVCycle::operator() (LatticeFermion& chi, const LatticeFermion& psi, enum PlusMinus isign) const
+  {
+    START_CODE();
+
+    const Subset& s = A->subset();
+
+    LatticeFermion r;
+    LatticeFermion tmp;
+    LatticeFermion e;
+
+    chi[s] = zero;
+    r[s] = psi;
+
+    // Pre-smoothing
+    if (invParam.NumPreHits > 0)
+    {
+      smooth(e, r, invParam.NumPreHits);
+      chi[s] += e;
+
+      (*A)(tmp, chi, PLUS);
+      r[s] = psi - tmp;
+    }
+
+    // Coarse correction
+    {
+      MGCoarseVector rc;
+      MGCoarseVector ec(Ac->size(), MGComplex(0));
+
+      P->restrictTo(rc, r);
+      int n = mgCoarseGMRES(*Ac, rc, ec, invParam.CoarseNKrylov,
+			    toDouble(invParam.CoarseResidual), invParam.CoarseMaxIter);
+      P->prolongate(e, ec);
+      chi[s] += e;
+
+      coarse_iters += n;
+      if (invParam.verboseP)
+	QDPIO::cout << "MGVCycle: coarse iters = " << n << endl;
+    }
+
+    // Post-smoothing
+    if (invParam.NumPostHits > 0)
+    {
+      (*A)(tmp, chi, PLUS);
+      r[s] = psi - tmp;
+
+      smooth(e, r, invParam.NumPostHits);
+      chi[s] += e;
+    }
+
+    END_CODE();
+  }
+
+
+  // Constructor: set up the hierarchy
+  LinOpSysSolverMG::LinOpSysSolverMG(Handle< LinearOperator<T> > A_,
+				     Handle< FermState<T, multi1d<LatticeColorMatrix>, multi1d<LatticeColorMatrix> > > state_,
+				     const SysSolverMGParams& invParam_) :
+    A(A_), invParam(invParam_)
+  {
+    START_CODE();
+
+    if (A->subset().numSiteTable() != Layout::sitesOnNode())
+    {
+      QDPIO::cerr << "LinOpSysSolverMG: the multigrid needs the unpreconditioned operator on all sites,"
+		  << " not an even-odd preconditioned one - use an unpreconditioned FermionAction" << endl;
+      QDP_abort(1);
+    }
+
+    if (invParam.NumNullVecs < 1)
+    {
+      QDPIO::cerr << "LinOpSysSolverMG: NumNullVecs must be positive" << endl;
+      QDP_abort(1);
+    }
+
+    StopWatch swatch;
+    swatch.reset();
+    swatch.start();
+
+    Double w_plaq, s_plaq, t_plaq, link;
+    MesPlq(state_->getLinks(), w_plaq, s_plaq, t_plaq, link);
+
+    const bool keep = (invParam.SubspaceId != "");
+    if (keep && ! TheNamedObjMap::Instance().check(invParam.SubspaceId))
+      TheNamedObjMap::Instance().create<MGSetup>(invParam.SubspaceId);
+
+    MGSetup fresh;
+    MGSetup& setup = (keep) ? TheNamedObjMap::Instance().getData<MGSetup>(invParam.SubspaceId) : fresh;
+
+    bool new_subspace = (setup.P.operator->() == 0 || ! sameSubspace(setup, w_plaq, link, invParam));
+    if (new_subspace)
+    {
+      multi1d<LatticeFermion> null_vecs;
+      mgNullVectors(null_vecs, *A, invParam.NumNullVecs, invParam.NullMaxIter);
+
+      setup.P = new MGTransfer;
+      setup.P->create(invParam.Blocking, null_vecs);
+
+      setup.plaq = w_plaq;
+      setup.link = link;
+      setup.blocking = invParam.Blocking;
+      setup.num_null_vecs = invParam.NumNullVecs;
+      setup.null_max_iter = invParam.NullMaxIter;
+    }
+
+    // The coarse operator also depends on the mass and clover term
+    LatticeFermion Av;
+    (*A)(Av, setup.P->basis(0), PLUS);
+    DComplex vAv = innerProduct(setup.P->basis(0), Av, A->subset());
+    Double   Av2 = norm2(Av, A->subset());
+
+    if (new_subspace || toBool(Av2 != setup.Av2) ||
+	toBool(real(vAv) != real(setup.vAv)) || toBool(imag(vAv) != imag(setup.vAv)))
+    {
+      setup.Ac = new MGCoarseOp;
+      setup.Ac->create(*A, *(setup.P));
+      setup.vAv = vAv;
+      setup.Av2 = Av2;
+    }
+
+    vcycle = new MGVCycle(A, setup.P, setup.Ac, invParam);
+
+    swatch.stop();
+    QDPIO::cout << "LinOpSysSolverMG: setup time = " << swatch.getTimeInSeconds() << " secs"
+		<< ((new_subspace) ? "" : ", null vectors reused from " + invParam.SubspaceId) << endl;
+
+    END_CODE();
+  }
+
+
+  // Solve the linear system
+  SystemSolverResults_t LinOpSysSolverMG::operator() (T& psi, const T& chi) const
+  {
+    START_CODE();
+
+    StopWatch swatch;
+    swatch.reset();
+    swatch.start();
+
+    vcycle->resetCoarseIters();
+    SystemSolverResults_t res = InvFGMRES(*A, *vcycle, chi, psi,
+					  invParam.NKrylov, invParam.RsdTarget, invParam.MaxIter,
+					  invParam.verboseP);
+
+    swatch.stop();
+    QDPIO::cout << "MULTIGRID_INVERTER: iters = " << res.n_count
+		<< "  coarse iters = " << vcycle->coarseIters()
+		<< "  time = " << swatch.getTimeInSeconds() << " secs" << endl;
+
+    END_CODE();
+
+    return res;
+  }
+
+}
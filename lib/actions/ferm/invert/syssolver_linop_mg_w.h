@@ -0,0 +1,147 @@
+// -*- C++ -*-
+/*! \file
+ *  \brief Solve a M*psi=chi linear system by the native Wilson multigrid
+ */
+
+#ifndef __syssolver_linop_mg_w_h__
+#define __syssolver_linop_mg_w_h__
+
+#include "chroma_config.h"
+#include "handle.h"
+#include "state.h"
+#include "syssolver.h"
+#include "linearop.h"
+#include "actions/ferm/invert/syssolver_linop.h"
+#include "actions/ferm/invert/syssolver_mg_params_w.h"
+#include "actions/ferm/invert/mg_coarse_w.h"
+
+namespace Chroma
+{
+
+  //! Native multigrid system solver namespace
+  namespace LinOpSysSolverMGEnv
+  {
+    //! Register the syssolver
+    bool registerAll();
+  }
+
+
+  //! Two level V-cycle used as the preconditioner of the outer solver
+  /*! \ingroup invert
+   *
+   * MR pre-smoothing, a GMRES solve of the Galerkin coarse operator to a
+   * loose tolerance, and MR post-smoothing, all from a zero guess. The
+   * coarse solve makes this a variable preconditioner.
+   */
+  class MGVCycle : public LinearOperator<LatticeFermion>
+  {
+  public:
+    //! Full constructor
+    MGVCycle(Handle< LinearOperator<LatticeFermion> > A_,
+	     Handle<MGTransfer> P_,
+	     Handle<MGCoarseOp> Ac_,
+	     const SysSolverMGParams& invParam_) :
+      A(A_), P(P_), Ac(Ac_), invParam(invParam_), coarse_iters(0) {}
+
+    //! Subset of the fine operator
+    const Subset& subset() const {return A->subset();}
+
+    //! chi = V psi, approximately A^-1 psi
+    void operator() (LatticeFermion& chi, const LatticeFermion& psi, enum PlusMinus isign) const;
+
+    //! Coarse iterations since the last reset
+    int coarseIters() const {return coarse_iters;}
+
+    //! Start counting the coarse iterations afresh
+    void resetCoarseIters() const {coarse_iters = 0;}
+
+  private:
+    //! e = MR steps on A e = r from e = 0
+    void smooth(LatticeFermion& e, const LatticeFermion& r, int hits) const;
+
+    Handle< LinearOperator<LatticeFermion> > A;
+    Handle<MGTransfer>  P;
+    Handle<MGCoarseOp>  Ac;
+    SysSolverMGParams   invParam;
+    mutable int         coarse_iters;
+  };
+
+
+  //! Multigrid setup kept between solvers under the SubspaceId
+  /*! \ingroup invert */
+  struct MGSetup
+  {
+    Handle<MGTransfer>  P;
+    Handle<MGCoarseOp>  Ac;
+
+    Double              plaq;           /*!< plaquette of the links of the null vectors */
+    Double              link;           /*!< average link of the links of the null vectors */
+    multi1d<int>        blocking;
+    int                 num_null_vecs;
+    int                 null_max_iter;
+
+    DComplex            vAv;            /*!< <v, A v> of the first basis vector, to spot a new operator */
+    Double              Av2;            /*!< |A v|^2 of the first basis vector */
+  };
+
+
+  //! Solve a M*psi=chi linear system by the native Wilson multigrid
+  /*! \ingroup invert
+   *
+   * Flexible GMRES preconditioned by a two level V-cycle. The null vectors,
+   * the aggregates and the coarse operator are built once, when the solver
+   * is constructed, and reused by every solve.
+   *
+   * With a SubspaceId the setup is also kept in the named object map. A
+   * later solver on the same links with the same aggregation params reuses
+   * the null vectors and aggregates, and also the coarse operator if the
+   * fine operator is unchanged, e.g. for another source or the same mass.
+   *
+   * Limits: the operator must be the unpreconditioned one on all sites,
+   * so even-odd preconditioned actions such as the even-odd clover Schur
+   * complement are rejected. There are two levels only, and the null
+   * vectors come from a fixed number of MR relaxation steps on A v = 0,
+   * without adaptive refinement.
+   */
+  class LinOpSysSolverMG : public LinOpSystemSolver<LatticeFermion>
+  {
+  public:
+    typedef LatticeFermion T;
+
+    //! Constructor
+    /*!
+     * \param A_        Linear operator ( Read )
+     * \param state_    links of the operator, to key the kept setup ( Read )
+     * \param invParam  inverter parameters ( Read )
+     */
+    LinOpSysSolverMG(Handle< LinearOperator<T> > A_,
+		     Handle< FermState<T, multi1d<LatticeColorMatrix>, multi1d<LatticeColorMatrix> > > state_,
+		     const SysSolverMGParams& invParam_);
+
+    //! Destructor is automatic
+    ~LinOpSysSolverMG() {}
+
+    //! Return the subset on which the operator acts
+    const Subset& subset() const {return A->subset();}
+
+    //! Solver the linear system
+    /*!
+     * \param psi      solution ( Modify )
+     * \param chi      source ( Read )
+     * \return syssolver results
+     */
+    SystemSolverResults_t operator() (T& psi, const T& chi) const;
+
+  private:
+    // Hide default constructor
+    LinOpSysSolverMG() {}
+
+    Handle< LinearOperator<T> > A;
+    SysSolverMGParams invParam;
+    Handle<MGVCycle> vcycle;
+  };
+
+} // End namespace
+
+#endif 
+
@@ -85,8 +85,16 @@ namespace Chroma
       fstate_double = new PeriodicFermState<TD,QD,QD>(links_double);
 
       // Make single precision M
-      M_single= new EvenOddPrecDumbCloverFLinOp( fstate_single, invParam_.clovParams );
-      M_double= new EvenOddPrecDumbCloverDLinOp( fstate_double, invParam_.clovParams );
+      // converting the clover terms of A rather than rebuilding them if asked
+      const EvenOddPrecCloverLinOp* A_clov = cloverLinOpFrom(invParam_.clovFromOp, A_);
+      if (A_clov) {
+	M_single= new EvenOddPrecDumbCloverFLinOp( fstate_single, invParam_.clovParams, *A_clov );
+	M_double= new EvenOddPrecDumbCloverDLinOp( fstate_double, invParam_.clovParams, *A_clov );
+      }
+      else {
+	M_single= new EvenOddPrecDumbCloverFLinOp( fstate_single, invParam_.clovParams );
+	M_double= new EvenOddPrecDumbCloverDLinOp( fstate_double, invParam_.clovParams );
+      }
 
       std::istringstream is( invParam_.innerSolverParams.xml );
       XMLReader paramtop(is);
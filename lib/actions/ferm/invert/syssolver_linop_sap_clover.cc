@@ -0,0 +1,67 @@
+/*! \file
+ *  \brief Solve a M*psi=chi linear system by FGMRES with a SAP preconditioner
+ */
+
+#include "actions/ferm/invert/syssolver_linop_factory.h"
+#include "actions/ferm/invert/syssolver_linop_aggregate.h"
+
+#include "actions/ferm/invert/syssolver_linop_sap_clover.h"
+#include "actions/ferm/invert/invfgmres.h"
+
+namespace Chroma
+{
+
+  //! SAP preconditioned FGMRES system solver namespace
+  namespace LinOpSysSolverSAPCloverEnv
+  {
+    //! Callback function
+    LinOpSystemSolver<LatticeFermion>* createFerm(XMLReader& xml_in,
+						  const std::string& path,
+						  Handle< FermState< LatticeFermion, multi1d<LatticeColorMatrix>, multi1d<LatticeColorMatrix> > > state, 
+						  Handle< LinearOperator<LatticeFermion> > A)
+    {
+      return new LinOpSysSolverSAPClover(A, state, SysSolverSAPCloverParams(xml_in, path));
+    }
+
+    //! Name to be used
+    const std::string name("FGMRES_SAP_CLOVER_INVERTER");
+
+    //! Local registration flag
+    static bool registered = false;
+
+    //! Register all the factories
+    bool registerAll() 
+    {
+      bool success = true; 
+      if (! registered)
+      {
+	success &= Chroma::TheLinOpFermSystemSolverFactory::Instance().registerObject(name, createFerm);
+	registered = true;
+      }
+      return success;
+    }
+  }
+
+
+  // Solve the linear system
+  SystemSolverResults_t LinOpSysSolverSAPClover::operator() (T& psi, const T& chi) const
+  {
+    START_CODE();
+
+    StopWatch swatch;
+    swatch.reset();
+    swatch.start();
+
+    SystemSolverResults_t res = InvFGMRES(*A, *sap, chi, psi,
+					  invParam.NKrylov, invParam.RsdTarget, invParam.MaxIter, false);
+
+    swatch.stop();
+    QDPIO::cout << "FGMRES_SAP_CLOVER_INVERTER: iters = " << res.n_count
+		<< "  time = " << swatch.getTimeInSeconds() << " secs" << endl;
+
+    END_CODE();
+
+    return res;
+  }
+
+}
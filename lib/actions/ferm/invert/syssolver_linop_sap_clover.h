@@ -0,0 +1,79 @@
+// -*- C++ -*-
+/*! \file
+ *  \brief Solve a M*psi=chi linear system by FGMRES with a SAP preconditioner
+ */
+
+#ifndef __syssolver_linop_sap_clover_h__
+#define __syssolver_linop_sap_clover_h__
+
+#include "chroma_config.h"
+#include "handle.h"
+#include "state.h"
+#include "syssolver.h"
+#include "linearop.h"
+#include "actions/ferm/invert/syssolver_linop.h"
+#include "actions/ferm/invert/syssolver_sap_clover_params.h"
+#include "actions/ferm/invert/sap_clover_w.h"
+
+namespace Chroma
+{
+
+  //! SAP preconditioned FGMRES system solver namespace
+  namespace LinOpSysSolverSAPCloverEnv
+  {
+    //! Register the syssolver
+    bool registerAll();
+  }
+
+
+  //! Solve a M*psi=chi linear system by FGMRES with a SAP preconditioner
+  /*! \ingroup invert
+   *** WARNING THIS SOLVER WORKS FOR UNPRECONDITIONED CLOVER FERMIONS ONLY ***
+   *
+   * The blocks, the hopping links and the clover term of the block solves
+   * are built once, when the solver is constructed. Within the outer solver
+   * only the Gram-Schmidt and the residual updates of SAP communicate.
+   */
+  class LinOpSysSolverSAPClover : public LinOpSystemSolver<LatticeFermion>
+  {
+  public:
+    typedef LatticeFermion T;
+    typedef multi1d<LatticeColorMatrix> Q;
+
+    //! Constructor
+    /*!
+     * \param A_        Linear operator ( Read )
+     * \param state_    gauge field state ( Read )
+     * \param invParam  inverter parameters ( Read )
+     */
+    LinOpSysSolverSAPClover(Handle< LinearOperator<T> > A_,
+			    Handle< FermState<T,Q,Q> > state_,
+			    const SysSolverSAPCloverParams& invParam_) :
+      A(A_), invParam(invParam_), sap(new SAPCloverPrec(A_, state_, invParam_)) {}
+
+    //! Destructor is automatic
+    ~LinOpSysSolverSAPClover() {}
+
+    //! Return the subset on which the operator acts
+    const Subset& subset() const {return A->subset();}
+
+    //! Solver the linear system
+    /*!
+     * \param psi      solution ( Modify )
+     * \param chi      source ( Read )
+     * \return syssolver results
+     */
+    SystemSolverResults_t operator() (T& psi, const T& chi) const;
+
+  private:
+    // Hide default constructor
+    LinOpSysSolverSAPClover() {}
+
+    Handle< LinearOperator<T> > A;
+    SysSolverSAPCloverParams invParam;
+    Handle<SAPCloverPrec> sap;
+  };
+
+} // End namespace
+
+#endif 
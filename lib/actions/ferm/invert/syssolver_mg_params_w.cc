@@ -0,0 +1,102 @@
+/*! \file
+ *  \brief Parameters of the native Wilson multigrid solver
+ */
+
+#include "actions/ferm/invert/syssolver_mg_params_w.h"
+
+namespace Chroma
+{
+
+  // Read parameters
+  void read(XMLReader& xml, const string& path, SysSolverMGParams& param)
+  {
+    XMLReader paramtop(xml, path);
+
+    SysSolverMGParams defaults;
+    param = defaults;
+
+    read(paramtop, "RsdTarget", param.RsdTarget);
+    read(paramtop, "MaxIter", param.MaxIter);
+    read(paramtop, "Blocking", param.Blocking);
+    read(paramtop, "NumNullVecs", param.NumNullVecs);
+
+    if (paramtop.count("NKrylov") > 0)
+      read(paramtop, "NKrylov", param.NKrylov);
+
+    if (paramtop.count("NullMaxIter") > 0)
+      read(paramtop, "NullMaxIter", param.NullMaxIter);
+
+    if (paramtop.count("NumPreHits") > 0)
+      read(paramtop, "NumPreHits", param.NumPreHits);
+
+    if (paramtop.count("NumPostHits") > 0)
+      read(paramtop, "NumPostHits", param.NumPostHits);
+
+    if (paramtop.count("SmootherOmega") > 0)
+      read(paramtop, "SmootherOmega", param.SmootherOmega);
+
+    if (paramtop.count("CoarseResidual") > 0)
+      read(paramtop, "CoarseResidual", param.CoarseResidual);
+
+    if (paramtop.count("CoarseMaxIter") > 0)
+      read(paramtop, "CoarseMaxIter", param.CoarseMaxIter);
+
+    if (paramtop.count("CoarseNKrylov") > 0)
+      read(paramtop, "CoarseNKrylov", param.CoarseNKrylov);
+
+    if (paramtop.count("Verbose") > 0)
+      read(paramtop, "Verbose", param.verboseP);
+
+    if (paramtop.count("SubspaceId") > 0)
+      read(paramtop, "SubspaceId", param.SubspaceId);
+  }
+
+  // Writer parameters
+  void write(XMLWriter& xml, const string& path, const SysSolverMGParams& param)
+  {
+    push(xml, path);
+
+    write(xml, "invType", "MULTIGRID_INVERTER");
+    write(xml, "RsdTarget", param.RsdTarget);
+    write(xml, "MaxIter", param.MaxIter);
+    write(xml, "NKrylov", param.NKrylov);
+    write(xml, "Blocking", param.Blocking);
+    write(xml, "NumNullVecs", param.NumNullVecs);
+    write(xml, "NullMaxIter", param.NullMaxIter);
+    write(xml, "NumPreHits", param.NumPreHits);
+    write(xml, "NumPostHits", param.NumPostHits);
+    write(xml, "SmootherOmega", param.SmootherOmega);
+    write(xml, "CoarseResidual", param.CoarseResidual);
+    write(xml, "CoarseMaxIter", param.CoarseMaxIter);
+    write(xml, "CoarseNKrylov", param.CoarseNKrylov);
+    write(xml, "Verbose", param.verboseP);
+    if (param.SubspaceId != "")
+      write(xml, "SubspaceId", param.SubspaceId);
+
+    pop(xml);
+  }
+
+  //! Default constructor
+  SysSolverMGParams::SysSolverMGParams()
+  {
+    RsdTarget = zero;
+    MaxIter = 0;
+    NKrylov = 16;
+    NumNullVecs = 0;
+    NullMaxIter = 20;
+    NumPreHits = 0;
+    NumPostHits = 4;
+    SmootherOmega = 1.0;
+    CoarseResidual = 0.1;
+    CoarseMaxIter = 100;
+    CoarseNKrylov = 16;
+    verboseP = false;
+  }
+
+  //! Read parameters
+  SysSolverMGParams::SysSolverMGParams(XMLReader& xml, const string& path)
+  {
+    read(xml, path, *this);
+  }
+
+}
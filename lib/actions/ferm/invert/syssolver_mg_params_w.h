@@ -0,0 +1,58 @@
+// -*- C++ -*-
+/*! \file
+ *  \brief Parameters of the native Wilson multigrid solver
+ */
+
+#ifndef __syssolver_mg_params_w_h__
+#define __syssolver_mg_params_w_h__
+
+#include "chromabase.h"
+
+
+namespace Chroma
+{
+
+  //! Params of the native Wilson multigrid inverter
+  /*! \ingroup invert */
+  struct SysSolverMGParams
+  {
+    SysSolverMGParams();
+    SysSolverMGParams(XMLReader& in, const std::string& path);
+
+    // Outer solver
+    Real          RsdTarget;       /*!< Target relative residual */
+    int           MaxIter;         /*!< Maximum outer iterations */
+    int           NKrylov;         /*!< Restart length of the outer FGMRES */
+
+    // Aggregation
+    multi1d<int>  Blocking;        /*!< Block extents, each dividing the node extent */
+    int           NumNullVecs;     /*!< Null vectors, each split in two by chirality */
+    int           NullMaxIter;     /*!< MR steps relaxing each null vector */
+
+    // Smoother
+    int           NumPreHits;      /*!< MR smoother steps before the coarse correction */
+    int           NumPostHits;     /*!< MR smoother steps after the coarse correction */
+    Real          SmootherOmega;   /*!< MR over-relaxation of the smoother */
+
+    // Coarse solve
+    Real          CoarseResidual;  /*!< Relative residual of the coarse GMRES */
+    int           CoarseMaxIter;   /*!< Maximum coarse iterations */
+    int           CoarseNKrylov;   /*!< Restart length of the coarse GMRES */
+
+    bool          verboseP;        /*!< Print every outer iteration and V-cycle */
+
+    std::string   SubspaceId;      /*!< Named object keeping the setup for later solvers, none if empty */
+  };
+
+
+  // Reader/writers
+  /*! \ingroup invert */
+  void read(XMLReader& xml, const string& path, SysSolverMGParams& param);
+
+  /*! \ingroup invert */
+  void write(XMLWriter& xml, const string& path, const SysSolverMGParams& param);
+
+} // End namespace
+
+#endif 
+
@@ -16,6 +16,10 @@ namespace Chroma {
     read(paramtop, "RsdTarget", RsdTarget);
     read(paramtop, "CloverParams", clovParams);
     read(paramtop, "Delta", Delta);
+
+    clovFromOp = false;
+    if (paramtop.count("CloverFromOperator") > 0)
+      read(paramtop, "CloverFromOperator", clovFromOp);
   }
 
   void read(XMLReader& xml, const std::string& path, 
@@ -31,6 +35,7 @@ namespace Chroma {
     write(xml, "MaxIter", p.MaxIter);
     write(xml, "RsdTarget", p.RsdTarget);
     write(xml, "CloverParams", p.clovParams);
+    write(xml, "CloverFromOperator", p.clovFromOp);
     write(xml, "Delta", p.Delta);
     pop(xml);
 
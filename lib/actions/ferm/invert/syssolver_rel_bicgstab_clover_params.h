@@ -9,16 +9,18 @@ namespace Chroma
 {
   struct SysSolverReliableBiCGStabCloverParams { 
     SysSolverReliableBiCGStabCloverParams(XMLReader& xml, const std::string& path);
-    SysSolverReliableBiCGStabCloverParams() {};
+    SysSolverReliableBiCGStabCloverParams() : clovFromOp(false) {};
     SysSolverReliableBiCGStabCloverParams( const SysSolverReliableBiCGStabCloverParams& p) {
       clovParams = p.clovParams;
       MaxIter = p.MaxIter;
       RsdTarget = p.RsdTarget;
+      clovFromOp = p.clovFromOp;
       Delta = p.Delta;
     }
     CloverFermActParams clovParams;
     int MaxIter;
     Real RsdTarget;
+    bool clovFromOp;   /*!< convert the clover terms of the operator rather than rebuild them */
     Real Delta;
   };
 
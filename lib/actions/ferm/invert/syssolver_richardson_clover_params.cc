@@ -15,6 +15,10 @@ namespace Chroma {
     read(paramtop, "MaxIter", MaxIter);
     read(paramtop, "RsdTarget", RsdTarget);
     read(paramtop, "CloverParams", clovParams);
+
+    clovFromOp = false;
+    if (paramtop.count("CloverFromOperator") > 0)
+      read(paramtop, "CloverFromOperator", clovFromOp);
     innerSolverParams = readXMLGroup(paramtop, "InnerSolverParams", "invType");
   }
 
@@ -31,6 +35,7 @@ namespace Chroma {
     write(xml, "MaxIter", p.MaxIter);
     write(xml, "RsdTarget", p.RsdTarget);
     write(xml, "CloverParams", p.clovParams);
+    write(xml, "CloverFromOperator", p.clovFromOp);
     xml << p.innerSolverParams.xml;
     pop(xml);
 
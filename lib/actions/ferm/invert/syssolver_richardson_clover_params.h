@@ -9,16 +9,18 @@ namespace Chroma
 {
   struct SysSolverRichardsonCloverParams { 
     SysSolverRichardsonCloverParams(XMLReader& xml, const std::string& path);
-    SysSolverRichardsonCloverParams() {};
+    SysSolverRichardsonCloverParams() : clovFromOp(false) {};
     SysSolverRichardsonCloverParams( const SysSolverRichardsonCloverParams& p) {
       clovParams = p.clovParams;
       MaxIter = p.MaxIter;
       RsdTarget = p.RsdTarget;
+      clovFromOp = p.clovFromOp;
       innerSolverParams = p.innerSolverParams;
     }
     CloverFermActParams clovParams;
     int MaxIter;
     Real RsdTarget;
+    bool clovFromOp;   /*!< convert the clover terms of the operator rather than rebuild them */
     GroupXML_t innerSolverParams;
   };
 
@@ -0,0 +1,59 @@
+/*! \file
+ *  \brief Parameters of FGMRES with a Schwarz alternating procedure preconditioner
+ */
+
+#include "actions/ferm/invert/syssolver_sap_clover_params.h"
+#include "chromabase.h"
+
+using namespace QDP;
+
+namespace Chroma {
+  
+  SysSolverSAPCloverParams::SysSolverSAPCloverParams(XMLReader& xml, 
+						     const std::string& path)
+  {
+    XMLReader paramtop(xml, path);
+    read(paramtop, "MaxIter", MaxIter);
+    read(paramtop, "RsdTarget", RsdTarget);
+    read(paramtop, "CloverParams", clovParams);
+    read(paramtop, "Blocking", Blocking);
+
+    NKrylov = 16;
+    if (paramtop.count("NKrylov") > 0)
+      read(paramtop, "NKrylov", NKrylov);
+
+    NumCycles = 4;
+    if (paramtop.count("NumCycles") > 0)
+      read(paramtop, "NumCycles", NumCycles);
+
+    BlockMRIter = 4;
+    if (paramtop.count("BlockMRIter") > 0)
+      read(paramtop, "BlockMRIter", BlockMRIter);
+
+    singlePrecBlocks = false;
+    if (paramtop.count("SinglePrecBlocks") > 0)
+      read(paramtop, "SinglePrecBlocks", singlePrecBlocks);
+  }
+
+  void read(XMLReader& xml, const std::string& path, 
+	    SysSolverSAPCloverParams& p)
+  {
+    SysSolverSAPCloverParams tmp(xml, path);
+    p = tmp;
+  }
+
+  void write(XMLWriter& xml, const std::string& path, 
+	     const SysSolverSAPCloverParams& p) {
+    push(xml, path);
+    write(xml, "MaxIter", p.MaxIter);
+    write(xml, "RsdTarget", p.RsdTarget);
+    write(xml, "CloverParams", p.clovParams);
+    write(xml, "NKrylov", p.NKrylov);
+    write(xml, "Blocking", p.Blocking);
+    write(xml, "NumCycles", p.NumCycles);
+    write(xml, "BlockMRIter", p.BlockMRIter);
+    write(xml, "SinglePrecBlocks", p.singlePrecBlocks);
+    pop(xml);
+  }
+
+}
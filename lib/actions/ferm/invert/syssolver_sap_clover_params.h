@@ -0,0 +1,37 @@
+// -*- C++ -*-
+/*! \file
+ *  \brief Parameters of FGMRES with a Schwarz alternating procedure preconditioner
+ */
+
+#ifndef __syssolver_sap_clover_params_h__
+#define __syssolver_sap_clover_params_h__
+
+#include "chromabase.h"
+#include "actions/ferm/fermacts/clover_fermact_params_w.h"
+
+namespace Chroma 
+{
+  //! Params of FGMRES preconditioned by SAP on clover blocks
+  /*! \ingroup invert */
+  struct SysSolverSAPCloverParams { 
+    SysSolverSAPCloverParams(XMLReader& xml, const std::string& path);
+    SysSolverSAPCloverParams() : NKrylov(16), NumCycles(4), BlockMRIter(4), singlePrecBlocks(false) {};
+
+    CloverFermActParams clovParams;
+    int MaxIter;
+    Real RsdTarget;
+    int NKrylov;              /*!< restart length of the outer FGMRES */
+    multi1d<int> Blocking;    /*!< block extents, each dividing the node extent */
+    int NumCycles;            /*!< SAP cycles per preconditioner application */
+    int BlockMRIter;          /*!< MR steps of each block solve */
+    bool singlePrecBlocks;    /*!< solve the blocks in single precision */
+  };
+
+  void read(XMLReader& xml, const std::string& path, SysSolverSAPCloverParams& p);
+
+  void write(XMLWriter& xml, const std::string& path, 
+	     const SysSolverSAPCloverParams& param);
+
+}
+
+#endif
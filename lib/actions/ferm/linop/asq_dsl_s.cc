@@ -68,71 +68,156 @@ namespace Chroma
     //  write(xml_out,"u_triple", u_triple);
     //  pop(xml_out);
 
+    // One- and three-hop neighbours
+    multi1d<int> dists(2);
+    dists[0] = 1;
+    dists[1] = 3;
+
+    halo = new DslashHalo;
+    halo->create(sizeof(LatticeStaggeredFermion::Subtype_t), dists);
+
     END_CODE();
   }
 
+
+  //! Site kernels of the single pass dslash
+  namespace QDPStaggeredDslashEnv
+  {
+    typedef LatticeStaggeredFermion::Subtype_t  FermSite_t;
+
+    struct PackArgs
+    {
+      const LatticeStaggeredFermion&       psi;
+      const multi1d<LatticeColorMatrix>&   u_fat;
+      const multi1d<LatticeColorMatrix>&   u_triple;
+      const DslashHalo&                    halo;
+      int                                  cb;    /*!< checkerboard of the output */
+      int                                  h;
+    };
+
+    //! Fill the send buffer of a hop
+    /*! Backward hops carry the link of the sending site */
+    void packSiteLoop(int lo, int hi, int myId, PackArgs* a)
+    {
+      const int mu = (a->h / 2) % Nd;
+      const int d  = a->h / (2*Nd);
+      const bool back = (a->h % 2 == 1);
+      const multi1d<int>& sites = a->halo.sendSites(a->cb, a->h);
+      FermSite_t* buf = (FermSite_t *)(a->halo.sendBuf(a->cb, a->h));
+      const LatticeColorMatrix& u = (d == 0) ? a->u_fat[mu] : a->u_triple[mu];
+
+      for(int k=lo; k < hi; ++k)
+      {
+	int y = sites[k];
+
+	if (back)
+	  buf[k] = adj(u.elem(y)) * a->psi.elem(y);
+	else
+	  buf[k] = a->psi.elem(y);
+      }
+    }
+
+    struct SiteArgs
+    {
+      LatticeStaggeredFermion&             chi;
+      const LatticeStaggeredFermion&       psi;
+      const multi1d<LatticeColorMatrix>&   u_fat;
+      const multi1d<LatticeColorMatrix>&   u_triple;
+      const DslashHalo&                    halo;
+      const multi1d<int>&                  sites;
+      int                                  cb;    /*!< checkerboard of the output */
+      bool                                 dag;
+    };
+
+    //! Neighbour across a hop, from the node or the receive buffer
+    inline const FermSite_t& hopSite(const SiteArgs* a, int h, int x)
+    {
+      int y = a->halo.neighbour(h, x);
+      if (y >= 0)
+	return a->psi.elem(y);
+      else
+	return ((const FermSite_t *)(a->halo.recvBuf(a->cb, h)))[-1-y];
+    }
+
+    //! Whole dslash of a site, fat and long links together
+    void dslashSiteLoop(int lo, int hi, int myId, SiteArgs* a)
+    {
+      for(int ss=lo; ss < hi; ++ss)
+      {
+	int x = a->sites[ss];
+	FermSite_t r;
+	zero_rep(r);
+
+	for(int mu=0; mu < Nd; ++mu)
+	{
+	  // Forward one and three hops
+	  r += a->u_fat[mu].elem(x) * hopSite(a, DslashHalo::hop(mu, 0, 0), x);
+	  r += a->u_triple[mu].elem(x) * hopSite(a, DslashHalo::hop(mu, 1, 0), x);
+
+	  // Backward one and three hops, with the link of the far site
+	  int y = a->halo.neighbour(DslashHalo::hop(mu, 0, 1), x);
+	  if (y >= 0)
+	    r -= adj(a->u_fat[mu].elem(y)) * a->psi.elem(y);
+	  else
+	    r -= hopSite(a, DslashHalo::hop(mu, 0, 1), x);
+
+	  y = a->halo.neighbour(DslashHalo::hop(mu, 1, 1), x);
+	  if (y >= 0)
+	    r -= adj(a->u_triple[mu].elem(y)) * a->psi.elem(y);
+	  else
+	    r -= hopSite(a, DslashHalo::hop(mu, 1, 1), x);
+	}
+
+	if (a->dag)
+	  a->chi.elem(x) = -r;
+	else
+	  a->chi.elem(x) = r;
+      }
+    }
+  }
+
+
   void QDPStaggeredDslash::apply (LatticeStaggeredFermion& chi, const LatticeStaggeredFermion& psi, enum PlusMinus isign, int cb) const
   {
     START_CODE();
 
+    using namespace QDPStaggeredDslashEnv;
+
     const multi1d<LatticeColorMatrix>& u_fat = state->getFatLinks();
     const multi1d<LatticeColorMatrix>& u_triple = state->getTripleLinks();
+    const DslashHalo& hl = *halo;
 
     // need convention on isign
     //
     // isign == PLUS is normal isign == MINUS is daggered
     //
 
-    LatticeStaggeredFermion tmp_0 = zero;
-    LatticeStaggeredFermion tmp_1 = zero;
-    LatticeStaggeredFermion tmp_2 = zero;
-
-    int mu;
-
-    /* Forward one-hop and three-hop neigbhors */
     /* Note the KS phase factors are already included in the U's! */
-    mu = 0;
-    tmp_0 = shift(psi, FORWARD, mu);
-    chi[rb[cb]] = u_fat[mu] * tmp_0; // Color matrix X color vector : 66 flops
-    //  NEIGHBOUR(tmp_0, tmp_1, FORWARD, mu, 1);
-    tmp_1 = shift(tmp_0, FORWARD, mu);
-    tmp_2 = shift(tmp_1, FORWARD, mu);
-    chi[rb[cb]] += u_triple[mu] * tmp_2; // +66 + 6  flops
-
-    for(mu = 1;mu  <= ( Nd - 1); ++mu )
+
+    // Pack and post the whole three deep halo
+    for(int h=0; h < hl.numHops(); ++h)
     {
-      tmp_0 = shift(psi, FORWARD, mu);
-      chi[rb[cb]] += u_fat[mu] * tmp_0; //+66 + 6 flops
-      //    NEIGHBOUR(tmp_0, tmp_1, FORWARD, mu, 1);
-      tmp_1 = shift(tmp_0, FORWARD, mu);
-      tmp_2 = shift(tmp_1, FORWARD, mu);
-      chi[rb[cb]] += u_triple[mu] * tmp_2; //+66 + 6 flops
-    }
+      if (! hl.hasComms(cb, h))
+	continue;
 
-    // Up to now 570 flops
+      PackArgs a = {psi, u_fat, u_triple, hl, cb, h};
+      dispatch_to_threads(hl.sendSites(cb, h).size(), a, packSiteLoop);
+      hl.start(cb, h);
+    }
 
-    /* Backward one-hop and three-hop neigbhors */
-    /* Note the KS phase factors are already included in the U's! */
-    for(mu = 0;mu  <= ( Nd - 1); ++mu )
+    // Interior sites while the messages are in flight
     {
-      chi[rb[cb]] -= shift(adj(u_fat[mu]), BACKWARD, mu) * shift(psi,BACKWARD, mu);
-      // +66 + 6 flops
-      tmp_0 = shift(adj(u_triple[mu]),  BACKWARD, mu) * shift(psi, BACKWARD,  mu);
-      // +66 flops
-      // NEIGHBOUR(tmp_0, tmp_1, BACKWARD, mu, 1);
-      tmp_1 = shift(tmp_0, BACKWARD, mu);
-      tmp_2 = shift(tmp_1, BACKWARD, mu);
-
-      chi[rb[cb]] -= tmp_2; //+6 flops
+      SiteArgs a = {chi, psi, u_fat, u_triple, hl, hl.innerSites(cb), cb, isign == MINUS};
+      dispatch_to_threads(hl.innerSites(cb).size(), a, dslashSiteLoop);
     }
 
+    hl.wait(cb);
 
-    // this requires more thought
-    // No it doesnt
-    // const int MINUS = -1 ;
-     
-    if(isign == MINUS)
-      chi = -chi;
+    // Face sites
+    {
+      SiteArgs a = {chi, psi, u_fat, u_triple, hl, hl.faceSites(cb), cb, isign == MINUS};
+      dispatch_to_threads(hl.faceSites(cb).size(), a, dslashSiteLoop);
+    }
 
     END_CODE();
   }
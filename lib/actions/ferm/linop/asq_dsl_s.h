@@ -9,6 +9,7 @@
 
 #include "linearop.h"
 #include "actions/ferm/fermstates/asqtad_state.h"
+#include "actions/ferm/linop/dslash_halo.h"
 
 
 namespace Chroma 
@@ -47,6 +48,10 @@ namespace Chroma
    *			+ c_3 U  (x) U  (x-2mu) U  (x-3mu) psi(x-3mu) ]
    *                             mu     mu         mu
    * Note the KS phase factors are already included in the U's!
+   *
+   * The one- and three-hop neighbours come from a single halo exchange
+   * three sites deep, and each output site applies the fat and long
+   * links in one pass.
    */
 
   class QDPStaggeredDslash : public DslashLinearOperator< 
@@ -90,6 +95,7 @@ namespace Chroma
 
   private:
     Handle<AsqtadConnectStateBase> state;
+    Handle<DslashHalo> halo;
   };
 
 } // End Namespace Chroma
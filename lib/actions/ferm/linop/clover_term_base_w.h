@@ -604,6 +604,73 @@ namespace Chroma
     END_CODE();
   }
 
+#ifndef QDP_IS_QDPJIT
+  //! Site kernel of the multipole clover derivative
+  namespace CloverTermBaseEnv
+  {
+    template<typename T, typename U>
+    struct DerivMultipoleArgs
+    {
+      multi1d<U>&           s_xy_dag;   /*!< one per (mu,nu) plane, in the order of the mu < nu loops */
+      const multi1d<T>&     chi;
+      const multi1d<T>&     psi;
+      const multi1d<Real>&  factor;     /*!< weight of each plane */
+      const multi1d<int>&   sites;
+    };
+
+    //! s_xy_dag[p] = factor[p] * sum_i Tr_spin (gamma_mu gamma_nu psi_i) chi_i^dag
+    /*!
+     * Each site reads the vectors of every pole once for all six planes.
+     * The gammas are those of Gamma(2^mu + 2^nu) for Nd = 4.
+     */
+    template<typename T, typename U>
+    void derivMultipoleSiteLoop(int lo, int hi, int myId, DerivMultipoleArgs<T,U>* a)
+    {
+      for(int ss=lo; ss < hi; ++ss)
+      {
+	int site = a->sites[ss];
+
+	typename U::Subtype_t& s01 = a->s_xy_dag[0].elem(site);
+	typename U::Subtype_t& s02 = a->s_xy_dag[1].elem(site);
+	typename U::Subtype_t& s03 = a->s_xy_dag[2].elem(site);
+	typename U::Subtype_t& s12 = a->s_xy_dag[3].elem(site);
+	typename U::Subtype_t& s13 = a->s_xy_dag[4].elem(site);
+	typename U::Subtype_t& s23 = a->s_xy_dag[5].elem(site);
+
+	zero_rep(s01); zero_rep(s02); zero_rep(s03);
+	zero_rep(s12); zero_rep(s13); zero_rep(s23);
+
+	for(int i=0; i < a->chi.size(); ++i)
+	{
+	  const typename T::Subtype_t& p = a->psi[i].elem(site);
+	  const typename T::Subtype_t& c = a->chi[i].elem(site);
+
+	  s01 += traceSpin(outerProduct(GammaConst<Ns,3>()*p, c));
+	  s02 += traceSpin(outerProduct(GammaConst<Ns,5>()*p, c));
+	  s03 += traceSpin(outerProduct(GammaConst<Ns,9>()*p, c));
+	  s12 += traceSpin(outerProduct(GammaConst<Ns,6>()*p, c));
+	  s13 += traceSpin(outerProduct(GammaConst<Ns,10>()*p, c));
+	  s23 += traceSpin(outerProduct(GammaConst<Ns,12>()*p, c));
+	}
+
+	s01 *= a->factor[0].elem();
+	s02 *= a->factor[1].elem();
+	s03 *= a->factor[2].elem();
+	s12 *= a->factor[3].elem();
+	s13 *= a->factor[4].elem();
+	s23 *= a->factor[5].elem();
+      }
+    }
+  }
+#endif
+
+
+  //! Take deriv of D summed over several pairs of vectors
+  /*!
+   * The spin traces of all the poles and all the (mu,nu) planes come from
+   * one site kernel, which reads each pole once per site. Only then are
+   * the loops of each plane inserted.
+   */
   template<typename T, typename U>
   void CloverTermBase<T,U>::derivMultipole(multi1d<U>& ds_u, 
 					   const multi1d<T>& chi, const multi1d<T>& psi, 
@@ -619,13 +686,40 @@ namespace Chroma
 
     ds_u = zero;
 
-    // Get the links
-    const multi1d<U>& u = getU();
+    // One spin trace and weight per (mu,nu) plane
+    const int num_planes = Nd*(Nd-1)/2;
+    multi1d<U> s_xy_dag(num_planes);
+    multi1d<Real> factor(num_planes);
+
+    for(int mu=0, p=0; mu < Nd; mu++) {
+      for(int nu = mu+1; nu < Nd; nu++, p++) {
+	// The weight for the terms
+	factor[p] = (Real(-1)/Real(8))*getCloverCoeff(mu,nu);
+      }
+    }
 
+#ifndef QDP_IS_QDPJIT
+    {
+      CloverTermBaseEnv::DerivMultipoleArgs<T,U> a = {s_xy_dag, chi, psi, factor, rb[cb].siteTable()};
+      dispatch_to_threads(rb[cb].numSiteTable(), a, CloverTermBaseEnv::derivMultipoleSiteLoop<T,U>);
+    }
+#else
+    for(int mu=0, p=0; mu < Nd; mu++) {
+      for(int nu = mu+1; nu < Nd; nu++, p++) {
+	int mu_nu_index = (1 << mu) + (1 << nu); // 2^{mu} 2^{nu}
+
+	s_xy_dag[p][rb[cb]] = zero;
+	for(int i=0; i < chi.size(); i++) { 
+	  s_xy_dag[p][rb[cb]] += traceSpin( outerProduct(Gamma(mu_nu_index)*psi[i],chi[i]));
+	}
+	s_xy_dag[p][rb[cb]] *= factor[p];
+      }
+    }
+#endif
 
     // Now compute the insertions
-    for(int mu=0; mu < Nd; mu++) {
-      for(int nu = mu+1; nu < Nd; nu++) {
+    for(int mu=0, p=0; mu < Nd; mu++) {
+      for(int nu = mu+1; nu < Nd; nu++, p++) {
 	
 	// These will be appropriately overwritten - no need to zero them.
 	// Contributions to mu links from mu-nu clover piece
@@ -635,31 +729,15 @@ namespace Chroma
 	// -ve because of the exchange of gamma_mu gamma_nu <-> gamma_nu gamma_mu
 	U ds_tmp_nu;
 
-	// The weight for the terms
-	Real factor = (Real(-1)/Real(8))*getCloverCoeff(mu,nu);
-
-	// Get gamma_mu gamma_nu psi -- no saving here, from storing shifts because
-	// I now only do every mu, nu pair only once.
-
-	int mu_nu_index = (1 << mu) + (1 << nu); // 2^{mu} 2^{nu}
-
-	// Accumulate all the trace spin outer products 
-	U s_xy_dag = zero;
-	for(int i=0; i < chi.size(); i++) { 
-	  T ferm_tmp = Gamma(mu_nu_index)*psi[i];
-	  s_xy_dag += traceSpin( outerProduct(ferm_tmp,chi[i]));
-	}
-
-	s_xy_dag *= Real(factor);
+	// The loops only read the spin traces on cb, but shift the whole field
+	s_xy_dag[p][rb[1-cb]] = zero;
 
 	// Compute contributions
-	deriv_loops(mu, nu, cb, ds_tmp_mu, ds_tmp_nu, s_xy_dag);
+	deriv_loops(mu, nu, cb, ds_tmp_mu, ds_tmp_nu, s_xy_dag[p]);
 
 	// Accumulate them
 	ds_u[mu] += ds_tmp_mu;
 	ds_u[nu] -= ds_tmp_nu;
-
-
       }
     }
 
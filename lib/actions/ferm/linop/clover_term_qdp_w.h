@@ -11,6 +11,8 @@
 #include "actions/ferm/fermacts/clover_fermact_params_w.h"
 #include "actions/ferm/linop/clover_term_base_w.h"
 #include "meas/glue/mesfield.h"
+#include "util/thread/tuned_dispatch.h"
+#include "util/thread/numa_affinity.h"
 namespace Chroma 
 { 
 
@@ -69,6 +71,17 @@ namespace Chroma
 			const CloverFermActParams& param_,
 			const QDPCloverTermT<T,U>& from_);
 
+    //! Copy a clover term of another precision, with its inverses
+    /*!
+     * The blocks are converted to the precision of this term rather than
+     * rebuilt from the links, so a single precision copy of a factored
+     * term can be kept for preconditioners and inner solves.
+     */
+    template<typename T1, typename U1>
+    void create(Handle< FermState<T, multi1d<U>, multi1d<U> > > fs,
+		const CloverFermActParams& param_,
+		const QDPCloverTermT<T1,U1>& from_);
+
     //! Computes the inverse of the term on cb using Cholesky
     /*!
      * \param cb   checkerboard of work (Read)
@@ -150,7 +163,8 @@ namespace Chroma
                                  // on a particular checkerboard. 
 
     multi1d<PrimitiveClovTriang<REALT> >  tri;
-    
+
+    template<typename T1, typename U1> friend class QDPCloverTermT;
   };
 
 
@@ -158,6 +172,46 @@ namespace Chroma
   template<typename T, typename U>
   QDPCloverTermT<T,U>::QDPCloverTermT() {}
 
+
+  namespace QDPCloverEnv { 
+
+    //! Name of a site loop for the schedule tuning, with its precision
+    template<typename R>
+    inline std::string tuneName(const char* kernel)
+    {
+      return std::string(kernel) + ((sizeof(R) == 4) ? "_f" : "_d");
+    }
+
+    template<typename R, typename R1>
+    struct ConvertTriArgs {
+      multi1d<PrimitiveClovTriang<R> >&         tri;
+      const multi1d<PrimitiveClovTriang<R1> >&  from;
+      const multi1d<int>&                       tab;
+    };
+
+    //! Copy the sites of one checkerboard, in the thread blocks that apply them
+    template<typename R, typename R1>
+    void convertTriSiteLoop(int lo, int hi, int myId, ConvertTriArgs<R,R1>* a)
+    {
+      for(int ssite=lo; ssite < hi; ++ssite) {
+	int site = a->tab[ssite];
+	PrimitiveClovTriang<R>& t = a->tri[site];
+	const PrimitiveClovTriang<R1>& f = a->from[site];
+
+	for(int block=0; block < 2; block++) { 
+	  for(int i=0; i < 2*Nc; i++) { 
+	    t.diag[block][i].elem() = f.diag[block][i].elem();
+	  }
+	  for(int i=0; i < 2*Nc*Nc-Nc; i++) { 
+	    t.offd[block][i].real() = f.offd[block][i].real();
+	    t.offd[block][i].imag() = f.offd[block][i].imag();
+	  }
+	}
+      }
+    }
+  }
+
+
   // Now copy
   template<typename T, typename U>
   void QDPCloverTermT<T,U>::create(Handle< FermState<T,multi1d<U>,multi1d<U> > > fs,
@@ -183,6 +237,12 @@ namespace Chroma
       param.clovCoeffR *= Real(0.5) * ff;
       param.clovCoeffT *= Real(0.5);
     }
+
+    // The copy is only the clover term of these params if from was built with them
+    if (! sameCloverTermParams(param, from.param)) {
+      QDPIO::cerr << "QDPCloverTerm: error: copying a clover term built with other parameters" << endl;
+      QDP_abort(1);
+    }
     
     //
     // Yuk. Some bits of knowledge of the dslash term are buried in the 
@@ -208,7 +268,65 @@ namespace Chroma
     
     tr_log_diag_ = from.tr_log_diag_;
     
-    tri = from.tri;
+    tri.resize(Layout::sitesOnNode());
+    NumaAffinityEnv::firstTouch(tri);  // on the threads that apply it
+    for(int cb=0; cb < rb.numSubsets(); ++cb) {
+      QDPCloverEnv::ConvertTriArgs<REALT,REALT> arg = {tri, from.tri, rb[cb].siteTable()};
+      dispatch_to_threads(rb[cb].numSiteTable(), arg, QDPCloverEnv::convertTriSiteLoop<REALT,REALT>);
+    }
+    END_CODE();  
+#endif
+  }
+
+
+  // Now copy, converting the precision
+  template<typename T, typename U>
+  template<typename T1, typename U1>
+  void QDPCloverTermT<T,U>::create(Handle< FermState<T,multi1d<U>,multi1d<U> > > fs,
+				   const CloverFermActParams& param_,
+				   const QDPCloverTermT<T1,U1>& from)
+  {
+#ifndef QDP_IS_QDPJIT
+    START_CODE();
+    u.resize(Nd);
+
+    u = fs->getLinks();
+    fbc = fs->getFermBC();
+    param = param_;
+    
+    // Sanity check
+    if (fbc.operator->() == 0) {
+      QDPIO::cerr << "QDPCloverTerm: error: fbc is null" << endl;
+      QDP_abort(1);
+    }
+    
+    {
+      RealT ff = where(param.anisoParam.anisoP, Real(1) / param.anisoParam.xi_0, Real(1));
+      param.clovCoeffR *= Real(0.5) * ff;
+      param.clovCoeffT *= Real(0.5);
+    }
+
+    // The copy is only the clover term of these params if from was built with them
+    if (! sameCloverTermParams(param, from.param)) {
+      QDPIO::cerr << "QDPCloverTerm: error: converting a clover term built with other parameters" << endl;
+      QDP_abort(1);
+    }
+
+    choles_done.resize(rb.numSubsets());
+    for(int i=0; i < rb.numSubsets(); i++) {
+      choles_done[i] = from.choles_done[i];
+    }
+    
+    tr_log_diag_ = from.tr_log_diag_;
+
+    tri.resize(Layout::sitesOnNode());
+    NumaAffinityEnv::firstTouch(tri);  // on the threads that apply it
+    typedef typename WordType<T1>::Type_t REALT1;
+    for(int cb=0; cb < rb.numSubsets(); ++cb) {
+      QDPCloverEnv::ConvertTriArgs<REALT,REALT1> arg = {tri, from.tri, rb[cb].siteTable()};
+      dispatch_to_threads(rb[cb].numSiteTable(), arg, QDPCloverEnv::convertTriSiteLoop<REALT,REALT1>);
+    }
+
     END_CODE();  
 #endif
   }
@@ -520,9 +638,11 @@ namespace Chroma
     const int nodeSites = QDP::Layout::sitesOnNode();
 
     tri.resize(nodeSites);  // hold local lattice
+    NumaAffinityEnv::firstTouch(tri);  // on the threads that apply it
 
     QDPCloverEnv::QDPCloverMakeClovArg<U> arg = {diag_mass, f0,f1,f2,f3,f4,f5,tri };
-    dispatch_to_threads(nodeSites, arg, QDPCloverEnv::makeClovSiteLoop<U>);
+    tunedDispatchToThreads(QDPCloverEnv::tuneName<REALT>("clover_make"),
+			   nodeSites, arg, QDPCloverEnv::makeClovSiteLoop<U>);
               
 
     END_CODE();
@@ -811,7 +931,8 @@ namespace Chroma
     tr_log_diag = zero;
 
     QDPCloverEnv::LDagDLInvArgs<U> a = { tr_log_diag, tri, cb };
-    dispatch_to_threads(rb[cb].numSiteTable(), a, QDPCloverEnv::LDagDLInvSiteLoop<U>);
+    tunedDispatchToThreads(QDPCloverEnv::tuneName<REALT>("clover_ldagdlinv"),
+			   rb[cb].numSiteTable(), a, QDPCloverEnv::LDagDLInvSiteLoop<U>);
 
     
     // This comes from the days when we used to do Cholesky
@@ -1002,7 +1123,8 @@ namespace Chroma
   
     tr_log_diag = zero;
     QDPCloverEnv::LDagDLInvArgs<U> a = { tr_log_diag, tri, cb};
-    dispatch_to_threads(rb[cb].numSiteTable(), a, QDPCloverEnv::cholesSiteLoop<U>);
+    tunedDispatchToThreads(QDPCloverEnv::tuneName<REALT>("clover_choles"),
+			   rb[cb].numSiteTable(), a, QDPCloverEnv::cholesSiteLoop<U>);
     
     choles_done[cb] = true;
     END_CODE();
@@ -1489,8 +1611,8 @@ namespace Chroma
     }
 
     QDPCloverEnv::TriaCntrArgs<U> a = { B, tri, mat, cb };
-    dispatch_to_threads(rb[cb].numSiteTable(), a, 
-			QDPCloverEnv::triaCntrSiteLoop<U>);
+    tunedDispatchToThreads(QDPCloverEnv::tuneName<REALT>("clover_triacntr"),
+			   rb[cb].numSiteTable(), a, QDPCloverEnv::triaCntrSiteLoop<U>);
 
     END_CODE();
 #endif
@@ -2105,7 +2227,8 @@ namespace Chroma
 
     // The dispatch function is at the end of the file
     // ought to work for non-threaded targets too...
-    dispatch_to_threads(num_sites, arg, QDPCloverEnv::applySiteLoop<T>);
+    tunedDispatchToThreads(QDPCloverEnv::tuneName<REALT>("clover_apply"),
+			   num_sites, arg, QDPCloverEnv::applySiteLoop<T>);
     (*this).getFermBC().modifyF(chi, QDP::rb[cb]);
 
     END_CODE();
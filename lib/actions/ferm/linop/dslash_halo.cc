@@ -0,0 +1,308 @@
+/*! \file
+ *  \brief Halo exchange of the neighbours of a nearest and next-to-nearest dslash
+ */
+
+#include "chromabase.h"
+#include "actions/ferm/linop/dslash_halo.h"
+
+#include <algorithm>
+#include <utility>
+
+namespace Chroma
+{
+
+  namespace
+  {
+    //! Coordinates of the site displaced by dist along mu
+    multi1d<int> hopCoords(const multi1d<int>& coord, int mu, int dist)
+    {
+      const multi1d<int>& latt_size = Layout::lattSize();
+
+      multi1d<int> c = coord;
+      c[mu] = ((c[mu] + dist) % latt_size[mu] + latt_size[mu]) % latt_size[mu];
+
+      return c;
+    }
+
+    //! A site of a message, keyed by the partner node and the rank of the sending site
+    typedef std::pair< std::pair<int,int>, int >  Slot_t;
+
+    //! Sort the slots of a hop and copy their sites out
+    void sortedValues(std::vector<Slot_t>& v, multi1d<int>& out)
+    {
+      std::sort(v.begin(), v.end());
+
+      out.resize(v.size());
+      for(int k=0; k < v.size(); ++k)
+	out[k] = v[k].second;
+    }
+
+    //! Partner nodes and their number of sites, of the sorted slots of a hop
+    std::vector< std::pair<int,int> > partners(const std::vector<Slot_t>& v)
+    {
+      std::vector< std::pair<int,int> > p;
+      for(int k=0; k < v.size(); ++k)
+      {
+	if (p.empty() || p.back().first != v[k].first.first)
+	  p.push_back(std::make_pair(v[k].first.first, 0));
+	++(p.back().second);
+      }
+      return p;
+    }
+  }
+
+
+  // Build the site tables and messages for sites of site_bytes
+  void DslashHalo::create(size_t site_bytes_, const multi1d<int>& dists_)
+  {
+    START_CODE();
+
+    free();
+    site_bytes = site_bytes_;
+    dists = dists_;
+
+    for(int d=0; d < dists.size(); ++d)
+    {
+      if (dists[d] % 2 == 0)
+      {
+	QDPIO::cerr << "DslashHalo: hop distance " << dists[d]
+		    << " does not connect the checkerboards" << endl;
+	QDP_abort(1);
+      }
+    }
+
+    const int me = Layout::nodeNumber();
+    const int nodeSites = Layout::sitesOnNode();
+    const multi1d<int>& latt_size = Layout::lattSize();
+    const int nhops = 2*Nd*dists.size();
+
+    nbr.resize(nhops);
+    for(int h=0; h < nhops; ++h)
+      nbr[h].resize(nodeSites);
+
+    // Partner nodes of each hop and the sites exchanged with each
+    std::vector< std::vector< std::pair<int,int> > > send_part[2];
+    std::vector< std::vector< std::pair<int,int> > > recv_part[2];
+
+    for(int cb=0; cb < 2; ++cb)
+    {
+      const int* tab = rb[cb].siteTable().slice();
+      const int num = rb[cb].numSiteTable();
+
+      std::vector<int> in_sites;
+      std::vector<int> face_sites;
+
+      send_part[cb].resize(nhops);
+      recv_part[cb].resize(nhops);
+
+      // Receive slots, ranked by the sending node and site
+      std::vector< std::vector<Slot_t> > recv(nhops);
+
+      for(int j=0; j < num; ++j)
+      {
+	int x = tab[j];
+	multi1d<int> coord = Layout::siteCoords(me, x);
+	bool interior = true;
+
+	for(int d=0; d < dists.size(); ++d)
+	  for(int mu=0; mu < Nd; ++mu)
+	    for(int back=0; back < 2; ++back)
+	    {
+	      int h = hop(mu, d, back);
+	      multi1d<int> yc = hopCoords(coord, mu, back ? -dists[d] : dists[d]);
+	      int node = Layout::nodeNumber(yc);
+
+	      if (node == me)
+		nbr[h][x] = Layout::linearSiteIndex(yc);
+	      else
+	      {
+		recv[h].push_back(std::make_pair(std::make_pair(node, local_site(yc, latt_size)), x));
+		interior = false;
+	      }
+	    }
+
+	if (interior)
+	  in_sites.push_back(x);
+	else
+	  face_sites.push_back(x);
+      }
+
+      for(int h=0; h < nhops; ++h)
+      {
+	std::sort(recv[h].begin(), recv[h].end());
+	for(int k=0; k < recv[h].size(); ++k)
+	  nbr[h][recv[h][k].second] = -1 - k;
+	recv_part[cb][h] = partners(recv[h]);
+      }
+
+      inner[cb].resize(in_sites.size());
+      for(int k=0; k < in_sites.size(); ++k)
+	inner[cb][k] = in_sites[k];
+
+      face[cb].resize(face_sites.size());
+      for(int k=0; k < face_sites.size(); ++k)
+	face[cb][k] = face_sites[k];
+
+      // Sites of the other checkerboard whose receiver across hop h is off node
+      const int* otab = rb[1-cb].siteTable().slice();
+      const int onum = rb[1-cb].numSiteTable();
+
+      std::vector< std::vector<Slot_t> > send(nhops);
+
+      for(int j=0; j < onum; ++j)
+      {
+	int y = otab[j];
+	multi1d<int> coord = Layout::siteCoords(me, y);
+	int lex = local_site(coord, latt_size);
+
+	for(int d=0; d < dists.size(); ++d)
+	  for(int mu=0; mu < Nd; ++mu)
+	    for(int back=0; back < 2; ++back)
+	    {
+	      // The receiver of y across a hop sits across the opposite hop
+	      int h = hop(mu, d, back);
+	      multi1d<int> xc = hopCoords(coord, mu, back ? dists[d] : -dists[d]);
+	      int node = Layout::nodeNumber(xc);
+
+	      if (node != me)
+		send[h].push_back(std::make_pair(std::make_pair(node, lex), y));
+	    }
+      }
+
+      send_sites[cb].resize(nhops);
+      send_buf[cb].resize(nhops);
+      recv_buf[cb].resize(nhops);
+
+      for(int h=0; h < nhops; ++h)
+      {
+	if (send[h].size() != recv[h].size())
+	{
+	  QDPIO::cerr << "DslashHalo: hop " << h << " sends " << send[h].size()
+		      << " sites but receives " << recv[h].size() << endl;
+	  QDP_abort(1);
+	}
+
+	sortedValues(send[h], send_sites[cb][h]);
+	send_part[cb][h] = partners(send[h]);
+
+	send_buf[cb][h].resize(std::max(size_t(1), send[h].size()*site_bytes));
+	recv_buf[cb][h].resize(std::max(size_t(1), recv[h].size()*site_bytes));
+      }
+    }
+
+#if defined(ARCH_PARSCALAR)
+    for(int cb=0; cb < 2; ++cb)
+    {
+      msg[cb].resize(nhops);
+      mh[cb].resize(nhops);
+
+      for(int h=0; h < nhops; ++h)
+      {
+	if (! hasComms(cb, h))
+	  continue;
+
+	// A message to and from each partner, at its place in the buffers.
+	// A hop longer than the extent of a node has several partners.
+	std::vector<QMP_msghandle_t> mh_a;
+	size_t off = 0;
+	for(int p=0; p < recv_part[cb][h].size(); ++p)
+	{
+	  const size_t nbytes = recv_part[cb][h][p].second*site_bytes;
+	  QMP_msgmem_t m = QMP_declare_msgmem(&(recv_buf[cb][h][off]), nbytes);
+	  msg[cb][h].push_back(m);
+	  mh_a.push_back(QMP_declare_receive_from(m, recv_part[cb][h][p].first, 0));
+	  off += nbytes;
+	}
+
+	off = 0;
+	for(int p=0; p < send_part[cb][h].size(); ++p)
+	{
+	  const size_t nbytes = send_part[cb][h][p].second*site_bytes;
+	  QMP_msgmem_t m = QMP_declare_msgmem(&(send_buf[cb][h][off]), nbytes);
+	  msg[cb][h].push_back(m);
+	  mh_a.push_back(QMP_declare_send_to(m, send_part[cb][h][p].first, 0));
+	  off += nbytes;
+	}
+
+	mh[cb][h] = QMP_declare_multiple(&(mh_a[0]), mh_a.size());
+
+	if (mh[cb][h] == (QMP_msghandle_t)NULL)
+	{
+	  QDPIO::cerr << "DslashHalo: failed to declare the messages of hop "
+		      << h << endl;
+	  QDP_abort(1);
+	}
+      }
+    }
+#else
+    for(int cb=0; cb < 2; ++cb)
+      for(int h=0; h < nhops; ++h)
+	if (hasComms(cb, h))
+	{
+	  QDPIO::cerr << "DslashHalo: off node neighbours without comms" << endl;
+	  QDP_abort(1);
+	}
+#endif
+
+    END_CODE();
+  }
+
+
+  // Post the receive and send of hop h onto rb[cb]
+  void DslashHalo::start(int cb, int h) const
+  {
+#if defined(ARCH_PARSCALAR)
+    QMP_status_t err;
+    if ((err = QMP_start(mh[cb][h])) != QMP_SUCCESS)
+      QDP_error_exit(QMP_error_string(err));
+#endif
+  }
+
+
+  // Wait for all messages onto rb[cb]
+  void DslashHalo::wait(int cb) const
+  {
+#if defined(ARCH_PARSCALAR)
+    QMP_status_t err;
+    for(int h=0; h < numHops(); ++h)
+      if (hasComms(cb, h))
+	if ((err = QMP_wait(mh[cb][h])) != QMP_SUCCESS)
+	  QDP_error_exit(QMP_error_string(err));
+#endif
+  }
+
+
+  // Release the messages
+  void DslashHalo::free()
+  {
+#if defined(ARCH_PARSCALAR)
+    for(int cb=0; cb < 2; ++cb)
+      for(int h=0; h < send_sites[cb].size(); ++h)
+	if (hasComms(cb, h))
+	{
+	  QMP_free_msghandle(mh[cb][h]);
+	  for(int m=0; m < msg[cb][h].size(); ++m)
+	    QMP_free_msgmem(msg[cb][h][m]);
+	}
+#endif
+
+    for(int cb=0; cb < 2; ++cb)
+    {
+#if defined(ARCH_PARSCALAR)
+      msg[cb].clear();
+      mh[cb].clear();
+#endif
+      send_sites[cb].clear();
+      send_buf[cb].clear();
+      recv_buf[cb].clear();
+    }
+    nbr.clear();
+  }
+
+
+  DslashHalo::~DslashHalo()
+  {
+    free();
+  }
+
+}  // end namespace Chroma
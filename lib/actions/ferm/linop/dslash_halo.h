@@ -0,0 +1,108 @@
+// -*- C++ -*-
+/*! \file
+ *  \brief Halo exchange of the neighbours of a nearest and next-to-nearest dslash
+ */
+
+#ifndef __dslash_halo_h__
+#define __dslash_halo_h__
+
+#include "chromabase.h"
+
+#include <vector>
+
+#if defined(ARCH_PARSCALAR)
+#include <qmp.h>
+#endif
+
+namespace Chroma
+{
+  //! Halo exchange of the neighbours of a dslash
+  /*!
+   * \ingroup linop
+   *
+   * The hops are the displacements by +dist and -dist along each mu for
+   * each of the distances given to create. Hop h = hop(mu, d, 0) takes
+   * psi(x + dists[d] mu) onto x and h = hop(mu, d, 1) takes
+   * psi(x - dists[d] mu). The distances must be odd, so every hop
+   * connects the two checkerboards.
+   *
+   * For each hop a site of the node either has its neighbour on the node,
+   * or a slot in the receive buffer of the hop for the checkerboard of the
+   * site. Slots are ordered by the sending node and then by the
+   * lexicographic rank of the sending site, which both sides can compute.
+   * A hop longer than the extent of a node, such as the third neighbour
+   * on a node two sites wide, reaches several nodes and has a message for
+   * each. The messages of all hops are declared once and posted together,
+   * so one round of communication fills the whole halo.
+   */
+  class DslashHalo
+  {
+  public:
+    //! Empty halo. Must use create later
+    DslashHalo() : site_bytes(0) {}
+
+    //! Releases the message buffers
+    ~DslashHalo();
+
+    //! Build the site tables and messages for sites of site_bytes
+    void create(size_t site_bytes_, const multi1d<int>& dists_);
+
+    //! Number of hops
+    int numHops() const {return nbr.size();}
+
+    //! Index of the hop along mu by dists[d], backward if back
+    static int hop(int mu, int d, int back) {return 2*(Nd*d + mu) + back;}
+
+    //! Sites of rb[cb] with all their neighbours on this node
+    const multi1d<int>& innerSites(int cb) const {return inner[cb];}
+
+    //! Sites of rb[cb] with some neighbour on another node
+    const multi1d<int>& faceSites(int cb) const {return face[cb];}
+
+    //! Neighbour of a site across hop h
+    /*! The site on this node, or -1-k for slot k of the receive buffer */
+    int neighbour(int h, int site) const {return nbr[h][site];}
+
+    //! Is there a message for hop h onto rb[cb]?
+    bool hasComms(int cb, int h) const {return send_sites[cb][h].size() > 0;}
+
+    //! Sites of the other checkerboard sent for hop h onto rb[cb]
+    const multi1d<int>& sendSites(int cb, int h) const {return send_sites[cb][h];}
+
+    //! Send buffer for hop h onto rb[cb]
+    char* sendBuf(int cb, int h) const {return const_cast<char*>(&(send_buf[cb][h][0]));}
+
+    //! Receive buffer for hop h onto rb[cb]
+    const char* recvBuf(int cb, int h) const {return &(recv_buf[cb][h][0]);}
+
+    //! Post the receive and send of hop h onto rb[cb]
+    void start(int cb, int h) const;
+
+    //! Wait for all messages onto rb[cb]
+    void wait(int cb) const;
+
+  private:
+    //! Hide copies, the messages are owned
+    DslashHalo(const DslashHalo&) {}
+    void operator=(const DslashHalo&) {}
+
+    void free();
+
+    size_t                              site_bytes;
+    multi1d<int>                        dists;
+    multi1d<int>                        inner[2];
+    multi1d<int>                        face[2];
+    std::vector< multi1d<int> >         nbr;
+    std::vector< multi1d<int> >         send_sites[2];
+    std::vector< std::vector<char> >    send_buf[2];
+    std::vector< std::vector<char> >    recv_buf[2];
+
+#if defined(ARCH_PARSCALAR)
+    std::vector< std::vector<QMP_msgmem_t> >  msg[2];   /*!< receive and send memories of each hop */
+    std::vector<QMP_msghandle_t>        mh[2];
+#endif
+  };
+
+}  // end namespace Chroma
+
+#endif
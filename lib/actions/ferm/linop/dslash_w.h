@@ -79,6 +79,18 @@ namespace Chroma {
 
 }  // end namespace Chroma
 
+#elif defined BUILD_OVERLAP_WILSON_DSLASH
+// The QDP dslash with the halo exchange overlapped with the interior sites
+
+# include "lwldslash_overlap_w.h"
+namespace Chroma {
+
+  typedef QDPWilsonDslashOverlap WilsonDslash;
+  typedef QDPWilsonDslashOverlapF WilsonDslashF;
+  typedef QDPWilsonDslashOverlapD WilsonDslashD;
+
+}  // end namespace Chroma
+
 // Many #elif clauses could come in here for other opotimised Dslash-es
 #elif defined BUILD_PAB_WILSON_DSLASH
 # include "lwldslash_w_pab.h"
@@ -13,11 +13,48 @@
 #include "actions/ferm/fermacts/clover_fermact_params_w.h"
 #include "actions/ferm/linop/dslash_w.h"
 #include "actions/ferm/linop/clover_term_w.h"
+#include "actions/ferm/linop/eoprec_clover_linop_w.h"
 
 
 namespace Chroma 
 { 
 
+  //! Copy a clover term and its inverse into another precision
+  /*!
+   * \ingroup linop
+   *
+   * Only QDP clover terms can be converted. Returns false for other
+   * implementations, which must then be rebuilt from the links.
+   */
+  template<typename C, typename S, typename C1>
+  bool copyCloverTerm(C& to, S fs, const CloverFermActParams& param, const C1& from)
+  {
+    return false;
+  }
+
+#if ! defined(BUILD_JIT_CLOVER_TERM)
+  //! Copy a QDP clover term and its inverse into another precision
+  /*! \ingroup linop */
+  template<typename T, typename U, typename T1, typename U1>
+  bool copyCloverTerm(QDPCloverTermT<T,U>& to, 
+		      Handle< FermState<T, multi1d<U>, multi1d<U> > > fs, 
+		      const CloverFermActParams& param, 
+		      const QDPCloverTermT<T1,U1>& from)
+  {
+    to.create(fs, param, from);
+    return true;
+  }
+#endif
+
+
+  //! The clover operator behind a handle, if wanted and if it is one
+  /*! \ingroup linop */
+  inline const EvenOddPrecCloverLinOp* 
+  cloverLinOpFrom(bool wanted, const Handle< LinearOperator<LatticeFermion> >& A)
+  {
+    return wanted ? dynamic_cast<const EvenOddPrecCloverLinOp*>(A.operator->()) : 0;
+  }
+
 #if 1 
   //! Even-odd preconditioned Clover-Dirac operator
   /*!
@@ -45,6 +82,12 @@ namespace Chroma
 				const CloverFermActParams& param_)
       {create(fs,param_);}
 
+    //! Constructor taking the clover terms from a full precision operator
+    EvenOddPrecDumbCloverFLinOp(Handle< FermState<LatticeFermionF,P,Q> > fs,
+				const CloverFermActParams& param_,
+				const EvenOddPrecCloverLinOp& from)
+      {create(fs,param_,from);}
+
     //! Destructor is automatic
     ~EvenOddPrecDumbCloverFLinOp() {}
 
@@ -63,6 +106,32 @@ namespace Chroma
       
     }
 
+    //! Creation routine taking the clover terms from a full precision operator
+    /*!
+     * The clover term and its inverse are converted from those of from
+     * instead of rebuilding and refactoring them. If from was built with
+     * other clover parameters they are rebuilt from the links.
+     */
+    void create(Handle< FermState<LatticeFermionF,P,Q> > fs,
+		const CloverFermActParams& param_,
+		const EvenOddPrecCloverLinOp& from) {
+
+      param = param_;
+      if (! sameCloverTermParams(param, from.getParam()))
+	QDPIO::cout << "Clover parameters differ from those of the operator - rebuilding the clover term" << endl;
+
+      if (! (sameCloverTermParams(param, from.getParam()) &&
+	     copyCloverTerm(clov, fs, param, from.getClov()) && 
+	     copyCloverTerm(invclov, fs, param, from.getInvClov())))
+      {
+	clov.create(fs, param);
+	invclov.create(fs,param,clov);  // make a copy
+	invclov.choles(0);  // invert the cb=0 part
+      }
+      D.create(fs, param.anisoParam);
+      
+    }
+
 
     // Override inherited one with a few more funkies
     void operator()(LatticeFermionF& chi, const LatticeFermionF& psi, 
@@ -154,6 +223,12 @@ namespace Chroma
 				const CloverFermActParams& param_)
       {create(fs,param_);}
 
+    //! Constructor taking the clover terms from a full precision operator
+    EvenOddPrecDumbCloverDLinOp(Handle< FermState<T,P,Q> > fs,
+				const CloverFermActParams& param_,
+				const EvenOddPrecCloverLinOp& from)
+      {create(fs,param_,from);}
+
     //! Destructor is automatic
     ~EvenOddPrecDumbCloverDLinOp() {}
 
@@ -178,6 +253,34 @@ namespace Chroma
       
     }
 
+    //! Creation routine taking the clover terms from a full precision operator
+    /*!
+     * The clover term and its inverse are converted from those of from
+     * instead of rebuilding and refactoring them. If from was built with
+     * other clover parameters they are rebuilt from the links.
+     */
+    void create(Handle< FermState<T,P,Q> > fs,
+		const CloverFermActParams& param_,
+		const EvenOddPrecCloverLinOp& from) {
+      START_CODE();
+
+      param = param_;
+      if (! sameCloverTermParams(param, from.getParam()))
+	QDPIO::cout << "Clover parameters differ from those of the operator - rebuilding the clover term" << endl;
+
+      if (! (sameCloverTermParams(param, from.getParam()) &&
+	     copyCloverTerm(clov, fs, param, from.getClov()) && 
+	     copyCloverTerm(invclov, fs, param, from.getInvClov())))
+      {
+	clov.create(fs, param);
+	invclov.create(fs,param,clov);  // make a copy
+	invclov.choles(0);  // invert the cb=0 part
+      }
+      D.create(fs, param.anisoParam);
+
+      END_CODE();
+    }
+
  
     // Override inherited one with a few more funkies
     void operator()(T& chi, const T& psi, 
@@ -134,25 +134,108 @@ namespace Chroma
   }
 
 
-  //! Apply even-odd preconditioned Clover fermion linear operator
+#ifndef QDP_IS_QDPJIT
+  //! Site kernels of the fused Schur complement
+  namespace EvenOddPrecCloverLinOpEnv
+  {
+    namespace
+    {
+      typedef WordType<LatticeFermion>::Type_t  REALT;
+
+      //! y(site) = a*y(site) + x(site) on the words of a site
+      inline void axpySite(LatticeFermion& y, int site, REALT a, const LatticeFermion& x)
+      {
+	const int nw = sizeof(LatticeFermion::Subtype_t) / sizeof(REALT);
+	REALT* yy = (REALT *)&(y.elem(site));
+	const REALT* xx = (const REALT *)&(x.elem(site));
+
+	for(int k=0; k < nw; ++k)
+	  yy[k] = a*yy[k] + xx[k];
+      }
+
+      //! y(site) *= a on the words of a site
+      inline void scaleSite(LatticeFermion& y, int site, REALT a)
+      {
+	const int nw = sizeof(LatticeFermion::Subtype_t) / sizeof(REALT);
+	REALT* yy = (REALT *)&(y.elem(site));
+
+	for(int k=0; k < nw; ++k)
+	  yy[k] *= a;
+      }
+    }
+
+    struct CloverArgs
+    {
+      const CloverTerm&        clov;
+      LatticeFermion&          chi;
+      const LatticeFermion&    psi;
+      const LatticeFermion*    acc;    /*!< added to the scaled result if not null */
+      REALT                    scale;
+      enum PlusMinus           isign;
+      const multi1d<int>&      sites;
+    };
+
+    //! chi = scale * A psi (+ acc), each site finished while in cache
+    void cloverSiteLoop(int lo, int hi, int myId, CloverArgs* a)
+    {
+      for(int ss=lo; ss < hi; ++ss)
+      {
+	int site = a->sites[ss];
+	a->clov.applySite(a->chi, a->psi, a->isign, site);
+
+	if (a->acc == 0)
+	  scaleSite(a->chi, site, a->scale);
+	else
+	  axpySite(a->chi, site, a->scale, *(a->acc));
+      }
+    }
+  }
+#endif
+
+
+  //! The Schur complement with caller supplied temporaries
   /*!
-   * \param chi 	  Pseudofermion field     	       (Write)
-   * \param psi 	  Pseudofermion field     	       (Read)
-   * \param isign   Flag ( PLUS | MINUS )   	       (Read)
+   * The clover stages run as site kernels that apply the clover block and
+   * finish the site in cache: the inverse on the even sites is scaled by
+   * -1/4 in place, and on the odd sites A psi is combined with the hop so
+   * chi is written once. The two hops remain whole dslash applications.
    */
-  void EvenOddPrecCloverLinOp::operator()(LatticeFermion & chi, 
+  void EvenOddPrecCloverLinOp::schurApply(LatticeFermion& chi, 
 					  const LatticeFermion& psi, 
-					  enum PlusMinus isign) const
+					  enum PlusMinus isign,
+					  LatticeFermion& tmp1, LatticeFermion& tmp2) const
   {
     START_CODE();
 
-    LatticeFermion tmp1; moveToFastMemoryHint(tmp1);
-    LatticeFermion tmp2; moveToFastMemoryHint(tmp2);
-    Real mquarter = -0.25;
+#ifndef QDP_IS_QDPJIT
+    using namespace EvenOddPrecCloverLinOpEnv;
 
+    //  tmp2_e  =  -1/4 A^(-1)_ee  D_eo  psi_o
+    D.apply(tmp1, psi, isign, 0);
+
+    swatch.reset(); swatch.start();
+    {
+      CloverArgs a = {invclov, tmp2, tmp1, 0, REALT(-0.25), isign, rb[0].siteTable()};
+      dispatch_to_threads(rb[0].numSiteTable(), a, cloverSiteLoop);
+      invclov.getFermBC().modifyF(tmp2, rb[0]);
+    }
+    swatch.stop();
+    clov_apply_time += swatch.getTimeInSeconds();
+
+    //  chi_o  =  A_oo  psi_o  +  D_oe tmp2_e
+    D.apply(tmp1, tmp2, isign, 1);
+
+    swatch.reset(); swatch.start();
+    {
+      CloverArgs a = {clov, chi, psi, &tmp1, REALT(1), isign, rb[1].siteTable()};
+      dispatch_to_threads(rb[1].numSiteTable(), a, cloverSiteLoop);
+      clov.getFermBC().modifyF(chi, rb[1]);
+    }
+    swatch.stop();
+    clov_apply_time += swatch.getTimeInSeconds();
+#else
+    Real mquarter = -0.25;
 
-    
-  
     //  tmp1_o  =  D_oe   A^(-1)_ee  D_eo  psi_o
     D.apply(tmp1, psi, isign, 0);
 
@@ -170,6 +253,7 @@ namespace Chroma
     clov_apply_time += swatch.getTimeInSeconds();
 
     chi[rb[1]] += mquarter*tmp1;
+#endif
 
     // Twisted Term?
     if( param.twisted_m_usedP ){ 
@@ -188,6 +272,48 @@ namespace Chroma
   }
 
 
+  //! Apply even-odd preconditioned Clover fermion linear operator
+  /*!
+   * \param chi 	  Pseudofermion field     	       (Write)
+   * \param psi 	  Pseudofermion field     	       (Read)
+   * \param isign   Flag ( PLUS | MINUS )   	       (Read)
+   */
+  void EvenOddPrecCloverLinOp::operator()(LatticeFermion & chi, 
+					  const LatticeFermion& psi, 
+					  enum PlusMinus isign) const
+  {
+    START_CODE();
+
+    LatticeFermion tmp1; moveToFastMemoryHint(tmp1);
+    LatticeFermion tmp2; moveToFastMemoryHint(tmp2);
+
+    schurApply(chi, psi, isign, tmp1, tmp2);
+
+    END_CODE();
+  }
+
+
+  //! Apply M^dag M, sharing the temporaries of both applications
+  /*!
+   * \param chi 	  Pseudofermion field     	       (Write)
+   * \param psi 	  Pseudofermion field     	       (Read)
+   */
+  void EvenOddPrecCloverLinOp::MdagM(LatticeFermion& chi, 
+				     const LatticeFermion& psi) const
+  {
+    START_CODE();
+
+    LatticeFermion tmp1; moveToFastMemoryHint(tmp1);
+    LatticeFermion tmp2; moveToFastMemoryHint(tmp2);
+    LatticeFermion mpsi; moveToFastMemoryHint(mpsi);
+
+    schurApply(mpsi, psi, PLUS, tmp1, tmp2);
+    schurApply(chi, mpsi, MINUS, tmp1, tmp2);
+
+    END_CODE();
+  }
+
+
   //! Apply the even-even block onto a source vector
   void 
   EvenOddPrecCloverLinOp::derivEvenEvenLinOp(multi1d<LatticeColorMatrix>& ds_u, 
@@ -248,6 +374,21 @@ namespace Chroma
     END_CODE();
   }
  
+  //! Apply the the even-odd block onto a set of source vectors
+  void 
+  EvenOddPrecCloverLinOp::derivEvenOddLinOpMP(multi1d<LatticeColorMatrix>& ds_u, 
+					      const multi1d<LatticeFermion>& chi, const multi1d<LatticeFermion>& psi, 
+					      enum PlusMinus isign) const
+  {
+    START_CODE();
+    ds_u.resize(Nd);
+    D.derivMultipole(ds_u, chi, psi, isign, 0);
+    for(int mu=0; mu < Nd; mu++) { 
+      ds_u[mu]  *= Real(-0.5);
+    }
+    END_CODE();
+  }
+ 
   //! Apply the the odd-even block onto a source vector
   void 
   EvenOddPrecCloverLinOp::derivOddEvenLinOp(multi1d<LatticeColorMatrix>& ds_u, 
@@ -264,6 +405,21 @@ namespace Chroma
     END_CODE();
   }
 
+  //! Apply the the odd-even block onto a set of source vectors
+  void 
+  EvenOddPrecCloverLinOp::derivOddEvenLinOpMP(multi1d<LatticeColorMatrix>& ds_u, 
+					      const multi1d<LatticeFermion>& chi, const multi1d<LatticeFermion>& psi, 
+					      enum PlusMinus isign) const
+  {
+    START_CODE();
+    ds_u.resize(Nd);
+    D.derivMultipole(ds_u, chi, psi, isign, 1);
+    for(int mu=0; mu < Nd; mu++) { 
+      ds_u[mu]  *= Real(-0.5);
+    }
+    END_CODE();
+  }
+
   // Inherit this
   //! Apply the the odd-odd block onto a source vector
   void 
@@ -84,6 +84,14 @@ namespace Chroma
     void operator()(LatticeFermion& chi, const LatticeFermion& psi, 
 		    enum PlusMinus isign) const;
 
+    //! Apply M^dag M, sharing the temporaries of both applications
+    /*!
+     * The CG solvers need M psi on its own for their step length, so they
+     * still make two operator() calls; this serves callers that only want
+     * M^dag M psi.
+     */
+    void MdagM(LatticeFermion& chi, const LatticeFermion& psi) const;
+
     //! Apply the even-even block onto a source vector
     void derivEvenEvenLinOp(multi1d<LatticeColorMatrix>& ds_u, 
 			    const LatticeFermion& chi, const LatticeFermion& psi, 
@@ -102,11 +110,21 @@ namespace Chroma
 			   const LatticeFermion& chi, const LatticeFermion& psi, 
 			   enum PlusMinus isign) const;
  
+    //! Apply the the even-odd block onto a source vector
+    void derivEvenOddLinOpMP(multi1d<LatticeColorMatrix>& ds_u, 
+			     const multi1d<LatticeFermion>& chi, const multi1d<LatticeFermion>& psi, 
+			     enum PlusMinus isign) const;
+ 
     //! Apply the the odd-even block onto a source vector
     void derivOddEvenLinOp(multi1d<LatticeColorMatrix>& ds_u, 
 			   const LatticeFermion& chi, const LatticeFermion& psi, 
 			   enum PlusMinus isign) const;
 
+    //! Apply the the odd-even block onto a source vector
+    void derivOddEvenLinOpMP(multi1d<LatticeColorMatrix>& ds_u, 
+			     const multi1d<LatticeFermion>& chi, const multi1d<LatticeFermion>& psi, 
+			     enum PlusMinus isign) const;
+
     //! Apply the the odd-odd block onto a source vector
     void derivOddOddLinOp(multi1d<LatticeColorMatrix>& ds_u, 
 			  const LatticeFermion& chi, const LatticeFermion& psi, 
@@ -122,7 +140,21 @@ namespace Chroma
     //! Get the log det of the even even part
     Double logDetEvenEvenLinOp(void) const; 
 
+    //! The clover term
+    const CloverTerm& getClov() const {return clov;}
+
+    //! The clover term inverted on the even sites
+    const CloverTerm& getInvClov() const {return invclov;}
+
+    //! The parameters the clover terms were built with
+    const CloverFermActParams& getParam() const {return param;}
+
   private:
+    //! The Schur complement with caller supplied temporaries
+    void schurApply(LatticeFermion& chi, const LatticeFermion& psi, 
+		    enum PlusMinus isign,
+		    LatticeFermion& tmp1, LatticeFermion& tmp2) const;
+
     CloverFermActParams param;
     WilsonDslash D;
     CloverTerm   clov;
@@ -38,6 +38,111 @@ namespace Chroma
    */
 
 
+#if (QDP_NC == 2) || (QDP_NC == 3)
+  //! Site kernels of the fused array dslash
+  /*!
+   * The slices of the array are looped innermost at each site, so every
+   * link is read once per site and direction rather than once per slice.
+   */
+  namespace QDPWilsonDslashArrayOptEnv
+  {
+    namespace
+    {
+      typedef LatticeFermion::Subtype_t       FermSite_t;
+      typedef LatticeHalfFermion::Subtype_t   HalfSite_t;
+      typedef LatticeColorMatrix::Subtype_t   LinkSite_t;
+
+      //! Project with (1 + sign gamma_mu)
+      inline HalfSite_t projectSite(const FermSite_t& p, int mu, int sign)
+      {
+	HalfSite_t h;
+	switch (mu)
+	{
+	case 0: h = (sign > 0) ? spinProjectDir0Plus(p) : spinProjectDir0Minus(p); break;
+	case 1: h = (sign > 0) ? spinProjectDir1Plus(p) : spinProjectDir1Minus(p); break;
+	case 2: h = (sign > 0) ? spinProjectDir2Plus(p) : spinProjectDir2Minus(p); break;
+	case 3: h = (sign > 0) ? spinProjectDir3Plus(p) : spinProjectDir3Minus(p); break;
+	}
+	return h;
+      }
+
+      //! Reconstruct after a (1 + sign gamma_mu) projection
+      inline FermSite_t reconstructSite(const HalfSite_t& h, int mu, int sign)
+      {
+	FermSite_t p;
+	switch (mu)
+	{
+	case 0: p = (sign > 0) ? spinReconstructDir0Plus(h) : spinReconstructDir0Minus(h); break;
+	case 1: p = (sign > 0) ? spinReconstructDir1Plus(h) : spinReconstructDir1Minus(h); break;
+	case 2: p = (sign > 0) ? spinReconstructDir2Plus(h) : spinReconstructDir2Minus(h); break;
+	case 3: p = (sign > 0) ? spinReconstructDir3Plus(h) : spinReconstructDir3Minus(h); break;
+	}
+	return p;
+      }
+    }
+
+    struct HopBackArgs
+    {
+      const LatticeColorMatrix&        u;
+      const multi1d<LatticeFermion>&   psi;
+      multi1d<LatticeHalfFermion>&     h;      /*!< adj(u) times the projected psi */
+      int                              mu;
+      int                              sign;   /*!< projector (1 + sign gamma_mu) */
+      const multi1d<int>&              sites;
+    };
+
+    void hopBackSiteLoop(int lo, int hi, int myId, HopBackArgs* a)
+    {
+      const int N5 = a->psi.size();
+
+      for(int ss=lo; ss < hi; ++ss)
+      {
+	int site = a->sites[ss];
+	LinkSite_t ua = adj(a->u.elem(site));
+
+	for(int n=0; n < N5; ++n)
+	  a->h[n].elem(site) = ua * projectSite(a->psi[n].elem(site), a->mu, a->sign);
+      }
+    }
+
+    struct HopSumArgs
+    {
+      const LatticeColorMatrix&           u;
+      const multi1d<LatticeHalfFermion>&  fwd;    /*!< projected psi(x+mu) */
+      const multi1d<LatticeHalfFermion>&  bwd;    /*!< adj(u(x-mu)) times projected psi(x-mu) */
+      multi1d<LatticeFermion>&            chi;
+      int                                 mu;
+      int                                 sign;   /*!< forward projector (1 + sign gamma_mu) */
+      bool                                first;  /*!< overwrite rather than accumulate */
+      const multi1d<int>&                 sites;
+    };
+
+    void hopSumSiteLoop(int lo, int hi, int myId, HopSumArgs* a)
+    {
+      const int N5 = a->chi.size();
+
+      for(int ss=lo; ss < hi; ++ss)
+      {
+	int site = a->sites[ss];
+	const LinkSite_t& u = a->u.elem(site);
+
+	for(int n=0; n < N5; ++n)
+	{
+	  HalfSite_t uh = u * a->fwd[n].elem(site);
+	  FermSite_t r = reconstructSite(uh, a->mu, a->sign);
+	  r += reconstructSite(a->bwd[n].elem(site), a->mu, -a->sign);
+
+	  if (a->first)
+	    a->chi[n].elem(site) = r;
+	  else
+	    a->chi[n].elem(site) += r;
+	}
+      }
+    }
+  }
+#endif
+
+
   //! Creation routine
   void QDPWilsonDslashArrayOpt::create(Handle< FermState<T,P,Q> > state, int N5_)
   {
@@ -110,8 +215,76 @@ namespace Chroma
 
     if( chi.size() != N5 ) chi.resize(N5);
 
+#if (QDP_NC == 2) || (QDP_NC == 3)
+    using namespace QDPWilsonDslashArrayOptEnv;
+
+    int otherCB = (cb == 0 ? 1 : 0);
+
+    // Forward hops project with (1 - isign gamma), backward with (1 + isign gamma)
+    int fsign = (isign == PLUS) ? -1 : +1;
+
+    multi1d<LatticeHalfFermion> tmp(N5);
+    multi1d<LatticeHalfFermion> fwd(N5);
+    multi1d<LatticeHalfFermion> bwd(N5);
+    LatticeHalfFermion tmp1;
+
+    for(int mu=0; mu < Nd; ++mu)
+    {
+      // The forward neighbours need no link before the shift
+      for(int n=0; n < N5; ++n)
+      {
+	switch (mu)
+	{
+	case 0: 
+	  if (fsign > 0)
+	    tmp1[rb[otherCB]] = spinProjectDir0Plus(psi[n]);
+	  else
+	    tmp1[rb[otherCB]] = spinProjectDir0Minus(psi[n]);
+	  break;
+	case 1: 
+	  if (fsign > 0)
+	    tmp1[rb[otherCB]] = spinProjectDir1Plus(psi[n]);
+	  else
+	    tmp1[rb[otherCB]] = spinProjectDir1Minus(psi[n]);
+	  break;
+	case 2: 
+	  if (fsign > 0)
+	    tmp1[rb[otherCB]] = spinProjectDir2Plus(psi[n]);
+	  else
+	    tmp1[rb[otherCB]] = spinProjectDir2Minus(psi[n]);
+	  break;
+	case 3: 
+	  if (fsign > 0)
+	    tmp1[rb[otherCB]] = spinProjectDir3Plus(psi[n]);
+	  else
+	    tmp1[rb[otherCB]] = spinProjectDir3Minus(psi[n]);
+	  break;
+	}
+	fwd[n][rb[cb]] = shift(tmp1, FORWARD, mu);
+      }
+
+      // Multiply all slices of a site by its backward link at once
+      {
+	HopBackArgs a = {u[mu], psi, tmp, mu, -fsign, rb[otherCB].siteTable()};
+	dispatch_to_threads(rb[otherCB].numSiteTable(), a, hopBackSiteLoop);
+      }
+
+      for(int n=0; n < N5; ++n)
+	bwd[n][rb[cb]] = shift(tmp[n], BACKWARD, mu);
+
+      // Accumulate all slices of a site with one load of its forward link
+      {
+	HopSumArgs a = {u[mu], fwd, bwd, chi, mu, fsign, (mu == 0), rb[cb].siteTable()};
+	dispatch_to_threads(rb[cb].numSiteTable(), a, hopSumSiteLoop);
+      }
+    }
+
+    for(int n=0; n < N5; ++n)
+      getFermBC().modifyF(chi[n], QDP::rb[cb]);
+#else
     for(int n=0; n < N5; ++n)
       apply(chi[n], psi[n], isign, cb);
+#endif
 
     END_CODE();
   }
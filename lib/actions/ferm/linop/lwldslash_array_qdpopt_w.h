@@ -94,6 +94,9 @@ namespace Chroma
      * \param cb      Checkerboard of OUTPUT vector               (Read) 
      *
      * \return The output of applying dslash on psi
+     *
+     * The slices are fused, with the slice index looped innermost at
+     * each site so a link is read once per site for all N5 slices.
      */
     void apply (multi1d<LatticeFermion>& chi, 
 		const multi1d<LatticeFermion>& psi, 
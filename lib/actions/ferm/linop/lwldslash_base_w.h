@@ -77,6 +77,25 @@ namespace Chroma
 		       const T& chi, const T& psi, 
 		       enum PlusMinus isign, int cb) const ;
 
+    // Keep the whole lattice multipole deriv from the base
+    using DslashLinearOperator<T,P,Q>::derivMultipole;
+
+    //! Take deriv of D summed over several pairs of vectors
+    /*!
+     * \param chi     left vectors on cb                          (Read)
+     * \param psi     right vectors on 1-cb                       (Read)
+     * \param isign   D'^dag or D'  ( MINUS | PLUS ) resp.        (Read)
+     * \param cb      Checkerboard of chi vectors                 (Read)
+     *
+     * The spin traces of all the poles are accumulated in one sweep
+     * per direction, and the anisotropy weights and BCs are applied once.
+     *
+     * \return Computes   \f$\sum_i \chi_i^\dag * \dot(D} * \psi_i\f$
+     */
+    virtual void derivMultipole(P& ds_u, 
+				const multi1d<T>& chi, const multi1d<T>& psi, 
+				enum PlusMinus isign, int cb) const;
+
     //! Return flops performed by the operator()
     unsigned long nFlops() const;
 
@@ -228,6 +247,191 @@ namespace Chroma
   }
 
 
+#ifndef QDP_IS_QDPJIT
+  //! Site kernel of the multipole hopping derivative
+  namespace WilsonDslashBaseEnv
+  {
+    //! f = the full spinor of the projected h shifted along mu, on one site
+    template<typename TS, typename HS>
+    inline void reconstructSite(TS& f, const HS& h, int mu, enum PlusMinus isign)
+    {
+      if (isign == PLUS)
+      {
+	switch(mu) 
+	{
+	case 0: f = spinReconstructDir0Minus(h); break;
+	case 1: f = spinReconstructDir1Minus(h); break;
+	case 2: f = spinReconstructDir2Minus(h); break;
+	case 3: f = spinReconstructDir3Minus(h); break;
+	default: break;
+	}
+      }
+      else
+      {
+	switch(mu) 
+	{
+	case 0: f = spinReconstructDir0Plus(h); break;
+	case 1: f = spinReconstructDir1Plus(h); break;
+	case 2: f = spinReconstructDir2Plus(h); break;
+	case 3: f = spinReconstructDir3Plus(h); break;
+	default: break;
+	}
+      }
+    }
+
+    template<typename T, typename H, typename U>
+    struct DerivMultipoleArgs
+    {
+      U&                    ds;
+      const multi1d<H>&     h;       /*!< shifted half spinors of the poles, on cb */
+      const multi1d<T>&     chi;
+      int                   mu;
+      enum PlusMinus        isign;
+      const Real&           weight;
+      const multi1d<int>&   sites;
+    };
+
+    //! ds = weight * sum_i Tr_spin (recon h_i) chi_i^dag, each site over all the poles
+    template<typename T, typename H, typename U>
+    void derivMultipoleSiteLoop(int lo, int hi, int myId, DerivMultipoleArgs<T,H,U>* a)
+    {
+      typename T::Subtype_t f;
+
+      for(int ss=lo; ss < hi; ++ss)
+      {
+	int site = a->sites[ss];
+	typename U::Subtype_t& d = a->ds.elem(site);
+	zero_rep(d);
+
+	for(int i=0; i < a->chi.size(); ++i)
+	{
+	  reconstructSite(f, a->h[i].elem(site), a->mu, a->isign);
+	  d += traceSpin(outerProduct(f, a->chi[i].elem(site)));
+	}
+
+	d *= a->weight.elem();
+      }
+    }
+
+    //! Run the site kernel for one direction on the sites of cb
+    template<typename T, typename H, typename U>
+    void derivMultipoleSites(U& ds, const multi1d<H>& h, const multi1d<T>& chi, 
+			     int mu, enum PlusMinus isign, const Real& weight, int cb)
+    {
+      DerivMultipoleArgs<T,H,U> a = {ds, h, chi, mu, isign, weight, rb[cb].siteTable()};
+      dispatch_to_threads(rb[cb].numSiteTable(), a, derivMultipoleSiteLoop<T,H,U>);
+    }
+  }
+#endif
+
+
+  //! Take deriv of D summed over several pairs of vectors
+  /*!
+   * For each direction the half spinors of all the poles are projected
+   * and shifted, then one site kernel reconstructs them and sums their
+   * spin traces on each site, so the force is written once per site and
+   * direction. Only one direction of shifted half spinors is held at a
+   * time.
+   *
+   * \return Computes   \f$\sum_i \chi_i^\dag * \dot(D} * \psi_i\f$
+   */
+  template<typename T, typename P, typename Q>
+  void 
+  WilsonDslashBase<T,P,Q>::derivMultipole(P& ds_u,
+					  const multi1d<T>& chi, const multi1d<T>& psi, 
+					  enum PlusMinus isign, int cb) const
+  {
+    START_CODE();
+
+    if( chi.size() != psi.size() ) { 
+      QDPIO::cerr << __func__ << ": chi and psi have different sizes" << endl;
+      QDP_abort(1);
+    }
+
+    ds_u.resize(Nd);
+
+    const multi1d<Real>& anisoWeights = getCoeffs();
+
+    typedef typename HalfFermionType<T>::Type_t  H;
+    multi1d<H> h2(chi.size());
+
+    for(int mu = 0; mu < Nd; ++mu) 
+    {
+      for(int i=0; i < chi.size(); i++) 
+      {
+	H tmp_h;
+
+	// Undaggered: Minus Projectors, Daggered: Plus Projectors
+	// Shift only the half spinor, it is half the size of the full one.
+	if( isign == PLUS ) 
+	{
+	  switch(mu) 
+	  { 
+	  case 0: tmp_h[rb[1-cb]] = spinProjectDir0Minus(psi[i]); break;
+	  case 1: tmp_h[rb[1-cb]] = spinProjectDir1Minus(psi[i]); break;
+	  case 2: tmp_h[rb[1-cb]] = spinProjectDir2Minus(psi[i]); break;
+	  case 3: tmp_h[rb[1-cb]] = spinProjectDir3Minus(psi[i]); break;
+	  default: break;
+	  };
+	}
+	else
+	{
+	  switch(mu) 
+	  { 
+	  case 0: tmp_h[rb[1-cb]] = spinProjectDir0Plus(psi[i]); break;
+	  case 1: tmp_h[rb[1-cb]] = spinProjectDir1Plus(psi[i]); break;
+	  case 2: tmp_h[rb[1-cb]] = spinProjectDir2Plus(psi[i]); break;
+	  case 3: tmp_h[rb[1-cb]] = spinProjectDir3Plus(psi[i]); break;
+	  default: break;
+	  };
+	}
+
+	h2[i][rb[cb]] = shift(tmp_h, FORWARD, mu);
+      }
+
+#ifndef QDP_IS_QDPJIT
+      WilsonDslashBaseEnv::derivMultipoleSites(ds_u[mu], h2, chi, mu, isign, anisoWeights[mu], cb);
+#else
+      {
+	T temp_ferm;
+	ds_u[mu][rb[cb]] = zero;
+	for(int i=0; i < chi.size(); i++) 
+	{
+	  if( isign == PLUS ) 
+	  {
+	    switch(mu) 
+	    { 
+	    case 0: temp_ferm[rb[cb]] = spinReconstructDir0Minus(h2[i]); break;
+	    case 1: temp_ferm[rb[cb]] = spinReconstructDir1Minus(h2[i]); break;
+	    case 2: temp_ferm[rb[cb]] = spinReconstructDir2Minus(h2[i]); break;
+	    case 3: temp_ferm[rb[cb]] = spinReconstructDir3Minus(h2[i]); break;
+	    default: break;
+	    };
+	  }
+	  else
+	  {
+	    switch(mu) 
+	    { 
+	    case 0: temp_ferm[rb[cb]] = spinReconstructDir0Plus(h2[i]); break;
+	    case 1: temp_ferm[rb[cb]] = spinReconstructDir1Plus(h2[i]); break;
+	    case 2: temp_ferm[rb[cb]] = spinReconstructDir2Plus(h2[i]); break;
+	    case 3: temp_ferm[rb[cb]] = spinReconstructDir3Plus(h2[i]); break;
+	    default: break;
+	    };
+	  }
+	  ds_u[mu][rb[cb]] += traceSpin(outerProduct(temp_ferm,chi[i]));
+	}
+	ds_u[mu][rb[cb]] *= anisoWeights[mu];
+      }
+#endif
+      ds_u[mu][rb[1-cb]] = zero;    
+    }
+    (*this).getFermBC().zero(ds_u);
+
+    END_CODE();
+  }
+
+
   //! Return flops performed by the operator()
   template<typename T, typename P, typename Q>
   unsigned long 
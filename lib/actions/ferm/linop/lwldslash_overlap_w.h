@@ -0,0 +1,313 @@
+// -*- C++ -*-
+/*! \file
+ *  \brief Wilson Dslash overlapping the halo exchange with interior sites
+ */
+
+#ifndef __lwldslash_overlap_h__
+#define __lwldslash_overlap_h__
+
+#include "state.h"
+#include "handle.h"
+#include "io/aniso_io.h"
+#include "actions/ferm/linop/lwldslash_base_w.h"
+#include "actions/ferm/linop/dslash_halo.h"
+#include "actions/ferm/linop/spin_proj_site_w.h"
+
+namespace Chroma
+{
+  //! Site kernels of the overlapping dslash
+  namespace QDPWilsonDslashOverlapEnv
+  {
+    using SpinProjSiteEnv::projectSite;
+    using SpinProjSiteEnv::addReconstructSite;
+
+    template<typename T, typename Q>
+    struct PackArgs
+    {
+      const T&                 psi;
+      const Q&                 u;
+      const DslashHalo&        halo;
+      int                      cb;      /*!< checkerboard of the output */
+      int                      h;
+      int                      fsign;   /*!< forward projector (1 + fsign gamma_mu) */
+    };
+
+    //! Fill the send buffer of a hop
+    template<typename T, typename Q>
+    void packSiteLoop(int lo, int hi, int myId, PackArgs<T,Q>* a)
+    {
+      typedef typename WordType<T>::Type_t W;
+      typedef PSpinVector<PColorVector<RComplex<W>, Nc>, (Ns>>1)>  HalfSite_t;
+
+      const int mu = a->h / 2;
+      const bool fwd = (a->h % 2 == 0);
+      const multi1d<int>& sites = a->halo.sendSites(a->cb, a->h);
+      HalfSite_t* buf = (HalfSite_t *)(a->halo.sendBuf(a->cb, a->h));
+
+      for(int k=lo; k < hi; ++k)
+      {
+	int y = sites[k];
+
+	if (fwd)
+	  projectSite(buf[k], a->psi.elem(y), mu, a->fsign);
+	else
+	{
+	  HalfSite_t t;
+	  projectSite(t, a->psi.elem(y), mu, -a->fsign);
+	  buf[k] = adj(a->u[mu].elem(y)) * t;
+	}
+      }
+    }
+
+    template<typename T, typename Q>
+    struct DslashArgs
+    {
+      T&                       chi;
+      const T&                 psi;
+      const Q&                 u;
+      const DslashHalo&        halo;
+      const multi1d<int>&      sites;
+      int                      cb;      /*!< checkerboard of the output */
+      int                      fsign;   /*!< forward projector (1 + fsign gamma_mu) */
+    };
+
+    //! Whole dslash of a site, neighbours from the node or the halo
+    template<typename T, typename Q>
+    void dslashSiteLoop(int lo, int hi, int myId, DslashArgs<T,Q>* a)
+    {
+      typedef typename WordType<T>::Type_t W;
+      typedef PSpinVector<PColorVector<RComplex<W>, Nc>, (Ns>>1)>  HalfSite_t;
+      typedef PSpinVector<PColorVector<RComplex<W>, Nc>, Ns>       FermSite_t;
+
+      const int fsign = a->fsign;
+
+      for(int ss=lo; ss < hi; ++ss)
+      {
+	int x = a->sites[ss];
+	FermSite_t r;
+	zero_rep(r);
+
+	for(int mu=0; mu < Nd; ++mu)
+	{
+	  HalfSite_t hh;
+	  HalfSite_t uh;
+
+	  // psi(x+mu)
+	  int y = a->halo.neighbour(DslashHalo::hop(mu, 0, 0), x);
+	  if (y >= 0)
+	    projectSite(hh, a->psi.elem(y), mu, fsign);
+	  else
+	    hh = ((const HalfSite_t *)(a->halo.recvBuf(a->cb, DslashHalo::hop(mu, 0, 0))))[-1-y];
+
+	  uh = a->u[mu].elem(x) * hh;
+	  addReconstructSite(r, uh, mu, fsign);
+
+	  // psi(x-mu), with the link of x-mu applied by its owner
+	  y = a->halo.neighbour(DslashHalo::hop(mu, 0, 1), x);
+	  if (y >= 0)
+	  {
+	    projectSite(hh, a->psi.elem(y), mu, -fsign);
+	    uh = adj(a->u[mu].elem(y)) * hh;
+	  }
+	  else
+	    uh = ((const HalfSite_t *)(a->halo.recvBuf(a->cb, DslashHalo::hop(mu, 0, 1))))[-1-y];
+
+	  addReconstructSite(r, uh, mu, -fsign);
+	}
+
+	a->chi.elem(x) = r;
+      }
+    }
+  }
+
+
+  //! Wilson-Dirac dslash overlapping the halo exchange with interior sites
+  /*!
+   * \ingroup linop
+   *
+   * The same operator as QDPWilsonDslashT. The projected half spinors on
+   * the faces are packed and sent for all 2*Nd hops up front, the sites
+   * whose neighbours are all on the node are computed while the messages
+   * are in flight, and the face sites are finished from the receive
+   * buffers.
+   */
+  template<typename T, typename P, typename Q>
+  class QDPWilsonDslashOverlapT : public WilsonDslashBase<T, P, Q>
+  {
+  public:
+    //! Empty constructor. Must use create later
+    QDPWilsonDslashOverlapT() {}
+
+    //! Full constructor
+    QDPWilsonDslashOverlapT(Handle< FermState<T,P,Q> > state) {create(state);}
+
+    //! Full constructor with anisotropy
+    QDPWilsonDslashOverlapT(Handle< FermState<T,P,Q> > state,
+			    const AnisoParam_t& aniso_) {create(state, aniso_);}
+
+    //! Full constructor with general coefficients
+    QDPWilsonDslashOverlapT(Handle< FermState<T,P,Q> > state,
+			    const multi1d<Real>& coeffs_) {create(state, coeffs_);}
+
+    //! Creation routine
+    void create(Handle< FermState<T,P,Q> > state)
+    {
+      multi1d<Real> cf(Nd);
+      cf = 1.0;
+      create(state, cf);
+    }
+
+    //! Creation routine with anisotropy
+    void create(Handle< FermState<T,P,Q> > state,
+		const AnisoParam_t& aniso_)
+    {
+      create(state, makeFermCoeffs(aniso_));
+    }
+
+    //! Full constructor with general coefficients
+    void create(Handle< FermState<T,P,Q> > state,
+		const multi1d<Real>& coeffs_);
+
+    //! No real need for cleanup here
+    ~QDPWilsonDslashOverlapT() {}
+
+    /**
+     * Apply a dslash
+     *
+     * \param chi     result                                      (Write)
+     * \param psi     source                                      (Read)
+     * \param isign   D'^dag or D'  ( MINUS | PLUS ) resp.        (Read)
+     * \param cb      Checkerboard of OUTPUT vector               (Read)
+     *
+     * \return The output of applying dslash on psi
+     */
+    void apply (T& chi, const T& psi, enum PlusMinus isign, int cb) const;
+
+    //! Return the fermion BC object for this linear operator
+    const FermBC<T,P,Q>& getFermBC() const {return *fbc;}
+
+  protected:
+    //! Get the anisotropy parameters
+    const multi1d<Real>& getCoeffs() const {return coeffs;}
+
+  private:
+    multi1d<Real> coeffs;  /*!< Nd array of coefficients of terms in the action */
+    Handle< FermBC<T,P,Q> >  fbc;
+    Q  u;
+    Handle<DslashHalo>  halo;
+  };
+
+
+  //! Full constructor with general coefficients
+  template<typename T, typename P, typename Q>
+  void QDPWilsonDslashOverlapT<T,P,Q>::create(Handle< FermState<T,P,Q> > state,
+					      const multi1d<Real>& coeffs_)
+  {
+    START_CODE();
+
+    coeffs = coeffs_;
+
+    // Save a copy of the fermbc
+    fbc = state->getFermBC();
+
+    // Sanity check
+    if (fbc.operator->() == 0)
+    {
+      QDPIO::cerr << "QDPWilsonDslashOverlap: error: fbc is null" << endl;
+      QDP_abort(1);
+    }
+
+    u.resize(Nd);
+
+    // Fold in anisotropy
+    for(int mu=0; mu < u.size(); ++mu)
+      u[mu] = coeffs[mu] * (state->getLinks())[mu];
+
+    typedef typename WordType<T>::Type_t W;
+    multi1d<int> dists(1);
+    dists[0] = 1;
+
+    halo = new DslashHalo;
+    halo->create(sizeof(PSpinVector<PColorVector<RComplex<W>, Nc>, (Ns>>1)>), dists);
+
+    END_CODE();
+  }
+
+
+  //! General Wilson-Dirac dslash
+  /*! \ingroup linop
+   * Wilson dslash
+   *
+   * Arguments:
+   *
+   *  \param chi	      Result				                (Write)
+   *  \param psi	      Pseudofermion field				(Read)
+   *  \param isign      D'^dag or D' ( MINUS | PLUS ) resp.		(Read)
+   *  \param cb	      Checkerboard of OUTPUT vector			(Read)
+   */
+  template<typename T, typename P, typename Q>
+  void
+  QDPWilsonDslashOverlapT<T,P,Q>::apply (T& chi, const T& psi,
+					 enum PlusMinus isign, int cb) const
+  {
+    START_CODE();
+
+#if (QDP_NC == 2) || (QDP_NC == 3)
+    using namespace QDPWilsonDslashOverlapEnv;
+
+    const DslashHalo& hl = *halo;
+
+    // Forward hops project with (1 - isign gamma), backward with (1 + isign gamma)
+    int fsign = (isign == PLUS) ? -1 : +1;
+
+    // Pack and post the faces of all hops
+    for(int h=0; h < 2*Nd; ++h)
+    {
+      if (! hl.hasComms(cb, h))
+	continue;
+
+      PackArgs<T,Q> a = {psi, u, hl, cb, h, fsign};
+      dispatch_to_threads(hl.sendSites(cb, h).size(), a, packSiteLoop<T,Q>);
+      hl.start(cb, h);
+    }
+
+    // Interior sites while the messages are in flight
+    {
+      DslashArgs<T,Q> a = {chi, psi, u, hl, hl.innerSites(cb), cb, fsign};
+      dispatch_to_threads(hl.innerSites(cb).size(), a, dslashSiteLoop<T,Q>);
+    }
+
+    hl.wait(cb);
+
+    // Face sites
+    {
+      DslashArgs<T,Q> a = {chi, psi, u, hl, hl.faceSites(cb), cb, fsign};
+      dispatch_to_threads(hl.faceSites(cb).size(), a, dslashSiteLoop<T,Q>);
+    }
+
+    getFermBC().modifyF(chi, QDP::rb[cb]);
+#else
+    QDPIO::cerr << "lwldslash_overlap_w: not implemented for NC!=3\n";
+    QDP_abort(13);
+#endif
+
+    END_CODE();
+  }
+
+
+  typedef QDPWilsonDslashOverlapT<LatticeFermion,
+				  multi1d<LatticeColorMatrix>,
+				  multi1d<LatticeColorMatrix> > QDPWilsonDslashOverlap;
+
+  typedef QDPWilsonDslashOverlapT<LatticeFermionF,
+				  multi1d<LatticeColorMatrixF>,
+				  multi1d<LatticeColorMatrixF> > QDPWilsonDslashOverlapF;
+
+  typedef QDPWilsonDslashOverlapT<LatticeFermionD,
+				  multi1d<LatticeColorMatrixD>,
+				  multi1d<LatticeColorMatrixD> > QDPWilsonDslashOverlapD;
+
+} // End Namespace Chroma
+
+
+#endif
@@ -0,0 +1,46 @@
+// -*- C++ -*-
+/*! \file
+ *  \brief Spin projection and reconstruction of one site along a direction
+ */
+
+#ifndef __spin_proj_site_w_h__
+#define __spin_proj_site_w_h__
+
+#include "chromabase.h"
+
+namespace Chroma
+{
+  //! Site kernels of the Wilson hops with the direction known only at run time
+  /*! \ingroup linop */
+  namespace SpinProjSiteEnv
+  {
+    //! Project with (1 + sign gamma_mu)
+    template<typename H, typename S>
+    inline void projectSite(H& h, const S& p, int mu, int sign)
+    {
+      switch (mu)
+      {
+      case 0: if (sign > 0) h = spinProjectDir0Plus(p); else h = spinProjectDir0Minus(p); break;
+      case 1: if (sign > 0) h = spinProjectDir1Plus(p); else h = spinProjectDir1Minus(p); break;
+      case 2: if (sign > 0) h = spinProjectDir2Plus(p); else h = spinProjectDir2Minus(p); break;
+      case 3: if (sign > 0) h = spinProjectDir3Plus(p); else h = spinProjectDir3Minus(p); break;
+      }
+    }
+
+    //! Add the reconstruction after a (1 + sign gamma_mu) projection
+    template<typename S, typename H>
+    inline void addReconstructSite(S& p, const H& h, int mu, int sign)
+    {
+      switch (mu)
+      {
+      case 0: if (sign > 0) p += spinReconstructDir0Plus(h); else p += spinReconstructDir0Minus(h); break;
+      case 1: if (sign > 0) p += spinReconstructDir1Plus(h); else p += spinReconstructDir1Minus(h); break;
+      case 2: if (sign > 0) p += spinReconstructDir2Plus(h); else p += spinReconstructDir2Minus(h); break;
+      case 3: if (sign > 0) p += spinReconstructDir3Plus(h); else p += spinReconstructDir3Minus(h); break;
+      }
+    }
+  }
+
+}  // end namespace Chroma
+
+#endif
@@ -0,0 +1,169 @@
+// -*- C++ -*-
+/*! \file
+ *  \brief Multi-mass propagator solver for an even-odd staggered fermion operator
+ *
+ *  Solve for the propagators of several quark masses from one multi-shift CG
+ */
+
+#ifndef PREC_STAGGERED_MULTI_QPROP_H
+#define PREC_STAGGERED_MULTI_QPROP_H
+
+#include "stagtype_fermact_s.h"
+#include "actions/ferm/invert/minvcg.h"
+#include "actions/ferm/invert/syssolver_cg_params.h"
+
+
+namespace Chroma
+{
+  //! Multi-mass propagator of a generic even-odd staggered operator
+  /*! \ingroup qprop
+   *
+   * The even-even kernel of the action is
+   *
+   *      +
+   *    (M M)  =  4 m**2  - D  D
+   *         E             EO OE
+   *
+   * so the kernels of the other masses are shifts of it by 4 (m_i**2 - m**2)
+   * and one multi-shift CG solves them all. The preconditioned source
+   *
+   *    2 m_i chi_e  +  M_eo^dag chi_o
+   *
+   * depends on the mass only through chi_e, so chi_e and M_eo^dag chi_o are
+   * solved for separately and combined afterwards. A source on a single
+   * checkerboard, like a point source, takes one solve.
+   */
+  template<typename T, typename P, typename Q>
+  class EvenOddFermActMultiQprop
+  {
+  public:
+    //! Constructor
+    /*!
+     * \param S_        action, with the mass of the operators ( Read )
+     * \param state     gauge connection state ( Read )
+     * \param masses_   quark masses ( Read )
+     * \param invParam  inverter parameters ( Read )
+     */
+    EvenOddFermActMultiQprop(const EvenOddStaggeredTypeFermAct<T,P,Q>& S_,
+			     Handle< FermState<T,P,Q> > state,
+			     const multi1d<Real>& masses_,
+			     const SysSolverCGParams& invParam_) :
+      M(S_.linOp(state)), A(S_.lMdagM(state)),
+      Mass(S_.getQuarkMass()), masses(masses_), invParam(invParam_) {}
+
+    //! Destructor is automatic
+    ~EvenOddFermActMultiQprop() {}
+
+    //! Solve for all the masses
+    /*!
+     * \param psi      quark propagators, one per mass ( Write )
+     * \param chi      source ( Read )
+     * \return total number of CG iterations
+     */
+    SystemSolverResults_t operator() (multi1d<T>& psi, const T& chi) const
+    {
+      START_CODE();
+
+      const int n_mass = masses.size();
+
+      SystemSolverResults_t res;
+      res.n_count = 0;
+      res.resid = zero;
+
+      multi1d<Real> shifts(n_mass);
+      multi1d<Real> RsdCG(n_mass);
+      for(int i=0; i < n_mass; ++i)
+      {
+	if (toBool(masses[i] <= Real(0)))
+	{
+	  QDPIO::cerr << "EvenOddFermActMultiQprop: masses must be positive" << endl;
+	  QDP_abort(1);
+	}
+	shifts[i] = Real(4)*(masses[i]*masses[i] - Mass*Mass);
+	RsdCG[i] = invParam.RsdCG;
+      }
+
+      // The two mass independent parts of the preconditioned source
+      multi1d<T> x_e;
+      multi1d<T> x_o;
+      bool have_e = toBool(norm2(chi, rb[0]) > Double(0));
+      bool have_o = toBool(norm2(chi, rb[1]) > Double(0));
+
+      if (have_e)
+      {
+	int n_count;
+	MInvCG(*A, chi, x_e, shifts, RsdCG, invParam.MaxCG, n_count);
+	res.n_count += n_count;
+
+	// The count is that of the last mass to converge, the lightest
+	if ( n_count == invParam.MaxCG )
+	  QDP_error_exit("no convergence in the inverter", n_count);
+      }
+
+      if (have_o)
+      {
+	// tmp_e = M_eo^{dag} chi_o
+	T tmp;
+	M->evenOddLinOp(tmp, chi, MINUS);
+
+	int n_count;
+	MInvCG(*A, tmp, x_o, shifts, RsdCG, invParam.MaxCG, n_count);
+	res.n_count += n_count;
+
+	// The count is that of the last mass to converge, the lightest
+	if ( n_count == invParam.MaxCG )
+	  QDP_error_exit("no convergence in the inverter", n_count);
+      }
+
+      psi.resize(n_mass);
+      for(int i=0; i < n_mass; ++i)
+      {
+	T tmp1;
+	Real invm = Real(1)/(2*masses[i]);
+
+	// psi_e = 2 m_i A_i^{-1} chi_e + A_i^{-1} M_eo^{dag} chi_o
+	psi[i] = zero;
+	if (have_e)
+	  psi[i][rb[0]] = Real(2)*masses[i]*x_e[i];
+	if (have_o)
+	  psi[i][rb[0]] += x_o[i];
+
+	// psi_o = (1/2m_i) chi_o - (1/2m_i) D_oe psi_e
+	M->oddEvenLinOp(tmp1, psi[i], PLUS);
+	psi[i][rb[1]] = invm*(chi - tmp1);
+
+	// True residual with the mass of this solution
+	{
+	  T r;
+	  (*M)(r, psi[i], PLUS);
+	  r += Real(2)*(masses[i] - Mass)*psi[i];
+	  r -= chi;
+	  Real resid = sqrt(norm2(r));
+	  QDPIO::cout << "eoprec_staggered_multi_qprop: mass = " << masses[i]
+		      << "  true residual:  " << resid << endl;
+
+	  if (toBool(resid > res.resid))
+	    res.resid = resid;
+	}
+      }
+
+      END_CODE();
+
+      return res;
+    }
+
+
+  private:
+    // Hide default constructor
+    EvenOddFermActMultiQprop() {}
+
+    Handle< EvenOddLinearOperator<T,P,Q> > M;
+    Handle< DiffLinearOperator<T,P,Q> > A;
+    Real Mass;
+    multi1d<Real> masses;
+    SysSolverCGParams invParam;
+  };
+
+}; // End namespace
+
+#endif
@@ -0,0 +1,110 @@
+/*! \file
+ *  \brief Full multi-mass quark propagator solver
+ *
+ *  Given a complete propagator as a source, this does all the inversions needed
+ *  for several quark masses at once
+ */
+
+#include "chromabase.h"
+#include "fermact.h"
+#include "util/ferm/transf.h"
+#include "actions/ferm/qprop/eoprec_staggered_multi_qprop.h"
+#include "actions/ferm/invert/syssolver_cg_params.h"
+
+namespace Chroma
+{
+  typedef LatticeStaggeredFermion LF;
+  typedef multi1d<LatticeColorMatrix> LCM;
+
+  //! Given a complete propagator as a source, this does all the inversions needed
+  /*! \ingroup qprop
+   *
+   * This routine is generic to all even-odd Staggered-like fermions whose
+   * M^dag M depends on the mass only through 4 m**2
+   *
+   * \param q_sol    quark propagators, one per mass ( Write )
+   * \param q_src    source ( Read )
+   * \param masses   quark masses ( Read )
+   * \param invParam CG inverter parameters ( Read )
+   * \param ncg_had  number of CG iterations ( Write )
+   */
+  template<>
+  void
+  EvenOddStaggeredTypeFermAct<LF,LCM,LCM>::multiQuarkProp(multi1d<LatticeStaggeredPropagator>& q_sol,
+							  XMLWriter& xml_out,
+							  const LatticeStaggeredPropagator& q_src,
+							  Handle< FermState<LF,LCM,LCM> > state,
+							  const multi1d<Real>& masses,
+							  const GroupXML_t& invParam,
+							  int& ncg_had) const
+  {
+    START_CODE();
+
+    push(xml_out, "multiQuarkProp4");
+
+    std::istringstream  is(invParam.xml);
+    XMLReader  paramtop(is);
+    SysSolverCGParams params(paramtop,invParam.path);
+
+    EvenOddFermActMultiQprop<LF,LCM,LCM> qprop(*this, state, masses, params);
+
+    q_sol.resize(masses.size());
+    ncg_had = 0;
+
+    multi1d<LF> psi(masses.size());
+
+    // This version loops over all color indices
+    for(int color_source = 0; color_source < Nc; ++color_source)
+    {
+      QDPIO::cout<<"quarkprop_multi_s:: doing color  : "<< color_source<<endl;
+
+      LF chi;
+
+      // Extract a fermion source
+      PropToFerm(q_src, chi, color_source);
+
+      /*
+       * Normalize the source in case it is really huge or small -
+       * a trick to avoid overflows or underflows
+       */
+      Real fact = 1.0;
+      Real nrm = sqrt(norm2(chi));
+      if (toFloat(nrm) != 0.0)
+	fact /= nrm;
+
+      // Rescale
+      chi *= fact;
+
+      // Compute the propagators for given source color.
+      {
+	SystemSolverResults_t result = qprop(psi, chi);
+	ncg_had += result.n_count;
+
+	push(xml_out,"Qprop");
+	write(xml_out, "color_source", color_source);
+	write(xml_out, "n_count", result.n_count);
+	write(xml_out, "resid", result.resid);
+	pop(xml_out);
+      }
+
+      // Unnormalize the source following the inverse of the normalization above
+      fact = Real(1) / fact;
+
+      for(int i=0; i < masses.size(); ++i)
+      {
+	psi[i] *= fact;
+
+	/*
+	 * Move the solution to the appropriate components
+	 * of quark propagator.
+	 */
+	FermToProp(psi[i], q_sol[i], color_source);
+      }
+    } /* end loop over color_source */
+
+    pop(xml_out);
+
+    END_CODE();
+  }
+
+}
@@ -7,6 +7,8 @@
 
 #include "init/chroma_init.h"
 #include "io/xmllog_io.h"
+#include "util/thread/tuned_dispatch.h"
+#include "util/thread/numa_affinity.h"
 
 #if defined(BUILD_JIT_CLOVER_TERM)
 #if defined(QDPJIT_IS_QDPJITPTX)
@@ -45,6 +47,15 @@ namespace Chroma
     //! Has the input instance been created?
     // bool xmlInputP = false;
 
+    //! Tune the threaded site loops?
+    bool tune_dispatch = false;
+
+    //! Where to keep the tuned schedules
+    string tune_cache_file = "";
+
+    //! Pin the threads and first touch the fields?
+    bool numa_mode = false;
+
 
     // Internal
     string constructFileName(const string& filename)
@@ -120,6 +131,9 @@ namespace Chroma
 		    << "   --chroma-l   [" << getXMLLogFileName() << "]  xml log file name\n"
 		    << "   -cwd         [" << getCWD() << "]  xml log file name\n"
 		    << "   --chroma-cwd [" << getCWD() << "]  xml log file name\n"
+		    << "   --chroma-tune               tune the threaded site loop schedules\n"
+		    << "   --chroma-tune-cache <file>  tune and keep the schedules in <file>\n"
+		    << "   --chroma-numa               pin threads and place the gauge and clover fields on their NUMA nodes\n"
 
 		    
 		    << endl;
@@ -188,6 +202,34 @@ namespace Chroma
 	}
       }
 
+      // Search for --chroma-tune
+      if( argv_i == string("--chroma-tune") ) 
+      {
+	tune_dispatch = true;
+      }
+
+      // Search for --chroma-tune-cache
+      if( argv_i == string("--chroma-tune-cache") ) 
+      {
+	if( i + 1 < *argc ) {
+	  tune_dispatch = true;
+	  tune_cache_file = string( (*argv)[i+1] );
+	  // Skip over next
+	  i++;
+	}
+	else {
+	  // i + 1 is too big
+	  QDPIO::cerr << "Error: dangling --chroma-tune-cache specified. " << endl;
+	  QDP_abort(1);
+	}
+      }
+
+      // Search for --chroma-numa
+      if( argv_i == string("--chroma-numa") ) 
+      {
+	numa_mode = true;
+      }
+
     }
 
 
@@ -222,7 +264,14 @@ namespace Chroma
 #endif
 #endif
 
+    if (numa_mode)
+      NumaAffinityEnv::enable();
 
+    // The cache is read with all of QDP up
+    if (tune_cache_file != "")
+      TunedDispatchEnv::setCacheFile(tune_cache_file);
+    else if (tune_dispatch)
+      TunedDispatchEnv::enable();
 
 
   }
@@ -245,6 +294,8 @@ namespace Chroma
     if (! QDP_isInitialized())
       return;
 
+    TunedDispatchEnv::writeCache();
+
     
     /*
     if( xmlInputP ) { 
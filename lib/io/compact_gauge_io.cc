@@ -0,0 +1,492 @@
+/*! \file
+ *  \brief Compact gauge format storing reconstructable SU(3) links
+ */
+
+#include "chromabase.h"
+#include "io/compact_gauge_io.h"
+#include "io/slab_io.h"
+
+#include "qdp_util.h"   // from QDP++
+
+#include <complex>
+#include <sstream>
+#include <vector>
+#include <string.h>
+#include <cstdio>
+
+namespace Chroma
+{
+
+  namespace CompactGaugeEnv
+  {
+    //! File identification
+    const int magic_number = 0x43474331;
+    const int version = 1;
+
+    typedef std::complex<double> cmplx_t;
+
+    //! Third row of an SU(3) matrix from the first two
+    inline void thirdRow(const cmplx_t* a, const cmplx_t* b, cmplx_t* c)
+    {
+      c[0] = std::conj(a[1]*b[2] - a[2]*b[1]);
+      c[1] = std::conj(a[2]*b[0] - a[0]*b[2]);
+      c[2] = std::conj(a[0]*b[1] - a[1]*b[0]);
+    }
+
+    //! Stored reals of a link
+    template<typename T>
+    void packLink(cmplx_t m[3][3], int reconstruct, T* p)
+    {
+      if (reconstruct == 12)
+      {
+	for(int j=0; j < 3; ++j)
+	{
+	  p[2*j]   = m[0][j].real();
+	  p[2*j+1] = m[0][j].imag();
+	  p[6+2*j] = m[1][j].real();
+	  p[7+2*j] = m[1][j].imag();
+	}
+      }
+      else
+      {
+	p[0] = m[0][1].real();  p[1] = m[0][1].imag();
+	p[2] = m[0][2].real();  p[3] = m[0][2].imag();
+	p[4] = m[1][0].real();  p[5] = m[1][0].imag();
+	p[6] = std::arg(m[0][0]);
+	p[7] = std::arg(m[2][0]);
+      }
+    }
+
+    //! Rebuild a link from its stored reals
+    template<typename T>
+    void rebuildLink(const T* p, int reconstruct, cmplx_t m[3][3])
+    {
+      if (reconstruct == 12)
+      {
+	for(int j=0; j < 3; ++j)
+	{
+	  m[0][j] = cmplx_t(p[2*j], p[2*j+1]);
+	  m[1][j] = cmplx_t(p[6+2*j], p[7+2*j]);
+	}
+      }
+      else
+      {
+	const cmplx_t a1(p[0], p[1]);
+	const cmplx_t a2(p[2], p[3]);
+	const cmplx_t b0(p[4], p[5]);
+
+	// Unit rows and columns fix the moduli of a_1 and c_1
+	double n  = std::norm(a1) + std::norm(a2);
+	double n0 = 1 - n;
+	double nc = n - std::norm(b0);
+
+	const cmplx_t a0 = std::polar(sqrt((n0 > 0) ? n0 : 0.0), double(p[6]));
+	const cmplx_t c0 = std::polar(sqrt((nc > 0) ? nc : 0.0), double(p[7]));
+
+	// Orthogonality of b to a and c = (a x b)^* fix b_2 and b_3
+	m[0][0] = a0;
+	m[0][1] = a1;
+	m[0][2] = a2;
+	m[1][0] = b0;
+	m[1][1] = -(std::conj(a2)*std::conj(c0) + a1*b0*std::conj(a0)) / n;
+	m[1][2] =  (std::conj(a1)*std::conj(c0) - a2*b0*std::conj(a0)) / n;
+      }
+
+      thirdRow(m[0], m[1], m[2]);
+    }
+
+
+    struct PackArgs
+    {
+      const multi1d<LatticeColorMatrix>& u;
+      const multi1d<int>&                sites;      /*!< node linear index of each packed site */
+      std::vector<char>&                 local_buf;  /*!< Nd links per site in slab order */
+      int                                reconstruct;
+      bool                               swap;
+      double                             tol;        /*!< allowed error of a rebuilt entry */
+      multi1d<double>&                   nbad;       /*!< links not rebuilt within tol, per thread */
+    };
+
+    void packSiteLoop(int lo, int hi, int myId, PackArgs* a)
+    {
+      const int ncomp = a->reconstruct;
+      double nbad = 0;
+
+      for(int j=lo; j < hi; ++j)
+      {
+	REAL* p = (REAL *)&(a->local_buf[j*Nd*ncomp*sizeof(REAL)]);
+
+	for(int mu=0; mu < Nd; ++mu, p += ncomp)
+	{
+	  cmplx_t m[3][3];
+	  for(int i=0; i < 3; ++i)
+	    for(int k=0; k < 3; ++k)
+	      m[i][k] = cmplx_t(a->u[mu].elem(a->sites[j]).elem().elem(i,k).real(),
+				a->u[mu].elem(a->sites[j]).elem().elem(i,k).imag());
+
+	  packLink(m, ncomp, p);
+
+	  // The link must come back from what is stored
+	  cmplx_t r[3][3];
+	  rebuildLink(p, ncomp, r);
+
+	  bool good = true;
+	  for(int i=0; i < 3; ++i)
+	    for(int k=0; k < 3; ++k)
+	      good &= (std::abs(r[i][k] - m[i][k]) <= a->tol);
+
+	  if (! good)
+	    nbad += 1;
+
+	  if (a->swap)
+	    QDPUtil::byte_swap((void *)p, sizeof(REAL), ncomp);
+	}
+      }
+
+      a->nbad[myId] += nbad;
+    }
+
+
+    struct UnpackArgs
+    {
+      multi1d<LatticeColorMatrix>& u;
+      const multi1d<int>&          sites;      /*!< node linear index of each packed site */
+      const std::vector<char>&     local_buf;  /*!< Nd links per site in slab order */
+      int                          reconstruct;
+      bool                         swap;
+    };
+
+    template<typename T>
+    void unpackSiteLoop(int lo, int hi, int myId, UnpackArgs* a)
+    {
+      const int ncomp = a->reconstruct;
+      T p[18];
+
+      for(int j=lo; j < hi; ++j)
+      {
+	for(int mu=0; mu < Nd; ++mu)
+	{
+	  memcpy(p, &(a->local_buf[(j*Nd + mu)*ncomp*sizeof(T)]), ncomp*sizeof(T));
+
+	  if (a->swap)
+	    QDPUtil::byte_swap((void *)p, sizeof(T), ncomp);
+
+	  cmplx_t m[3][3];
+	  rebuildLink(p, ncomp, m);
+
+	  for(int i=0; i < 3; ++i)
+	    for(int k=0; k < 3; ++k)
+	    {
+	      a->u[mu].elem(a->sites[j]).elem().elem(i,k).real() = m[i][k].real();
+	      a->u[mu].elem(a->sites[j]).elem().elem(i,k).imag() = m[i][k].imag();
+	    }
+	}
+      }
+    }
+
+
+    //! Rotate left, with a zero rotation leaving the word alone as in MILC
+    inline unsigned int rotl(unsigned int val, int r)
+    {
+      return (r == 0) ? val : ((val << r) | (val >> (32-r)));
+    }
+
+    struct ChecksumArgs
+    {
+      const std::vector<char>& local_buf;   /*!< stored sites in file byte order */
+      const multi1d<int>&      lex;         /*!< lexicographic index of each packed site */
+      int                      site_words;  /*!< 32 bit words per site */
+      multi1d<unsigned int>&   sum29;       /*!< per thread */
+      multi1d<unsigned int>&   sum31;       /*!< per thread */
+    };
+
+    //! Checksums of the stored words, read as big endian whatever the host
+    void checksumSiteLoop(int lo, int hi, int myId, ChecksumArgs* a)
+    {
+      unsigned int s29 = 0;
+      unsigned int s31 = 0;
+
+      for(int j=lo; j < hi; ++j)
+      {
+	unsigned long rank = (unsigned long)(a->lex[j]) * a->site_words;
+	int r29 = rank % 29;
+	int r31 = rank % 31;
+
+	const unsigned char* b = (const unsigned char*)&(a->local_buf[4*j*a->site_words]);
+
+	for(int k=0; k < a->site_words; ++k, b += 4)
+	{
+	  unsigned int val = (((unsigned int)b[0]) << 24) | (((unsigned int)b[1]) << 16)
+	    | (((unsigned int)b[2]) << 8) | ((unsigned int)b[3]);
+
+	  s29 ^= rotl(val, r29);
+	  s31 ^= rotl(val, r31);
+
+	  if (++r29 == 29) r29 = 0;
+	  if (++r31 == 31) r31 = 0;
+	}
+      }
+
+      a->sum29[myId] ^= s29;
+      a->sum31[myId] ^= s31;
+    }
+
+    //! Accumulate the checksums of the local part of a slab
+    void checksum(const SiteSlab& slab, const std::vector<char>& local_buf, int site_words,
+		  unsigned int& sum29, unsigned int& sum31)
+    {
+      multi1d<unsigned int> s29(qdpNumThreads());
+      multi1d<unsigned int> s31(qdpNumThreads());
+      s29 = 0;
+      s31 = 0;
+
+      ChecksumArgs a = {local_buf, slab.localLexSites(), site_words, s29, s31};
+      dispatch_to_threads(slab.numLocalSites(), a, checksumSiteLoop);
+
+      for(int i=0; i < s29.size(); ++i)
+      {
+	sum29 ^= s29[i];
+	sum31 ^= s31[i];
+      }
+    }
+
+    //! Write a string with its length
+    void writeString(BinaryWriter& bin, const std::string& s)
+    {
+      int len = s.size();
+      write(bin, len);
+      bin.writeArray(s.data(), 1, len);
+    }
+
+    //! Read a string with its length
+    void readString(BinaryReader& bin, std::string& s)
+    {
+      int len;
+      read(bin, len);
+
+      std::vector<char> buf(len+1, '\0');
+      if (len > 0)
+	bin.readArray(&buf[0], 1, len);
+      s = &buf[0];
+    }
+
+    //! Slab of timeslice t in lexicographic order
+    multi1d<int> timeslice(int t)
+    {
+      const int vs = Layout::vol() / Layout::lattSize()[Nd-1];
+      multi1d<int> lex(vs);
+      for(int i=0; i < vs; ++i)
+	lex[i] = t*vs + i;
+
+      return lex;
+    }
+  }
+
+
+  // Write a gauge configuration in the compact format
+  void writeCompactGauge(XMLBufferWriter& file_xml, XMLBufferWriter& record_xml,
+			 const multi1d<LatticeColorMatrix>& u,
+			 const std::string& file, int reconstruct)
+  {
+    START_CODE();
+
+    using namespace CompactGaugeEnv;
+
+    if (Nc != 3)
+    {
+      QDPIO::cerr << __func__ << ": only supports Nc=3" << endl;
+      QDP_abort(1);
+    }
+
+    if (reconstruct != 12 && reconstruct != 8)
+    {
+      QDPIO::cerr << __func__ << ": reconstruct must be 12 or 8, found " << reconstruct << endl;
+      QDP_abort(1);
+    }
+
+    // Allowed error in the rebuilt links
+    const double tol = (sizeof(REAL) == sizeof(REAL32)) ? 1.0e-5 : 1.0e-10;
+
+    // Written under a temporary name and renamed once every link is known
+    // to rebuild, so a failed write leaves no unusable file behind
+    const std::string tmp_file = file + ".tmp";
+    BinaryFileWriter bin(tmp_file);
+
+    write(bin, magic_number);
+    write(bin, version);
+    write(bin, reconstruct);
+    write(bin, int(sizeof(REAL)));
+    write(bin, Nd);
+    write(bin, Layout::lattSize(), Nd);
+    writeString(bin, file_xml.str());
+    writeString(bin, record_xml.str());
+
+    // Sites a timeslice at a time in lexicographic order. The data is big
+    // endian like the header.
+    const bool swap = ! QDPUtil::big_endian();
+    const size_t site_bytes = Nd*reconstruct*sizeof(REAL);
+    const int site_words = site_bytes / 4;
+
+    unsigned int sums[2] = {0, 0};
+    multi1d<double> nbad(qdpNumThreads());
+    nbad = 0;
+
+    for(int t=0; t < Layout::lattSize()[Nd-1]; ++t)
+    {
+      SiteSlab slab(timeslice(t));
+
+      std::vector<char> local_buf(slab.numLocalSites()*site_bytes);
+      PackArgs a = {u, slab.localSites(), local_buf, reconstruct, swap, tol, nbad};
+      dispatch_to_threads(slab.numLocalSites(), a, packSiteLoop);
+
+      checksum(slab, local_buf, site_words, sums[0], sums[1]);
+      writeSlab(bin, slab, site_bytes, local_buf);
+    }
+
+    globalXor(sums, 2);
+    write(bin, sums[0]);
+    write(bin, sums[1]);
+
+    bin.close();
+
+    double bad = 0;
+    for(int i=0; i < nbad.size(); ++i)
+      bad += nbad[i];
+
+    QDPInternal::globalSum(bad);
+
+    QDPIO::cout << __func__ << ": reconstruct= " << reconstruct
+		<< "  (sum29, sum31)= " << sums[0] << " " << sums[1] << endl;
+
+    if (bad > 0)
+    {
+      if (Layout::primaryNode())
+	std::remove(tmp_file.c_str());
+
+      QDPIO::cerr << __func__ << ": " << bad << " links are not rebuilt to within " << tol
+		  << " - they are not SU(3) or degenerate for reconstruct=" << reconstruct
+		  << ". File " << file << " not written" << endl;
+      QDP_abort(1);
+    }
+
+    int renamed = 1;
+    if (Layout::primaryNode())
+      renamed = (std::rename(tmp_file.c_str(), file.c_str()) == 0) ? 1 : 0;
+    QDPInternal::broadcast(renamed);
+
+    if (! renamed)
+    {
+      QDPIO::cerr << __func__ << ": could not rename " << tmp_file << " to " << file << endl;
+      QDP_abort(1);
+    }
+
+    END_CODE();
+  }
+
+
+  // Read a gauge configuration in the compact format
+  void readCompactGauge(XMLReader& file_xml, XMLReader& record_xml,
+			multi1d<LatticeColorMatrix>& u,
+			const std::string& file)
+  {
+    START_CODE();
+
+    using namespace CompactGaugeEnv;
+
+    BinaryFileReader bin(file);
+
+    int magic, vers, reconstruct, real_bytes, nd;
+    read(bin, magic);
+    read(bin, vers);
+
+    if (magic != magic_number || vers != version)
+    {
+      QDPIO::cerr << __func__ << ": " << file << " is not a compact gauge file of version "
+		  << version << endl;
+      QDP_abort(1);
+    }
+
+    read(bin, reconstruct);
+    read(bin, real_bytes);
+    read(bin, nd);
+
+    if ((reconstruct != 12 && reconstruct != 8) ||
+	(real_bytes != sizeof(REAL32) && real_bytes != sizeof(REAL64)) || nd != Nd)
+    {
+      QDPIO::cerr << __func__ << ": unsupported header: reconstruct= " << reconstruct
+		  << "  real_bytes= " << real_bytes << "  Nd= " << nd << endl;
+      QDP_abort(1);
+    }
+
+    multi1d<int> nrow(Nd);
+    read(bin, nrow, Nd);
+    for(int mu=0; mu < Nd; ++mu)
+    {
+      if (nrow[mu] != Layout::lattSize()[mu])
+      {
+	QDPIO::cerr << __func__ << ": unexpected lattice size: nrow[" << mu << "]="
+		    << nrow[mu] << endl;
+	QDP_abort(1);
+      }
+    }
+
+    std::string file_str, record_str;
+    readString(bin, file_str);
+    readString(bin, record_str);
+
+    u.resize(Nd);
+
+    const bool swap = ! QDPUtil::big_endian();
+    const size_t site_bytes = Nd*reconstruct*real_bytes;
+    const int site_words = site_bytes / 4;
+
+    unsigned int sums[2] = {0, 0};
+    std::vector<char> local_buf;
+
+    for(int t=0; t < Layout::lattSize()[Nd-1]; ++t)
+    {
+      SiteSlab slab(timeslice(t));
+      readSlab(bin, slab, site_bytes, local_buf);
+
+      checksum(slab, local_buf, site_words, sums[0], sums[1]);
+
+      UnpackArgs a = {u, slab.localSites(), local_buf, reconstruct, swap};
+      if (real_bytes == sizeof(REAL32))
+	dispatch_to_threads(slab.numLocalSites(), a, unpackSiteLoop<REAL32>);
+      else
+	dispatch_to_threads(slab.numLocalSites(), a, unpackSiteLoop<REAL64>);
+    }
+
+    unsigned int sum29, sum31;
+    read(bin, sum29);
+    read(bin, sum31);
+
+    bin.close();
+
+    globalXor(sums, 2);
+    if (sums[0] != sum29 || sums[1] != sum31)
+    {
+      QDPIO::cerr << __func__ << ": checksum mismatch: file (sum29, sum31) = ("
+		  << sum29 << ", " << sum31 << ")  computed = ("
+		  << sums[0] << ", " << sums[1] << ")" << endl;
+      QDP_abort(1);
+    }
+
+    try
+    {
+      std::istringstream file_is(file_str);
+      file_xml.open(file_is);
+
+      std::istringstream record_is(record_str);
+      record_xml.open(record_is);
+    }
+    catch(const std::string& e)
+    {
+      QDPIO::cerr << __func__ << ": error reading the xml of " << file << ": " << e << endl;
+      QDP_abort(1);
+    }
+
+    END_CODE();
+  }
+
+}  // end namespace Chroma
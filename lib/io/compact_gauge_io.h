@@ -0,0 +1,52 @@
+// -*- C++ -*-
+/*! \file
+ *  \brief Compact gauge format storing reconstructable SU(3) links
+ */
+
+#ifndef __compact_gauge_io_h__
+#define __compact_gauge_io_h__
+
+#include "chromabase.h"
+
+namespace Chroma
+{
+
+  //! Write a gauge configuration in the compact format
+  /*!
+   * \ingroup io
+   *
+   * Each SU(3) link is stored either as its first two rows (reconstruct=12)
+   * or as the 8 real parameters a_2, a_3, b_1, arg(a_1), arg(c_1) of the
+   * rows a, b, c (reconstruct=8). The remaining entries follow from
+   * unitarity on reading. The writer checks every link can be rebuilt and
+   * aborts otherwise, leaving no file behind. The file carries the file and
+   * record xml, and MILC style sum29/sum31 checksums of the stored data.
+   *
+   * \param file_xml     file xml ( Read )
+   * \param record_xml   record xml ( Read )
+   * \param u            gauge configuration ( Read )
+   * \param file         path ( Read )
+   * \param reconstruct  12 or 8 reals per link ( Read )
+   */
+  void writeCompactGauge(XMLBufferWriter& file_xml, XMLBufferWriter& record_xml,
+			 const multi1d<LatticeColorMatrix>& u,
+			 const std::string& file, int reconstruct);
+
+  //! Read a gauge configuration in the compact format
+  /*!
+   * \ingroup io
+   *
+   * Rebuilds the full links and verifies the checksums.
+   *
+   * \param file_xml     file xml ( Write )
+   * \param record_xml   record xml ( Write )
+   * \param u            gauge configuration ( Write )
+   * \param file         path ( Read )
+   */
+  void readCompactGauge(XMLReader& file_xml, XMLReader& record_xml,
+			multi1d<LatticeColorMatrix>& u,
+			const std::string& file);
+
+}  // end namespace Chroma
+
+#endif
@@ -0,0 +1,291 @@
+/*! \file
+ *  \brief Appendable binary file of correlators
+ */
+
+#include "chromabase.h"
+#include "io/corr_sink_io.h"
+
+#include "qdp_util.h"   // from QDP++
+
+#include <sstream>
+
+namespace Chroma
+{
+
+  namespace CorrSinkEnv
+  {
+    //! File identification
+    const unsigned int magic_number = 0x43524c31;
+    const unsigned int version = 1;
+
+    //! Record types
+    enum RecordType_t {META_RECORD = 1, CORR_RECORD = 2};
+
+    //! Big endian write
+    void putWords(std::ostream& os, const void* p, size_t size, size_t n)
+    {
+      if (QDPUtil::big_endian())
+      {
+	os.write((const char *)p, size*n);
+	return;
+      }
+
+      std::vector<char> buf((const char *)p, (const char *)p + size*n);
+      QDPUtil::byte_swap((void *)&buf[0], size, n);
+      os.write(&buf[0], size*n);
+    }
+
+    //! Big endian read
+    void getWords(std::istream& is, void* p, size_t size, size_t n)
+    {
+      is.read((char *)p, size*n);
+      if (! QDPUtil::big_endian())
+	QDPUtil::byte_swap(p, size, n);
+    }
+
+    void putUInt(std::ostream& os, unsigned int w)
+    {
+      putWords(os, &w, sizeof(unsigned int), 1);
+    }
+
+    unsigned int getUInt(std::istream& is)
+    {
+      unsigned int w = 0;
+      getWords(is, &w, sizeof(unsigned int), 1);
+      return w;
+    }
+  }
+
+
+  // Open for appending, creating the file if needed
+  CorrSink::CorrSink(const std::string& file_, bool xml_p_) : file(file_), xml_p(xml_p_)
+  {
+    using namespace CorrSinkEnv;
+
+    if (Layout::primaryNode())
+    {
+      f.open(file.c_str(), std::ios::binary | std::ios::app);
+      if (f.fail())
+      {
+	QDPIO::cerr << __func__ << ": error opening file " << file << endl;
+	QDP_abort(1);
+      }
+
+      // A new file gets the header
+      f.seekp(0, std::ios::end);
+      if (f.tellp() == std::streampos(0))
+      {
+	putUInt(f, magic_number);
+	putUInt(f, version);
+      }
+    }
+  }
+
+
+  // Close
+  CorrSink::~CorrSink()
+  {
+    if (Layout::primaryNode())
+      f.close();
+  }
+
+
+  // Start a group of correlators described by xml
+  void CorrSink::writeMeta(XMLBufferWriter& xml)
+  {
+    using namespace CorrSinkEnv;
+
+    std::string s = xml.str();
+
+    if (Layout::primaryNode())
+    {
+      putUInt(f, META_RECORD);
+      putUInt(f, s.size());
+      f.write(s.data(), s.size());
+    }
+  }
+
+
+  // Append a correlator record
+  void CorrSink::writeCorr(const std::string& key, int ncomp, std::vector<double>& data)
+  {
+    using namespace CorrSinkEnv;
+
+    if (! Layout::primaryNode())
+      return;
+
+    unsigned int payload = 3*sizeof(unsigned int) + key.size() + data.size()*sizeof(double);
+
+    putUInt(f, CORR_RECORD);
+    putUInt(f, payload);
+    putUInt(f, key.size());
+    f.write(key.data(), key.size());
+    putUInt(f, ncomp);
+    putUInt(f, data.size() / ncomp);
+    putWords(f, &data[0], sizeof(double), data.size());
+
+    if (f.fail())
+    {
+      QDPIO::cerr << __func__ << ": error writing file " << file << endl;
+      QDP_abort(1);
+    }
+  }
+
+
+  // Append a correlator
+  void CorrSink::write(const std::string& key, const multi1d<Real>& corr)
+  {
+    std::vector<double> data(corr.size());
+    for(int t=0; t < corr.size(); ++t)
+      data[t] = toDouble(corr[t]);
+
+    writeCorr(key, 1, data);
+  }
+
+
+  // Append a correlator
+  void CorrSink::write(const std::string& key, const multi1d<Complex>& corr)
+  {
+    std::vector<double> data(2*corr.size());
+    for(int t=0; t < corr.size(); ++t)
+    {
+      data[2*t]   = toDouble(real(corr[t]));
+      data[2*t+1] = toDouble(imag(corr[t]));
+    }
+
+    writeCorr(key, 2, data);
+  }
+
+
+  // Append a correlator
+  void CorrSink::write(const std::string& key, const multi1d<DComplex>& corr)
+  {
+    std::vector<double> data(2*corr.size());
+    for(int t=0; t < corr.size(); ++t)
+    {
+      data[2*t]   = toDouble(real(corr[t]));
+      data[2*t+1] = toDouble(imag(corr[t]));
+    }
+
+    writeCorr(key, 2, data);
+  }
+
+
+  // Flush the file
+  void CorrSink::flush()
+  {
+    if (Layout::primaryNode())
+      f.flush();
+  }
+
+
+  // Key of a correlator at a sink momentum
+  std::string corrKey(const std::string& group, const std::string& name, int num,
+		      const multi1d<int>& sink_mom)
+  {
+    std::ostringstream os;
+    os << group << "/" << name << "=" << num << "/sink_mom=";
+    for(int mu=0; mu < sink_mom.size(); ++mu)
+      os << ((mu == 0) ? "" : ",") << sink_mom[mu];
+
+    return os.str();
+  }
+
+
+  //---------------------------------------------------------------------
+  // Index the file
+  CorrSinkReader::CorrSinkReader(const std::string& file)
+  {
+    using namespace CorrSinkEnv;
+
+    f.open(file.c_str(), std::ios::binary);
+    if (f.fail())
+    {
+      QDPIO::cerr << __func__ << ": error opening file " << file << endl;
+      QDP_abort(1);
+    }
+
+    if (getUInt(f) != magic_number)
+    {
+      QDPIO::cerr << __func__ << ": not a correlator file " << file << endl;
+      QDP_abort(1);
+    }
+
+    unsigned int v = getUInt(f);
+    if (v != version)
+    {
+      QDPIO::cerr << __func__ << ": unsupported version " << v << " in " << file << endl;
+      QDP_abort(1);
+    }
+
+    for(;;)
+    {
+      unsigned int type = getUInt(f);
+      if (f.eof())
+	break;
+
+      unsigned int payload = getUInt(f);
+      std::streamoff start = f.tellg();
+
+      if (type == META_RECORD)
+      {
+	std::string s(payload, ' ');
+	f.read(&s[0], payload);
+	group_xml.push_back(s);
+      }
+      else if (type == CORR_RECORD)
+      {
+	Record_t r;
+	unsigned int key_len = getUInt(f);
+	r.key.resize(key_len);
+	f.read(&r.key[0], key_len);
+	r.ncomp  = getUInt(f);
+	r.length = getUInt(f);
+	r.group  = int(group_xml.size()) - 1;
+	r.offset = f.tellg();
+	records.push_back(r);
+      }
+
+      // Unknown records are skipped too
+      f.seekg(start + std::streamoff(payload));
+
+      if (f.fail())
+      {
+	QDPIO::cerr << __func__ << ": truncated record in " << file << endl;
+	QDP_abort(1);
+      }
+    }
+
+    f.clear();
+  }
+
+
+  // First record with key in group g, or -1
+  int CorrSinkReader::find(const std::string& key, int g) const
+  {
+    for(int r=0; r < records.size(); ++r)
+      if (records[r].group == g && records[r].key == key)
+	return r;
+
+    return -1;
+  }
+
+
+  // Read a correlator
+  void CorrSinkReader::read(int r, multi1d<DComplex>& corr)
+  {
+    using namespace CorrSinkEnv;
+
+    const Record_t& rec = records[r];
+    std::vector<double> data(rec.ncomp * rec.length);
+
+    f.seekg(rec.offset);
+    getWords(f, &data[0], sizeof(double), data.size());
+
+    corr.resize(rec.length);
+    for(int t=0; t < rec.length; ++t)
+      corr[t] = cmplx(Double(data[rec.ncomp*t]), 
+		      Double((rec.ncomp == 2) ? data[2*t+1] : 0.0));
+  }
+
+}  // end namespace Chroma
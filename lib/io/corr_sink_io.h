@@ -0,0 +1,137 @@
+// -*- C++ -*-
+/*! \file
+ *  \brief Appendable binary file of correlators
+ */
+
+#ifndef __corr_sink_io_h__
+#define __corr_sink_io_h__
+
+#include "chromabase.h"
+
+#include <fstream>
+#include <vector>
+
+namespace Chroma
+{
+
+  //! Appendable binary file of correlators
+  /*!
+   * \ingroup io
+   *
+   * An alternative to writing correlators as nested xml. The file starts
+   * with a magic number and version, followed by records. Every record
+   * begins with its type and its payload length so a reader can index
+   * the file without reading the data. A metadata record holds an xml
+   * string describing the correlator records that follow it, up to the
+   * next metadata record. A correlator record holds a key, the number of
+   * components per time slice (1 real, 2 complex), the number of time
+   * slices, and the values in double precision. All numbers are big endian.
+   *
+   * Opening an existing file appends to it. Only the primary node writes.
+   */
+  class CorrSink
+  {
+  public:
+    //! Open for appending, creating the file if needed
+    /*! Correlators are also written as xml when xml_p is true */
+    CorrSink(const std::string& file, bool xml_p);
+
+    //! Close
+    ~CorrSink();
+
+    //! Write correlators as xml too?
+    bool xmlOutput() const {return xml_p;}
+
+    //! Start a group of correlators described by xml
+    void writeMeta(XMLBufferWriter& xml);
+
+    //! Append a correlator
+    void write(const std::string& key, const multi1d<Real>& corr);
+
+    //! Append a correlator
+    void write(const std::string& key, const multi1d<Complex>& corr);
+
+    //! Append a correlator
+    void write(const std::string& key, const multi1d<DComplex>& corr);
+
+    //! Flush the file
+    void flush();
+
+  private:
+    //! Hide copies
+    CorrSink(const CorrSink&) {}
+
+    //! Append a correlator record
+    void writeCorr(const std::string& key, int ncomp, std::vector<double>& data);
+
+    std::ofstream  f;
+    std::string    file;
+    bool           xml_p;
+  };
+
+
+  //! Key of a correlator at a sink momentum
+  /*!
+   * \ingroup io
+   *
+   * Formed as  group/name=num/sink_mom=px,py,pz
+   */
+  std::string corrKey(const std::string& group, const std::string& name, int num,
+		      const multi1d<int>& sink_mom);
+
+
+  //! Index over a correlator file written by CorrSink
+  /*!
+   * \ingroup io
+   *
+   * Scans the record headers on construction. Reads on the calling node
+   * only, as meant for analysis programs.
+   */
+  class CorrSinkReader
+  {
+  public:
+    //! Index the file
+    CorrSinkReader(const std::string& file);
+
+    //! Number of metadata records
+    int numGroups() const {return group_xml.size();}
+
+    //! The metadata of a group
+    const std::string& groupXML(int g) const {return group_xml[g];}
+
+    //! Number of correlator records
+    int numRecords() const {return records.size();}
+
+    //! Key of a record
+    const std::string& key(int r) const {return records[r].key;}
+
+    //! Group of a record, -1 if it precedes all metadata
+    int group(int r) const {return records[r].group;}
+
+    //! Number of time slices of a record
+    int length(int r) const {return records[r].length;}
+
+    //! First record with key in group g, or -1
+    int find(const std::string& key, int g) const;
+
+    //! Read a correlator, a real one has zero imaginary parts
+    void read(int r, multi1d<DComplex>& corr);
+
+  private:
+    struct Record_t
+    {
+      std::string     key;
+      int             group;
+      int             ncomp;
+      int             length;
+      std::streamoff  offset;    /*!< offset of the values */
+    };
+
+    std::ifstream             f;
+    std::vector<std::string>  group_xml;
+    std::vector<Record_t>     records;
+  };
+
+}  // end namespace Chroma
+
+#endif
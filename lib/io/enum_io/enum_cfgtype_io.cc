@@ -32,6 +32,7 @@ namespace Chroma {
       success &= theCfgTypeMap::Instance().registerPair( string("CLASSICAL_SF"), CFG_TYPE_CLASSICAL_SF);
       
       success = theCfgTypeMap::Instance().registerPair(string("MILC_DOUBLE"), CFG_TYPE_MILC_DOUBLE );
+      success &= theCfgTypeMap::Instance().registerPair( string("COMPACT"), CFG_TYPE_COMPACT );
       return success;
     }
 
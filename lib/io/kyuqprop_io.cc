@@ -9,9 +9,47 @@
 #include "util/ferm/transf.h"
 #include "util/ferm/diractodr.h"
 #include "util/ft/sftmom.h"
+#include "io/slab_io.h"
+#include "handle.h"
+
+#include "qdp_util.h"   // from QDP++
+
+#include <vector>
+#include <string.h>
 
 namespace Chroma {
 
+namespace KYUQpropEnv
+{
+  struct UnpackArgs
+  {
+    LatticeFermionD&          f;
+    const multi1d<int>&       sites;      /*!< node linear index of each packed site */
+    const std::vector<char>&  local_buf;  /*!< one real per site in slab order */
+    int                       spin;
+    int                       color;
+    int                       ri;         /*!< 0 for the real part, 1 for the imaginary */
+    bool                      swap;
+  };
+
+  void unpackSiteLoop(int lo, int hi, int myId, UnpackArgs* a)
+  {
+    for(int j=lo; j < hi; ++j)
+    {
+      REAL64 v;
+      memcpy(&v, &(a->local_buf[j*sizeof(REAL64)]), sizeof(REAL64));
+
+      if (a->swap)
+	QDPUtil::byte_swap((void *)&v, sizeof(REAL64), 1);
+
+      if (a->ri == 0)
+	a->f.elem(a->sites[j]).elem(a->spin).elem(a->color).real() = v;
+      else
+	a->f.elem(a->sites[j]).elem(a->spin).elem(a->color).imag() = v;
+    }
+  }
+}
+
 //! Read a Kentucky quark propagator
 /*!
  * \ingroup io
@@ -43,40 +81,46 @@ void readKYUQprop(LatticePropagator& q, const string& file)
      x is fastest (Fortran Order)
   */
   // KYU always uses 64 bits
+  //
+  // Each real field is read raw a timeslice at a time on the primary node,
+  // scattered to its owners in one go and stored straight into the
+  // spin-color component. The file is big endian; fix up the byte order 
+  // on the way in.
   LatticePropagatorD q_old;
   multi2d<LatticeFermionD> source(Nc,Ns);
-  multi2d<LatticeRealD> re(Nc,Ns);
-  multi2d<LatticeRealD> im(Nc,Ns);
-  LatticeFermionD f;
-  LatticeColorVectorD  cv;
+
+  const bool swap = ! QDPUtil::big_endian();
+  const int nt = Layout::lattSize()[Nd-1];
+  const int vs = Layout::vol() / nt;
+
+  multi1d< Handle<SiteSlab> > slabs(nt);
+  for(int t=0; t < nt; ++t)
+  {
+    multi1d<int> lex(vs);
+    for(int i=0; i < vs; ++i)
+      lex[i] = t*vs + i;
+
+    slabs[t] = new SiteSlab(lex);
+  }
+
+  std::vector<char> local_buf;
 
   for(int src_spin=0; src_spin < Ns; ++src_spin)
     for(int src_color=0; src_color < Nc; ++src_color)
     {
-      for(int snk_spin=0; snk_spin < Ns; ++snk_spin)
-	for(int snk_color=0; snk_color < Nc; ++snk_color)
-	{
-	  read(bin, re(snk_color,snk_spin));
-	}
-
-      for(int snk_spin=0; snk_spin < Ns; ++snk_spin)
-	for(int snk_color=0; snk_color < Nc; ++snk_color)
-	{
-	  read(bin, im(snk_color,snk_spin));
-	}
-
-      // Stuff into a fermion
-      for(int snk_spin=0; snk_spin < Ns; ++snk_spin)
-      {
-	for(int snk_color=0; snk_color < Nc; ++snk_color)
-	{
-	  pokeColor(cv, 
-		    cmplx(re(snk_color,snk_spin), im(snk_color,snk_spin)),
-		    snk_color);
-	}
-
-	pokeSpin(f, cv, snk_spin);
-      }
+      LatticeFermionD f;
+
+      for(int ri=0; ri < 2; ++ri)
+	for(int snk_spin=0; snk_spin < Ns; ++snk_spin)
+	  for(int snk_color=0; snk_color < Nc; ++snk_color)
+	    for(int t=0; t < nt; ++t)
+	    {
+	      readSlab(bin, *(slabs[t]), sizeof(REAL64), local_buf);
+
+	      KYUQpropEnv::UnpackArgs a = {f, slabs[t]->localSites(), local_buf, 
+					   snk_spin, snk_color, ri, swap};
+	      dispatch_to_threads(slabs[t]->numLocalSites(), a, KYUQpropEnv::unpackSiteLoop);
+	    }
 
       // Hold temporarily in a multi2d - will need to rearrange src_spin later
       source(src_color,src_spin) = f;
@@ -6,6 +6,7 @@
 
 #include "chromabase.h"
 #include "io/milc_io.h"
+#include "io/slab_io.h"
 #include <time.h>
 
 namespace Chroma 
@@ -63,4 +64,93 @@ namespace Chroma
     pop(xml);
   }
 
+
+  namespace
+  {
+    //! Rotate left, with a zero rotation leaving the word alone as in MILC
+    inline unsigned int rotl(unsigned int val, int r)
+    {
+      return (r == 0) ? val : ((val << r) | (val >> (32-r)));
+    }
+
+    struct ChecksumArgs
+    {
+      const multi1d<LatticeColorMatrixF>& u;
+      const multi1d<int>&                 lex;    /*!< lexicographic index of each node site */
+      multi1d<unsigned int>&              sum29;  /*!< per thread */
+      multi1d<unsigned int>&              sum31;  /*!< per thread */
+    };
+
+    void checksumSiteLoop(int lo, int hi, int myId, ChecksumArgs* a)
+    {
+      const int site_words = Nd*2*Nc*Nc;
+      unsigned int s29 = 0;
+      unsigned int s31 = 0;
+
+      for(int site=lo; site < hi; ++site)
+      {
+	// The rank of the first word of the site in the file
+	unsigned long rank = (unsigned long)(a->lex[site]) * site_words;
+	int r29 = rank % 29;
+	int r31 = rank % 31;
+
+	for(int mu=0; mu < Nd; ++mu)
+	{
+	  const unsigned int* val = (const unsigned int*)&(a->u[mu].elem(site).elem());
+
+	  for(int k=0; k < 2*Nc*Nc; ++k)
+	  {
+	    s29 ^= rotl(val[k], r29);
+	    s31 ^= rotl(val[k], r31);
+
+	    if (++r29 == 29) r29 = 0;
+	    if (++r31 == 31) r31 = 0;
+	  }
+	}
+      }
+
+      a->sum29[myId] ^= s29;
+      a->sum31[myId] ^= s31;
+    }
+  }
+
+
+  // MILC checksums of a gauge field
+  void milcChecksums(const multi1d<LatticeColorMatrixF>& u, 
+		     unsigned int& sum29, unsigned int& sum31)
+  {
+    START_CODE();
+
+    const int nodeSites = Layout::sitesOnNode();
+
+    multi1d<int> lex(nodeSites);
+    for(int site=0; site < nodeSites; ++site)
+      lex[site] = local_site(Layout::siteCoords(Layout::nodeNumber(), site), 
+			     Layout::lattSize());
+
+    multi1d<unsigned int> s29(qdpNumThreads());
+    multi1d<unsigned int> s31(qdpNumThreads());
+    s29 = 0;
+    s31 = 0;
+
+    ChecksumArgs a = {u, lex, s29, s31};
+    dispatch_to_threads(nodeSites, a, checksumSiteLoop);
+
+    sum29 = 0;
+    sum31 = 0;
+    for(int i=0; i < s29.size(); ++i)
+    {
+      sum29 ^= s29[i];
+      sum31 ^= s31[i];
+    }
+
+    // Combine the nodes
+    unsigned int sums[2] = {sum29, sum31};
+    globalXor(sums, 2);
+    sum29 = sums[0];
+    sum31 = sums[1];
+
+    END_CODE();
+  }
+
 }  // end namespace Chroma
@@ -28,6 +28,21 @@ void read(XMLReader& xml, const std::string& path, MILCGauge_t& header);
 //! Source header writer
 void write(XMLWriter& xml, const std::string& path, const MILCGauge_t& header);
 
+//! MILC checksums of a gauge field
+/*!
+ * \ingroup io
+ *
+ * Computes the sum29 and sum31 checksums of the 1997 format. The 32 bit
+ * words of the field are taken in host byte order, each site holding
+ * its Nd matrices in turn as in the file.
+ *
+ * \param u          gauge configuration ( Read )
+ * \param sum29      checksum with rotation modulo 29 ( Write )
+ * \param sum31      checksum with rotation modulo 31 ( Write )
+ */
+void milcChecksums(const multi1d<LatticeColorMatrixF>& u, 
+		   unsigned int& sum29, unsigned int& sum31);
+
 }  // end namespace Chroma
 
 #endif
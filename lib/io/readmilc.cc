@@ -7,10 +7,42 @@
 #include "chromabase.h"
 #include "io/milc_io.h"
 #include "io/readmilc.h"
+#include "io/slab_io.h"
 #include "qdp_util.h"    // from QDP
 
+#include <vector>
+#include <string.h>
+
 namespace Chroma {
 
+namespace ReadMILCEnv
+{
+  struct UnpackArgs
+  {
+    multi1d<LatticeColorMatrixF>& u;
+    const multi1d<int>&           sites;      /*!< node linear index of each packed site */
+    const std::vector<char>&      local_buf;  /*!< Nd matrices per site, in slab order */
+    bool                          swap;
+  };
+
+  void unpackSiteLoop(int lo, int hi, int myId, UnpackArgs* a)
+  {
+    const size_t mat_bytes = 2*Nc*Nc*sizeof(REAL32);
+
+    for(int j=lo; j < hi; ++j)
+    {
+      for(int mu=0; mu < Nd; ++mu)
+      {
+	void* dest = (void *)&(a->u[mu].elem(a->sites[j]).elem());
+	memcpy(dest, &(a->local_buf[(j*Nd + mu)*mat_bytes]), mat_bytes);
+
+	if (a->swap)
+	  QDPUtil::byte_swap(dest, sizeof(REAL32), 2*Nc*Nc);
+      }
+    }
+  }
+}
+
 //! Read a MILC configuration file
 /*!
  * \ingroup io
@@ -67,7 +99,7 @@ void readMILC(MILCGauge_t& header, multi1d<LatticeColorMatrixF>& u, const string
     QDP_error_exit("readMILC: only support non-sitelist format");
 
 
-  // Go ahead an read checksums, but will not use for now
+  // Checksums, verified once the links are in
   unsigned int sum29, sum31;
   read(cfg_in, sum29);
   read(cfg_in, sum31);
@@ -80,27 +112,50 @@ void readMILC(MILCGauge_t& header, multi1d<LatticeColorMatrixF>& u, const string
   /*
    * Read away...
    */
-  
-  // MILC format has the directions inside the sites
-  for(int site=0; site < Layout::vol(); ++site)
+
+  // The links are read raw a timeslice at a time on the primary node and
+  // scattered to their owners in one go. The file is big endian unless the
+  // magic number needed reversal; fix up the byte order on the way in.
+  bool swap = (!byterev) != QDPUtil::big_endian();
+
+  const int vs = Layout::vol() / Layout::lattSize()[Nd-1];
+  const size_t site_bytes = Nd*2*Nc*Nc*sizeof(REAL32);
+
+  std::vector<char> local_buf;
+
+  for(int t=0; t < Layout::lattSize()[Nd-1]; ++t)
   {
-    multi1d<int> coord = crtesn(site, Layout::lattSize()); // The coordinate
-      
-    // Read in Nd SU(3) matrices. 
-    // NOTE: the su3_matrix layout should be the same as in QDP
-    for(int mu=0; mu < Nd; ++mu)
-      read(cfg_in, u[mu], coord);    // read in a single site
+    // MILC format has the directions inside the sites, x fastest
+    multi1d<int> lex(vs);
+    for(int i=0; i < vs; ++i)
+      lex[i] = t*vs + i;
+
+    SiteSlab slab(lex);
+    readSlab(cfg_in, slab, site_bytes, local_buf);
+
+    ReadMILCEnv::UnpackArgs a = {u, slab.localSites(), local_buf, swap};
+    dispatch_to_threads(slab.numLocalSites(), a, ReadMILCEnv::unpackSiteLoop);
   }
 
   cfg_in.close();
-  
-  //QDPUtil::byte_swap((void *)&buf[0], sizeof(Real64), latt_size[0]*Nc*Nc*2 );
-  if(byterev){
-    QDPIO::cout<<"Doing bytereversal on the links...\n" ;
-    for(int mu(0);mu<Nd;mu++)
-      //slow but hopefully it works
-      for(int s(0); s < Layout::sitesOnNode(); s++)
-	QDPUtil::byte_swap((void *)&u[mu].elem(s).elem(),sizeof(Real),2*Nc*Nc);
+
+  // Older writers left the checksums zero
+  if (sum29 == 0 && sum31 == 0)
+  {
+    QDPIO::cout << "readMILC: file carries no checksums, not verified" << endl;
+  }
+  else
+  {
+    unsigned int my29, my31;
+    milcChecksums(u, my29, my31);
+
+    if (my29 != sum29 || my31 != sum31)
+    {
+      QDPIO::cerr << "readMILC: checksum mismatch: file (sum29, sum31) = (" 
+		  << sum29 << ", " << sum31 << ")  computed = (" 
+		  << my29 << ", " << my31 << ")" << endl;
+      QDP_abort(1);
+    }
   }
 
   END_CODE();
@@ -6,15 +6,43 @@
 
 #include "chromabase.h"
 #include "io/readszinqprop_w.h"
+#include "io/slab_io.h"
 
 #include "qdp_util.h"   // from QDP++
 
 #include <iostream>
 #include <string>
 #include <sstream>
+#include <vector>
+#include <string.h>
 
 namespace Chroma {
 
+namespace SzinQpropEnv
+{
+  struct UnpackArgs
+  {
+    LatticePropagator&        q;
+    const multi1d<int>&       sites;      /*!< node linear index of each packed site */
+    const std::vector<char>&  local_buf;  /*!< site propagators in slab order */
+    bool                      swap;
+  };
+
+  void unpackSiteLoop(int lo, int hi, int myId, UnpackArgs* a)
+  {
+    const size_t site_bytes = Ns*Ns*Nc*Nc*2*sizeof(REAL);
+
+    for(int j=lo; j < hi; ++j)
+    {
+      void* dest = (void *)&(a->q.elem(a->sites[j]));
+      memcpy(dest, &(a->local_buf[j*site_bytes]), site_bytes);
+
+      if (a->swap)
+	QDPUtil::byte_swap(dest, sizeof(REAL), Ns*Ns*Nc*Nc*2);
+    }
+  }
+}
+
 //! Read a SZIN propagator file. This is a simple memory dump reader.
 /*!
  * \ingroup io
@@ -40,23 +68,45 @@ void readSzinQprop(XMLReader& xml, LatticePropagator& q, const string& file)
   read(cfg_in, Kappa);
 
   // Read prop
+  //
+  // The sites are read raw a checkerboarded timeslice at a time on the
+  // primary node and scattered to their owners in one go. The file is big
+  // endian; fix up the byte order on the way in.
   LatticePropagator  q_old;
 
+  const bool swap = ! QDPUtil::big_endian();
+  const int nt = lattsize_cb[Nd-1];
+  const int vs_cb = Layout::vol()/2/nt;
+  const size_t site_bytes = Ns*Ns*Nc*Nc*2*sizeof(REAL);
+
+  std::vector<char> local_buf;
+
   for(int cb=0; cb < 2; ++cb)
   {
-    for(int sitecb=0; sitecb < Layout::vol()/2; ++sitecb)
+    for(int t=0; t < nt; ++t)
     {
-      multi1d<int> coord = crtesn(sitecb, lattsize_cb);
+      multi1d<int> lex(vs_cb);
 
-      // construct the checkerboard offset
-      int sum = 0;
-      for(int m=1; m<Nd; m++)
-	sum += coord[m];
+      for(int i=0; i < vs_cb; ++i)
+      {
+	multi1d<int> coord = crtesn(t*vs_cb + i, lattsize_cb);
 
-      // The true lattice x-coord
-      coord[0] = 2*coord[0] + ((sum + cb) & 1);
+	// construct the checkerboard offset
+	int sum = 0;
+	for(int m=1; m<Nd; m++)
+	  sum += coord[m];
+
+	// The true lattice x-coord
+	coord[0] = 2*coord[0] + ((sum + cb) & 1);
+
+	lex[i] = local_site(coord, Layout::lattSize());
+      }
+
+      SiteSlab slab(lex);
+      readSlab(cfg_in, slab, site_bytes, local_buf);
 
-      read(cfg_in, q_old, coord); 	// Read in a site propagator
+      SzinQpropEnv::UnpackArgs a = {q_old, slab.localSites(), local_buf, swap};
+      dispatch_to_threads(slab.numLocalSites(), a, SzinQpropEnv::unpackSiteLoop);
     }
   }
 
@@ -0,0 +1,72 @@
+/*! \file
+ *  \brief Threaded SciDAC checksums of lattice fields
+ */
+
+#include "io/scidac_checksum.h"
+
+#include <cstdio>
+
+namespace Chroma
+{
+
+  // Write the checksum as the hex strings used in a QIO record
+  void write(XMLWriter& xml, const std::string& path, const ScidacChecksum_t& sum)
+  {
+    char a[16], b[16];
+    sprintf(a, "%x", sum.suma);
+    sprintf(b, "%x", sum.sumb);
+
+    push(xml, path);
+    write(xml, "suma", std::string(a));
+    write(xml, "sumb", std::string(b));
+    pop(xml);
+  }
+
+
+  namespace
+  {
+    //! Table of the reflected polynomial 0xedb88320
+    struct CRCTable
+    {
+      unsigned int t[256];
+
+      CRCTable()
+      {
+	for(unsigned int n=0; n < 256; ++n)
+	{
+	  unsigned int c = n;
+	  for(int k=0; k < 8; ++k)
+	    c = (c & 1) ? (0xedb88320U ^ (c >> 1)) : (c >> 1);
+	  t[n] = c;
+	}
+      }
+    };
+
+    // Built before any threads are started
+    const CRCTable crc_table;
+  }
+
+
+  // CRC32 as in zlib, continuing from crc
+  unsigned int scidacCRC32(unsigned int crc, const unsigned char* buf, size_t len)
+  {
+    crc = crc ^ 0xffffffffU;
+    for(size_t i=0; i < len; ++i)
+      crc = crc_table.t[(crc ^ buf[i]) & 0xff] ^ (crc >> 8);
+
+    return crc ^ 0xffffffffU;
+  }
+
+
+  // Lexicographic rank of each site on this node, x fastest
+  void nodeLexIndices(multi1d<int>& lex)
+  {
+    const int nodeSites = Layout::sitesOnNode();
+
+    lex.resize(nodeSites);
+    for(int site=0; site < nodeSites; ++site)
+      lex[site] = local_site(Layout::siteCoords(Layout::nodeNumber(), site),
+			     Layout::lattSize());
+  }
+
+}  // end namespace Chroma
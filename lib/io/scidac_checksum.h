@@ -0,0 +1,159 @@
+// -*- C++ -*-
+/*! \file
+ *  \brief Threaded SciDAC checksums of lattice fields
+ *
+ *  Computes in Chroma the checksum QIO stores with a record, so a writer
+ *  can report it for verification. This is an extra pass over the field;
+ *  the byte swap and checksum QIO does while writing or reading are not
+ *  changed. QIO does those itself on the site buffers that the QDP++
+ *  get and put callbacks hand it, so staging converted buffers in Chroma
+ *  would not save QIO any work.
+ */
+
+#ifndef __scidac_checksum_h__
+#define __scidac_checksum_h__
+
+#include "chromabase.h"
+#include "io/slab_io.h"
+
+#include <cstring>
+#include <vector>
+
+namespace Chroma
+{
+
+  //! SciDAC checksum of a record
+  /*! \ingroup io */
+  struct ScidacChecksum_t
+  {
+    unsigned int suma;
+    unsigned int sumb;
+  };
+
+  //! Write the checksum as the hex strings used in a QIO record
+  /*! \ingroup io */
+  void write(XMLWriter& xml, const std::string& path, const ScidacChecksum_t& sum);
+
+
+  //! CRC32 as in zlib, continuing from crc
+  /*! \ingroup io */
+  unsigned int scidacCRC32(unsigned int crc, const unsigned char* buf, size_t len);
+
+  //! Lexicographic rank of each site on this node, x fastest
+  /*! \ingroup io */
+  void nodeLexIndices(multi1d<int>& lex);
+
+
+  //! Thread kernels of the checksum
+  namespace ScidacChecksumEnv
+  {
+    template<typename T>
+    struct ChecksumArgs
+    {
+      const OLattice<T>* const*      x;      /*!< the fields of the record */
+      int                            n;      /*!< number of fields */
+      const multi1d<int>&            lex;    /*!< lexicographic rank of each node site */
+      multi1d<unsigned int>&         suma;   /*!< per thread */
+      multi1d<unsigned int>&         sumb;   /*!< per thread */
+    };
+
+    //! Rotate left, with a zero rotation leaving the word alone
+    inline unsigned int rotl(unsigned int val, int r)
+    {
+      return (r == 0) ? val : ((val << r) | (val >> (32-r)));
+    }
+
+    template<typename T>
+    void checksumSiteLoop(int lo, int hi, int myId, ChecksumArgs<T>* a)
+    {
+      typedef typename WordType<T>::Type_t W;
+
+      const int n = a->n;
+      const size_t site_bytes = n*sizeof(T);
+      std::vector<unsigned char> buf(site_bytes);
+
+      unsigned int sa = 0;
+      unsigned int sb = 0;
+
+      for(int site=lo; site < hi; ++site)
+      {
+	// The site record as in the file: the array elements in turn, big endian
+	for(int i=0; i < n; ++i)
+	  std::memcpy(&buf[i*sizeof(T)], &(a->x[i]->elem(site)), sizeof(T));
+
+	if (! QDPUtil::big_endian())
+	  QDPUtil::byte_swap(&buf[0], sizeof(W), site_bytes / sizeof(W));
+
+	unsigned int crc = scidacCRC32(0, &buf[0], site_bytes);
+	sa ^= rotl(crc, a->lex[site] % 29);
+	sb ^= rotl(crc, a->lex[site] % 31);
+      }
+
+      a->suma[myId] ^= sa;
+      a->sumb[myId] ^= sb;
+    }
+  }
+
+
+  //! SciDAC checksum of an array of fields written as one record
+  /*! \ingroup io
+   *
+   * The checksum QIO stores with a record whose sites hold the n fields
+   * of x in turn, in the precision of T. The sites are split over threads and
+   * the nodes combined with globalXor.
+   */
+  template<typename T>
+  void scidacChecksum(const OLattice<T>* const* x, int n, ScidacChecksum_t& sum)
+  {
+    START_CODE();
+
+    multi1d<int> lex;
+    nodeLexIndices(lex);
+
+    multi1d<unsigned int> sa(qdpNumThreads());
+    multi1d<unsigned int> sb(qdpNumThreads());
+    sa = 0;
+    sb = 0;
+
+    ScidacChecksumEnv::ChecksumArgs<T> a = {x, n, lex, sa, sb};
+    dispatch_to_threads(Layout::sitesOnNode(), a, ScidacChecksumEnv::checksumSiteLoop<T>);
+
+    unsigned int sums[2] = {0, 0};
+    for(int i=0; i < sa.size(); ++i)
+    {
+      sums[0] ^= sa[i];
+      sums[1] ^= sb[i];
+    }
+
+    // Combine the nodes
+    globalXor(sums, 2);
+    sum.suma = sums[0];
+    sum.sumb = sums[1];
+
+    END_CODE();
+  }
+
+  //! SciDAC checksum of a field
+  /*! \ingroup io */
+  template<typename T>
+  void scidacChecksum(const OLattice<T>& x, ScidacChecksum_t& sum)
+  {
+    const OLattice<T>* px = &x;
+    scidacChecksum(&px, 1, sum);
+  }
+
+  //! SciDAC checksum of an array of fields written as one record
+  /*! \ingroup io */
+  template<typename T>
+  void scidacChecksum(const multi1d< OLattice<T> >& x, ScidacChecksum_t& sum)
+  {
+    std::vector<const OLattice<T>*> px(x.size());
+    for(int i=0; i < x.size(); ++i)
+      px[i] = &x[i];
+
+    scidacChecksum(px.empty() ? 0 : &px[0], x.size(), sum);
+  }
+
+}  // end namespace Chroma
+
+#endif
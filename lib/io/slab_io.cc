@@ -0,0 +1,208 @@
+/*! \file
+ *  \brief Move slabs of sites between a file buffer on the primary node and their owners
+ */
+
+#include "io/slab_io.h"
+
+#include <string.h>
+
+namespace Chroma
+{
+
+  // Construct from the lexicographic indices of the slab sites in file order
+  SiteSlab::SiteSlab(const multi1d<int>& lex_sites)
+  {
+    START_CODE();
+
+    const int me = Layout::nodeNumber();
+    const int nsites = lex_sites.size();
+
+    owner.resize(nsites);
+    node_offset.resize(Layout::numNodes()+1);
+    node_offset = 0;
+
+    int nlocal = 0;
+    for(int k=0; k < nsites; ++k)
+    {
+      multi1d<int> coord = crtesn(lex_sites[k], Layout::lattSize());
+      owner[k] = Layout::nodeNumber(coord);
+      node_offset[owner[k]+1]++;
+
+      if (owner[k] == me)
+	++nlocal;
+    }
+
+    for(int n=0; n < Layout::numNodes(); ++n)
+      node_offset[n+1] += node_offset[n];
+
+    // Group the slab sites by owning node, keeping slab order within a node
+    node_order.resize(nsites);
+    local_sites.resize(nlocal);
+    local_lex.resize(nlocal);
+    {
+      multi1d<int> fill(Layout::numNodes());
+      for(int n=0; n < Layout::numNodes(); ++n)
+	fill[n] = node_offset[n];
+
+      int j = 0;
+      for(int k=0; k < nsites; ++k)
+      {
+	node_order[fill[owner[k]]++] = k;
+
+	if (owner[k] == me)
+	{
+	  multi1d<int> coord = crtesn(lex_sites[k], Layout::lattSize());
+	  local_sites[j] = Layout::linearSiteIndex(coord);
+	  local_lex[j++] = lex_sites[k];
+	}
+      }
+    }
+
+    END_CODE();
+  }
+
+
+  // Send every node its part of buf
+  void SiteSlab::scatter(const char* buf, char* local_buf, size_t site_bytes) const
+  {
+    START_CODE();
+
+    const int me = Layout::nodeNumber();
+
+    if (Layout::primaryNode())
+    {
+      for(int i=node_offset[me], j=0; i < node_offset[me+1]; ++i, ++j)
+	memcpy(local_buf + j*site_bytes, buf + node_order[i]*site_bytes, site_bytes);
+    }
+
+#if defined(ARCH_PARSCALAR)
+    std::vector<char> pack;
+
+    for(int n=1; n < Layout::numNodes(); ++n)
+    {
+      const int count = node_offset[n+1] - node_offset[n];
+      if (count == 0)
+	continue;
+
+      if (Layout::primaryNode())
+      {
+	pack.resize(count*site_bytes);
+	for(int i=node_offset[n], j=0; i < node_offset[n+1]; ++i, ++j)
+	  memcpy(&pack[j*site_bytes], buf + node_order[i]*site_bytes, site_bytes);
+
+	QDPInternal::sendToWait((void *)&pack[0], n, count*site_bytes);
+      }
+      else if (me == n)
+      {
+	QDPInternal::recvFromWait((void *)local_buf, 0, count*site_bytes);
+      }
+    }
+#endif
+
+    END_CODE();
+  }
+
+
+  // Collect the local parts into buf on the primary node
+  void SiteSlab::gather(const char* local_buf, char* buf, size_t site_bytes) const
+  {
+    START_CODE();
+
+    const int me = Layout::nodeNumber();
+
+    if (Layout::primaryNode())
+    {
+      for(int i=node_offset[me], j=0; i < node_offset[me+1]; ++i, ++j)
+	memcpy(buf + node_order[i]*site_bytes, local_buf + j*site_bytes, site_bytes);
+    }
+
+#if defined(ARCH_PARSCALAR)
+    std::vector<char> pack;
+
+    for(int n=1; n < Layout::numNodes(); ++n)
+    {
+      const int count = node_offset[n+1] - node_offset[n];
+      if (count == 0)
+	continue;
+
+      if (Layout::primaryNode())
+      {
+	pack.resize(count*site_bytes);
+	QDPInternal::recvFromWait((void *)&pack[0], n, count*site_bytes);
+
+	for(int i=node_offset[n], j=0; i < node_offset[n+1]; ++i, ++j)
+	  memcpy(buf + node_order[i]*site_bytes, &pack[j*site_bytes], site_bytes);
+      }
+      else if (me == n)
+      {
+	QDPInternal::sendToWait((void *)local_buf, 0, count*site_bytes);
+      }
+    }
+#endif
+
+    END_CODE();
+  }
+
+
+  // Read a slab on the primary node and hand every node its sites
+  void readSlab(BinaryReader& bin, const SiteSlab& slab, size_t site_bytes,
+		std::vector<char>& local_buf)
+  {
+    START_CODE();
+
+    std::vector<char> buf;
+    if (Layout::primaryNode())
+    {
+      buf.resize(slab.numSites()*site_bytes);
+      bin.readArrayPrimaryNode(&buf[0], 1, buf.size());
+    }
+
+    local_buf.resize(slab.numLocalSites()*site_bytes);
+    slab.scatter((buf.size() > 0) ? &buf[0] : 0,
+		 (local_buf.size() > 0) ? &local_buf[0] : 0, site_bytes);
+
+    END_CODE();
+  }
+
+
+  // Collect the slab from its owners and write it on the primary node
+  void writeSlab(BinaryWriter& bin, const SiteSlab& slab, size_t site_bytes,
+		 const std::vector<char>& local_buf)
+  {
+    START_CODE();
+
+    std::vector<char> buf;
+    if (Layout::primaryNode())
+      buf.resize(slab.numSites()*site_bytes);
+
+    slab.gather((local_buf.size() > 0) ? &local_buf[0] : 0,
+		(buf.size() > 0) ? &buf[0] : 0, site_bytes);
+
+    if (Layout::primaryNode())
+      bin.writeArray(&buf[0], 1, buf.size());
+
+    END_CODE();
+  }
+
+
+  // Exclusive or of an array of words over all nodes
+  void globalXor(unsigned int* w, int n)
+  {
+    // An exclusive or is the parity of each bit, so a global sum 
+    // of the bits suffices
+    multi1d<double> bits(32*n);
+    for(int i=0; i < n; ++i)
+      for(int b=0; b < 32; ++b)
+	bits[32*i+b] = (w[i] >> b) & 1;
+
+    QDPInternal::globalSumArray(bits.slice(), bits.size());
+
+    for(int i=0; i < n; ++i)
+    {
+      w[i] = 0;
+      for(int b=0; b < 32; ++b)
+	w[i] |= (((unsigned int)(bits[32*i+b])) & 1) << b;
+    }
+  }
+
+}  // end namespace Chroma
@@ -0,0 +1,118 @@
+// -*- C++ -*-
+/*! \file
+ *  \brief Move slabs of sites between a file buffer on the primary node and their owners
+ */
+
+#ifndef __slab_io_h__
+#define __slab_io_h__
+
+#include "chromabase.h"
+#include <vector>
+#include <string.h>
+
+namespace Chroma
+{
+
+  //! A slab of lattice sites in file order
+  /*! \ingroup io
+   *
+   * The slab is a list of sites, given by their lexicographic index
+   * (x fastest), in the order they appear in a file. The corresponding
+   * file buffer holds site_bytes per site and lives on the primary node.
+   *
+   * scatter() hands every node the bytes of the slab sites it owns and
+   * gather() collects them back onto the primary node. Either way a node
+   * exchanges one message per slab rather than one per site. On a node the
+   * data is packed in slab order; localSites() gives the node linear
+   * index of each packed site.
+   */
+  class SiteSlab
+  {
+  public:
+    //! Construct from the lexicographic indices of the slab sites in file order
+    SiteSlab(const multi1d<int>& lex_sites);
+
+    //! Number of sites in the slab
+    int numSites() const {return owner.size();}
+
+    //! Number of slab sites held by this node
+    int numLocalSites() const {return local_sites.size();}
+
+    //! Node linear index of each slab site held by this node, in slab order
+    const multi1d<int>& localSites() const {return local_sites;}
+
+    //! Lexicographic index of each slab site held by this node, in slab order
+    const multi1d<int>& localLexSites() const {return local_lex;}
+
+    //! Send every node its part of buf
+    /*! buf holds numSites()*site_bytes and is only referenced on the primary node.
+     *  local_buf holds numLocalSites()*site_bytes. */
+    void scatter(const char* buf, char* local_buf, size_t site_bytes) const;
+
+    //! Collect the local parts into buf on the primary node
+    /*! Same layouts as scatter() */
+    void gather(const char* local_buf, char* buf, size_t site_bytes) const;
+
+  private:
+    multi1d<int> owner;        /*!< node owning each slab site */
+    multi1d<int> node_offset;  /*!< start of each node's sites within node_order */
+    multi1d<int> node_order;   /*!< slab indices grouped by owning node */
+    multi1d<int> local_sites;  /*!< node linear index of the slab sites on this node */
+    multi1d<int> local_lex;    /*!< lexicographic index of the slab sites on this node */
+  };
+
+
+  //! Read a slab on the primary node and hand every node its sites
+  /*! \ingroup io
+   *
+   * On return local_buf holds slab.numLocalSites()*site_bytes in file
+   * byte order.
+   */
+  void readSlab(BinaryReader& bin, const SiteSlab& slab, size_t site_bytes,
+		std::vector<char>& local_buf);
+
+  //! Collect the slab from its owners and write it on the primary node
+  /*! \ingroup io
+   *
+   * local_buf holds slab.numLocalSites()*site_bytes in file byte order.
+   */
+  void writeSlab(BinaryWriter& bin, const SiteSlab& slab, size_t site_bytes,
+		 const std::vector<char>& local_buf);
+
+  //! Collect a whole lattice field onto the primary node in lexicographic order
+  /*! \ingroup io
+   *
+   * One gather of the field, one message per node. slab must hold every
+   * site in lexicographic order. On the primary node buf then holds the
+   * sites x fastest in big endian words, as QDP writes a lattice field,
+   * so the time slices of direction Nd-1 follow each other and slice t
+   * is what QDP writes for the sites of that slice alone.
+   */
+  template<typename T>
+  void gatherLexico(const OLattice<T>& f, const SiteSlab& slab, std::vector<char>& buf)
+  {
+    typedef typename WordType<T>::Type_t W;
+    const size_t site_bytes = sizeof(T);
+
+    std::vector<char> local_buf(slab.numLocalSites()*site_bytes);
+    for(int j=0; j < slab.numLocalSites(); ++j)
+      memcpy(&local_buf[j*site_bytes], (const void *)&(f.elem(slab.localSites()[j])), site_bytes);
+
+    if (! QDPUtil::big_endian() && local_buf.size() > 0)
+      QDPUtil::byte_swap((void *)&local_buf[0], sizeof(W), local_buf.size()/sizeof(W));
+
+    buf.clear();
+    if (Layout::primaryNode())
+      buf.resize(slab.numSites()*site_bytes);
+
+    slab.gather((local_buf.size() > 0) ? &local_buf[0] : 0,
+		(buf.size() > 0) ? &buf[0] : 0, site_bytes);
+  }
+
+  //! Exclusive or of an array of words over all nodes
+  /*! \ingroup io */
+  void globalXor(unsigned int* w, int n);
+
+}  // end namespace Chroma
+
+#endif
@@ -7,14 +7,44 @@
 #include "chromabase.h"
 #include "io/milc_io.h"
 #include "io/writemilc.h"
+#include "io/slab_io.h"
 #include "qdp_util.h"    // from QDP
 
 #include <string>
+#include <vector>
 #include <string.h>
 using std::string;
 
 namespace Chroma {
 
+namespace WriteMILCEnv
+{
+  struct PackArgs
+  {
+    const multi1d<LatticeColorMatrixF>& u;
+    const multi1d<int>&                 sites;      /*!< node linear index of each packed site */
+    std::vector<char>&                  local_buf;  /*!< Nd matrices per site, in slab order */
+    bool                                swap;
+  };
+
+  void packSiteLoop(int lo, int hi, int myId, PackArgs* a)
+  {
+    const size_t mat_bytes = 2*Nc*Nc*sizeof(REAL32);
+
+    for(int j=lo; j < hi; ++j)
+    {
+      for(int mu=0; mu < Nd; ++mu)
+      {
+	char* dest = &(a->local_buf[(j*Nd + mu)*mat_bytes]);
+	memcpy(dest, &(a->u[mu].elem(a->sites[j]).elem()), mat_bytes);
+
+	if (a->swap)
+	  QDPUtil::byte_swap((void *)dest, sizeof(REAL32), 2*Nc*Nc);
+      }
+    }
+  }
+}
+
 //! Write a MILC configuration file
 /*!
  * \ingroup io
@@ -29,6 +59,16 @@ void writeMILC(const MILCGauge_t& header, const multi1d<LatticeColorMatrix>& u,
 {
   START_CODE();
 
+  // MILC configs only in single-prec
+  multi1d<LatticeColorMatrixF> uu(Nd);
+  for(int mu=0; mu < Nd; ++mu)
+    uu[mu] = u[mu];
+
+  // The checksums go in the header, so compute them first from the
+  // distributed field
+  unsigned int sum29, sum31;
+  milcChecksums(uu, sum29, sum31);
+
   BinaryFileWriter cfg_out(cfg_file); // for now, cfg_io_location not used
 
   int magic_number = 20103;
@@ -47,26 +87,34 @@ void writeMILC(const MILCGauge_t& header, const multi1d<LatticeColorMatrix>& u,
   int order = 0;
   write(cfg_out, order);
  
-  // Go ahead and write checksums, but will not use for now
-  unsigned int sum29=0, sum31=0;  // WARNING: these are BOGUS
   write(cfg_out, sum29);
   write(cfg_out, sum31);
 
   /*
    * Write away...
    */
-  
-  // MILC format has the directions inside the sites
-  for(int site=0; site < Layout::vol(); ++site)
+
+  // A timeslice at a time is packed on the owning nodes, gathered to the
+  // primary node and written raw. The file is big endian like the header.
+  bool swap = ! QDPUtil::big_endian();
+
+  const int vs = Layout::vol() / Layout::lattSize()[Nd-1];
+  const size_t site_bytes = Nd*2*Nc*Nc*sizeof(REAL32);
+
+  for(int t=0; t < Layout::lattSize()[Nd-1]; ++t)
   {
-    multi1d<int> coord = crtesn(site, Layout::lattSize()); // The coordinate
-      
-    // Write Nd SU(3) matrices. 
-    for(int j = 0; j < Nd; j++)
-    {
-      // NOTE: the su3_matrix layout should be the same as in QDP
-      write(cfg_out, u[j], coord); 
-    }
+    // MILC format has the directions inside the sites, x fastest
+    multi1d<int> lex(vs);
+    for(int i=0; i < vs; ++i)
+      lex[i] = t*vs + i;
+
+    SiteSlab slab(lex);
+
+    std::vector<char> local_buf(slab.numLocalSites()*site_bytes);
+    WriteMILCEnv::PackArgs a = {uu, slab.localSites(), local_buf, swap};
+    dispatch_to_threads(slab.numLocalSites(), a, WriteMILCEnv::packSiteLoop);
+
+    writeSlab(cfg_out, slab, site_bytes, local_buf);
   }
 
   cfg_out.close();
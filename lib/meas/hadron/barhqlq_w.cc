@@ -6,6 +6,7 @@
 
 #include "meas/hadron/barhqlq_w.h"
 #include "meas/hadron/barspinmat_w.h"
+#include "io/corr_sink_io.h"
 
 namespace Chroma 
 {
@@ -165,6 +166,7 @@ namespace Chroma
    * \param phases         object holds list of momenta and Fourier phases ( Read )
    * \param xml            xml file object ( Read )
    * \param xml_group      group name for xml data ( Read )
+   * \param sink           optional binary correlator file ( Write )
    *
    */
 
@@ -173,7 +175,8 @@ namespace Chroma
 	       const SftMom& phases,
 	       int t0, int bc_spec, bool time_rev,
 	       XMLWriter& xml,
-	       const string& xml_group)
+	       const string& xml_group,
+	       CorrSink* sink)
   {
     START_CODE();
 
@@ -257,6 +260,10 @@ namespace Chroma
 	}
 
 	write(xml_sink_mom, "barprop", barprop);
+
+	if (sink)
+	  sink->write(corrKey(xml_group, "baryon_num", baryons, phases.numToMom(sink_mom_num)), barprop);
+
 	pop(xml_sink_mom);
       } // end for(sink_mom_num)
  
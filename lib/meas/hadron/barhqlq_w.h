@@ -12,6 +12,7 @@
 
 namespace Chroma 
 {
+  class CorrSink;
 
   //! Baryon 2pt contractions
   /*! \ingroup hadron */
@@ -81,6 +82,7 @@ namespace Chroma
    * \param phases         object holds list of momenta and Fourier phases ( Read )
    * \param xml            xml file object ( Read )
    * \param xml_group      group name for xml data ( Read )
+   * \param sink           optional binary correlator file ( Write )
    *
    */
 
@@ -89,7 +91,8 @@ namespace Chroma
 	       const SftMom& phases,
 	       int t0, int bc_spec, bool time_rev,
 	       XMLWriter& xml,
-	       const string& xml_group);
+	       const string& xml_group,
+	       CorrSink* sink = 0);
 
 
 
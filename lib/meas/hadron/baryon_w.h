@@ -9,6 +9,8 @@
 
 namespace Chroma {
 
+class CorrSink;
+
 //! Baryon 2-pt functions
 /*!
  * \ingroup hadron
@@ -32,6 +34,7 @@ namespace Chroma {
  * \param phases     object holds list of momenta and Fourier phases ( Read )
  * \param xml        xml file object ( Read )
  * \param xml_group  group name for xml data ( Read )
+ * \param sink       optional binary correlator file ( Write )
  *
  */
 
@@ -39,7 +42,8 @@ void baryon(const LatticePropagator& quark_propagator,
             const SftMom& phases,
             int t0, int bc_spec, bool time_rev,
             XMLWriter& xml,
-	    const string& xml_group);
+	    const string& xml_group,
+	    CorrSink* sink = 0);
 
 
 //! Baryon 2-pt functions
@@ -79,6 +79,7 @@
 #include "chromabase.h"
 #include "util/ft/sftmom.h"
 #include "meas/hadron/mesons_w.h"
+#include "io/corr_sink_io.h"
 
 namespace Chroma {
 
@@ -95,6 +96,7 @@ namespace Chroma {
  * \param phases        object holds list of momenta and Fourier phases ( Read )
  * \param xml           xml file object ( Write )
  * \param xml_group     string used for writing xml data ( Read )
+ * \param sink          optional binary correlator file ( Write )
  *
  *        ____
  *        \
@@ -109,7 +111,8 @@ void mesons2(const LatticePropagator& quark_prop_1,
 	     const SftMom& phases,
 	     int t0,
 	     XMLWriter& xml,
-	     const string& xml_group)
+	     const string& xml_group,
+	     CorrSink* sink)
 {
   START_CODE();
 
@@ -162,6 +165,10 @@ void mesons2(const LatticePropagator& quark_prop_1,
       }
 
       write(xml_sink_mom, "mesprop", mesprop);
+
+      if (sink)
+        sink->write(corrKey(xml_group, "gamma_value", gamma_value, phases.numToMom(sink_mom_num)), mesprop);
+
       pop(xml_sink_mom);
 
     } // end for(sink_mom_num)
@@ -9,6 +9,8 @@
 
 namespace Chroma {
 
+class CorrSink;
+
 //! Meson 2-pt functions
 /* This routine is specific to Wilson fermions!
  *
@@ -21,6 +23,7 @@ namespace Chroma {
  * \param phases        object holds list of momenta and Fourier phases ( Read )
  * \param xml           xml file object ( Write )
  * \param xml_group     string used for writing xml data ( Read )
+ * \param sink          optional binary correlator file ( Write )
  *
  *        ____
  *        \
@@ -35,7 +38,8 @@ void mesons(const LatticePropagator& quark_prop_1,
             const SftMom& phases,
             int t0,
             XMLWriter& xml,
-            const string& xml_group) ;
+            const string& xml_group,
+            CorrSink* sink = 0) ;
 
 }  // end namespace Chroma
 
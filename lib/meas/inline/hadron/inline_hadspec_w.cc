@@ -5,6 +5,7 @@
  * Spectrum calculations
  */
 
+#include "handle.h"
 #include "meas/inline/hadron/inline_hadspec_w.h"
 #include "meas/inline/abs_inline_measurement_factory.h"
 #include "meas/glue/mesplq.h"
@@ -15,6 +16,7 @@
 #include "meas/hadron/mesons2_w.h"
 #include "meas/hadron/barhqlq_w.h"
 #include "meas/hadron/curcor2_w.h"
+#include "io/corr_sink_io.h"
 #include "meas/inline/make_xml_file.h"
 #include "meas/inline/io/named_objmap.h"
 #include "meas/smear/no_quark_displacement.h"
@@ -147,6 +149,7 @@ namespace Chroma
   InlineHadSpecParams::InlineHadSpecParams()
   { 
     frequency = 0; 
+    corr_xml = true;
   }
 
   InlineHadSpecParams::InlineHadSpecParams(XMLReader& xml_in, const std::string& path) 
@@ -171,6 +174,15 @@ namespace Chroma
       {
 	read(paramtop, "xml_file", xml_file);
       }
+
+      // Possible binary correlator file
+      if (paramtop.count("corr_file") != 0) 
+	read(paramtop, "corr_file", corr_file);
+
+      if (paramtop.count("corr_xml") != 0) 
+	read(paramtop, "corr_xml", corr_xml);
+      else
+	corr_xml = true;
     }
     catch(const std::string& e) 
     {
@@ -188,6 +200,8 @@ namespace Chroma
     Chroma::write(xml_out, "Param", param);
     Chroma::write(xml_out, "NamedObject", named_obj);
     QDP::write(xml_out, "xml_file", xml_file);
+    QDP::write(xml_out, "corr_file", corr_file);
+    QDP::write(xml_out, "corr_xml", corr_xml);
 
     pop(xml_out);
   }
@@ -405,6 +419,13 @@ namespace Chroma
     // First calculate some gauge invariant observables just for info.
     MesPlq(xml_out, "Observables", u);
 
+    // Optional binary correlator file
+    Handle<CorrSink> sink;
+    if (params.corr_file != "")
+      sink = new CorrSink(params.corr_file, params.corr_xml);
+
+    CorrSink* corr_sink = sink.operator->();
+
     // Keep an array of all the xml output buffers
     push(xml_out, "Wilson_hadron_measurements");
 
@@ -565,11 +586,33 @@ namespace Chroma
       QDPIO::cout << "Source type = " << src_type << endl;
       QDPIO::cout << "Sink type = "   << snk_type << endl;
 
+      // Describe the correlators of this pair in the binary file
+      if (corr_sink)
+      {
+	XMLBufferWriter meta;
+	push(meta, "hadspec");
+	write(meta, "update_no", update_no);
+	write(meta, "first_id", named_obj.first_id);
+	write(meta, "second_id", named_obj.second_id);
+	write(meta, "Mass_1", all_sinks.sink_prop_1.Mass);
+	write(meta, "Mass_2", all_sinks.sink_prop_2.Mass);
+	write(meta, "t0", t0);
+	write(meta, "source_sink_type", source_sink_type);
+	pop(meta);
+
+	corr_sink->writeMeta(meta);
+      }
+
+      // Correlators only go to the binary file if asked
+      XMLBufferWriter xml_discard;
+      push(xml_discard, "discard");
+      XMLWriter& xml_corr = (corr_sink && ! params.corr_xml) ? xml_discard : xml_out;
+
       // Do the mesons first
       if (params.param.MesonP) 
       {
 	mesons2(sink_prop_1, sink_prop_2, phases, t0,
-		xml_out, source_sink_type + "_Wilson_Mesons");
+		xml_corr, source_sink_type + "_Wilson_Mesons", corr_sink);
       } // end if (MesonP)
 
 
@@ -591,14 +634,19 @@ namespace Chroma
       {
 	barhqlq(sink_prop_2, sink_prop_1, phases, 
 		t0, bc_spec, params.param.time_rev, 
-		xml_out, source_sink_type + "_Wilson_Baryons");
+		xml_corr, source_sink_type + "_Wilson_Baryons", corr_sink);
       } // end if (BaryonP)
 
+      pop(xml_discard);
+
       pop(xml_out);  // array element
     }
     pop(xml_out);  // Wilson_spectroscopy
     pop(xml_out);  // hadspec
 
+    if (corr_sink)
+      corr_sink->flush();
+
     snoop.stop();
     QDPIO::cout << InlineHadSpecEnv::name << ": total time = "
 		<< snoop.getTimeInSeconds() 
@@ -57,6 +57,8 @@ namespace Chroma
     } named_obj;
 
     std::string xml_file;  // Alternate XML file pattern
+    std::string corr_file; // Optional binary correlator file, appended to
+    bool        corr_xml;  // Also write correlators as xml when corr_file is set
   };
 
 
@@ -14,6 +14,7 @@
 #include "meas/glue/mesplq.h"
 #include "util/ferm/subset_vectors.h"
 #include "util/ferm/key_val_db.h"
+#include "util/ferm/sharded_db.h"
 #include "util/ft/sftmom.h"
 #include "util/info/proginfo.h"
 #include "meas/inline/make_xml_file.h"
@@ -109,6 +110,10 @@ namespace Chroma
       read(inputtop, "gauge_id", input.gauge_id);
       read(inputtop, "colorvec_id", input.colorvec_id);
       read(inputtop, "meson_op_file", input.meson_op_file);
+
+      input.num_shards = 0;
+      if (inputtop.count("num_shards") == 1)
+	read(inputtop, "num_shards", input.num_shards);
     }
 
     //! Write named objects
@@ -119,6 +124,7 @@ namespace Chroma
       write(xml, "gauge_id", input.gauge_id);
       write(xml, "colorvec_id", input.colorvec_id);
       write(xml, "meson_op_file", input.meson_op_file);
+      write(xml, "num_shards", input.num_shards);
 
       pop(xml);
     }
@@ -518,8 +524,11 @@ namespace Chroma
       //
       // DB storage
       //
-      BinaryStoreDB< SerialDBKey<KeyMesonElementalOperator_t>, SerialDBData<ValMesonElementalOperator_t> > 
+      ShardedStoreDB< SerialDBKey<KeyMesonElementalOperator_t>, SerialDBData<ValMesonElementalOperator_t> > 
 	qdp_db;
+      // An existing DB keeps its own number of shards
+      if (params.named_obj.num_shards > 0)
+	qdp_db.setNumShards(params.named_obj.num_shards);
 
       // Open the file, and write the meta-data and the binary for this operator
       if (! qdp_db.fileExists(params.named_obj.meson_op_file))
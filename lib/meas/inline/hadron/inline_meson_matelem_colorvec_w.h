@@ -48,6 +48,7 @@ namespace Chroma
 	std::string         gauge_id;               /*!< Gauge field */
 	std::string         colorvec_id;            /*!< LatticeColorVector EigenInfo */
 	std::string         meson_op_file;          /*!< File name for creation operators */
+	int                 num_shards;             /*!< DB shards written by separate nodes, 0 for one file or what an existing DB has */
       };
 
       Param_t        param;      /*!< Parameters */    
@@ -15,6 +15,7 @@
 #include "io/qprop_io.h"
 #include "meas/inline/make_xml_file.h"
 #include "meas/inline/io/named_objmap.h"
+#include "io/corr_sink_io.h"
 
 #include "meas/hadron/spin_insertion_factory.h"
 #include "meas/hadron/spin_insertion_aggregate.h"
@@ -176,7 +177,7 @@ namespace Chroma
 
 
   // Param stuff
-  InlineMesonSpecParams::InlineMesonSpecParams() { frequency = 0; }
+  InlineMesonSpecParams::InlineMesonSpecParams() { frequency = 0; corr_xml = true; }
 
   InlineMesonSpecParams::InlineMesonSpecParams(XMLReader& xml_in, const std::string& path) 
   {
@@ -200,6 +201,15 @@ namespace Chroma
       {
 	read(paramtop, "xml_file", xml_file);
       }
+
+      // Possible binary correlator file
+      if (paramtop.count("corr_file") != 0) 
+	read(paramtop, "corr_file", corr_file);
+
+      if (paramtop.count("corr_xml") != 0) 
+	read(paramtop, "corr_xml", corr_xml);
+      else
+	corr_xml = true;
     }
     catch(const std::string& e) 
     {
@@ -218,6 +228,8 @@ namespace Chroma
     Chroma::write(xml_out, "Param", param);
     Chroma::write(xml_out, "NamedObject", named_obj);
     QDP::write(xml_out, "xml_file", xml_file);
+    QDP::write(xml_out, "corr_file", corr_file);
+    QDP::write(xml_out, "corr_xml", corr_xml);
 
     pop(xml_out);
   }
@@ -410,6 +422,13 @@ namespace Chroma
     // First calculate some gauge invariant observables just for info.
     MesPlq(xml_out, "Observables", u);
 
+    // Optional binary correlator file
+    Handle<CorrSink> sink;
+    if (params.corr_file != "")
+      sink = new CorrSink(params.corr_file, params.corr_xml);
+
+    CorrSink* corr_sink = sink.operator->();
+
     // Keep an array of all the xml output buffers
     push(xml_out, "Wilson_hadron_measurements");
 
@@ -587,8 +606,31 @@ namespace Chroma
 	multi2d<DComplex> hsum;
 	hsum = phases.sft(corr_fn);
 
+	// Describe the correlator in the binary file
+	if (corr_sink)
+	{
+	  XMLBufferWriter meta;
+	  push(meta, "MesonSpectrum");
+	  write(meta, "update_no", update_no);
+	  write(meta, "source_particle", named_obj.source_particle);
+	  write(meta, "source_wavetype", named_obj.source_wavetype);
+	  write(meta, "sink_particle", named_obj.sink_particle);
+	  write(meta, "sink_wavetype", named_obj.sink_wavetype);
+	  write(meta, "Mass_1", all_sinks[0].sink_prop_1.Mass);
+	  write(meta, "Mass_2", all_sinks[0].sink_prop_2.Mass);
+	  write(meta, "t0", t0);
+	  pop(meta);
+
+	  corr_sink->writeMeta(meta);
+	}
+
+	// Correlators only go to the binary file if asked
+	XMLBufferWriter xml_discard;
+	push(xml_discard, "discard");
+	XMLWriter& xml_corr = (corr_sink && ! params.corr_xml) ? xml_discard : xml_out;
+
 	// Loop over sink momenta
-	XMLArrayWriter xml_sink_mom(xml_out,phases.numMom());
+	XMLArrayWriter xml_sink_mom(xml_corr,phases.numMom());
 	push(xml_sink_mom, "momenta");
 
 	for (int sink_mom_num=0; sink_mom_num < phases.numMom(); ++sink_mom_num) 
@@ -605,11 +647,16 @@ namespace Chroma
 	  }
 
 	  write(xml_sink_mom, "mesprop", mesprop);
+
+	  if (corr_sink)
+	    corr_sink->write(corrKey("Mesons", "correlator", lpair, phases.numToMom(sink_mom_num)), mesprop);
+
 	  pop(xml_sink_mom);
 	
 	} // end for(sink_mom_num)
  
 	pop(xml_sink_mom);
+	pop(xml_discard);
       }
       pop(xml_out);  // Mesons
 
@@ -618,6 +665,9 @@ namespace Chroma
     pop(xml_out);  // Wilson_spectroscopy
     pop(xml_out);  // mesonspec
 
+    if (corr_sink)
+      corr_sink->flush();
+
     snoop.stop();
     QDPIO::cout << InlineMesonSpecEnv::name << ": total time = "
 		<< snoop.getTimeInSeconds() 
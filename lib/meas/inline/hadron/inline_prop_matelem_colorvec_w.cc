@@ -13,6 +13,7 @@
 #include "util/ferm/key_prop_colorvec.h"
 #include "util/ferm/key_prop_matelem.h"
 #include "util/ferm/key_val_db.h"
+#include "util/ferm/sharded_db.h"
 #include "util/ft/sftmom.h"
 #include "util/info/proginfo.h"
 #include "meas/inline/make_xml_file.h"
@@ -32,6 +33,10 @@ namespace Chroma
       read(inputtop, "colorvec_id", input.colorvec_id);
       read(inputtop, "prop_id", input.prop_id);
       read(inputtop, "prop_op_file", input.prop_op_file);
+
+      input.num_shards = 0;
+      if (inputtop.count("num_shards") == 1)
+	read(inputtop, "num_shards", input.num_shards);
     }
 
     //! Propagator output
@@ -43,6 +48,7 @@ namespace Chroma
       write(xml, "colorvec_id", input.colorvec_id);
       write(xml, "prop_id", input.prop_id);
       write(xml, "prop_op_file", input.prop_op_file);
+      write(xml, "num_shards", input.num_shards);
 
       pop(xml);
     }
@@ -299,7 +305,10 @@ namespace Chroma
       //
       // DB storage
       //
-      BinaryStoreDB< SerialDBKey<KeyPropElementalOperator_t>, SerialDBData<ValPropElementalOperator_t> > qdp_db;
+      ShardedStoreDB< SerialDBKey<KeyPropElementalOperator_t>, SerialDBData<ValPropElementalOperator_t> > qdp_db;
+      // An existing DB keeps its own number of shards
+      if (params.named_obj.num_shards > 0)
+	qdp_db.setNumShards(params.named_obj.num_shards);
 
       // Open the file, and write the meta-data and the binary for this operator
       if (! qdp_db.fileExists(params.named_obj.prop_op_file))
@@ -43,6 +43,7 @@ namespace Chroma
 	std::string     colorvec_id;    /*!< LatticeColorVector EigenInfo */
 	std::string     prop_id;        /*!< Id for input propagator solutions */
 	std::string     prop_op_file;   /*!< File name for propagator matrix elements */
+	int             num_shards;     /*!< DB shards written by separate nodes, 0 for one file or what an existing DB has */
       } named_obj;
 
       std::string xml_file;  // Alternate XML file pattern
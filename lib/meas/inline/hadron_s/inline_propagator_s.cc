@@ -15,9 +15,12 @@
 #include "actions/ferm/fermacts/fermact_factory_s.h"
 #include "actions/ferm/fermacts/fermacts_aggregate_s.h"
 #include "meas/inline/make_xml_file.h"
+#include "io/xml_group_reader.h"
 
 #include "meas/inline/io/named_objmap.h"
 
+#include <iomanip>
+
 namespace Chroma 
 { 
   //! Propagator input
@@ -90,6 +93,10 @@ namespace Chroma
 	// Parameters for source construction
 	read(paramtop, "Param", param);
 
+	// Possible masses sharing one multi-shift solve
+	if (paramtop.count("MultiMasses") != 0)
+	  read(paramtop, "MultiMasses", multi_masses);
+
 	// Read in the output propagator/source configuration info
 	read(paramtop, "NamedObject", named_obj);
 
@@ -113,6 +120,8 @@ namespace Chroma
       push(xml_out, path);
     
       write(xml_out, "Param", param);
+      if (multi_masses.size() > 0)
+	write(xml_out, "MultiMasses", multi_masses);
       write(xml_out, "NamedObject", named_obj);
 
       pop(xml_out);
@@ -285,6 +294,33 @@ namespace Chroma
 	pop(xml_out);
       }
 
+      //
+      // Multi-mass propagators are saved one per mass
+      //
+      if (params.multi_masses.size() > 0)
+      {
+	if (seqsourceP)
+	{
+	  QDPIO::cerr << name << ": sequential propagators not supported under multi-mass "
+		      << "since the source is not mass independent" << endl;
+	  QDP_abort(1);
+	}
+
+	multiMassFunc(xml_out, u, quark_prop_source, source_record_xml);
+
+	pop(xml_out);  // propagator
+
+	snoop.stop();
+	QDPIO::cout << name << ": total time = "
+		    << snoop.getTimeInSeconds() 
+		    << " secs" << endl;
+
+	QDPIO::cout << name << ": ran successfully" << endl;
+
+	END_CODE();
+	return;
+      }
+
       //
       // Loop over the source color and spin, creating the source
       // and calling the relevant propagator routines. The QDP
@@ -455,5 +491,154 @@ namespace Chroma
       END_CODE();
     } 
 
+
+    // Multi-mass propagators from one multi-shift solve per source color
+    void 
+    InlineMeas::multiMassFunc(XMLWriter& xml_out,
+			      const multi1d<LatticeColorMatrix>& u,
+			      const LatticeStaggeredPropagator& quark_prop_source,
+			      XMLReader& source_record_xml)
+    {
+      START_CODE();
+
+      // Typedefs to save typing
+      typedef LatticeStaggeredFermion      T;
+      typedef multi1d<LatticeColorMatrix>  P;
+      typedef multi1d<LatticeColorMatrix>  Q;
+
+      const multi1d<Real>& masses = params.multi_masses;
+      const int num_mass = masses.size();
+      multi1d<LatticeStaggeredPropagator> quark_propagator(num_mass);
+      int ncg_had = 0;
+
+      //
+      // Initialize fermion action
+      //
+      std::istringstream  xml_s(params.param.fermact.xml);
+      XMLReader  fermacttop(xml_s);
+      QDPIO::cout << "FermAct = " << params.param.fermact.id << endl;
+
+      try
+      {
+	StopWatch swatch;
+	swatch.reset();
+
+	Handle< StaggeredTypeFermAct<T,P,Q> >
+	  S_f(TheStagTypeFermActFactory::Instance().createObject(params.param.fermact.id,
+								 fermacttop,
+								 params.param.fermact.path));
+
+	// If this cast fails a bad cast exception is thrown.
+	const EvenOddStaggeredTypeFermAct<T,P,Q>& S_eo = 
+	  dynamic_cast<const EvenOddStaggeredTypeFermAct<T,P,Q>&>(*S_f);
+
+	Handle< FermState<T,P,Q> > state(S_eo.createState(u));
+
+	QDPIO::cout << "Suitable factory found: compute the multi-mass quark props" << endl;
+	swatch.start();
+	S_eo.multiQuarkProp(quark_propagator, 
+			    xml_out, 
+			    quark_prop_source,
+			    state, 
+			    masses,
+			    params.param.invParam, 
+			    ncg_had);
+	swatch.stop();
+	QDPIO::cout << "Propagators computed: time= " 
+		    << swatch.getTimeInSeconds() 
+		    << " secs" << endl;
+      }
+      catch (std::bad_cast)
+      {
+	QDPIO::cerr << name << ": fermion action cannot be used for multi-mass propagators" 
+		    << endl;
+	QDP_abort(1);
+      }
+      catch (const std::string& e) 
+      {
+	QDPIO::cerr << name << ": caught exception around multi-mass quarkprop: " << e << endl;
+	QDP_abort(1);
+      }
+
+      push(xml_out,"Relaxation_Iterations");
+      write(xml_out, "ncg_had", ncg_had);
+      pop(xml_out);
+
+      // Sanity check - write out the propagator (pion) correlators in the Nd-1 direction
+      {
+	// Initialize the slow Fourier transform phases
+	SftMom phases(0, true, Nd-1);
+
+	for(int m=0; m < num_mass; ++m)
+	{
+	  multi1d<Double> prop_corr = sumMulti(localNorm2(quark_propagator[m]), 
+					       phases.getSet());
+
+	  push(xml_out, "Prop_correlator");
+	  write(xml_out, "Number", m);
+	  write(xml_out, "Mass", masses[m]);
+	  write(xml_out, "prop_corr", prop_corr);
+	  pop(xml_out);
+	}
+      }
+
+      // Save the propagators as prop_id_000, prop_id_001, ...
+      for(int m=0; m < num_mass; ++m)
+      {
+	try
+	{
+	  XMLBufferWriter file_xml;
+	  push(file_xml, "propagator");
+	  write(file_xml, "id", uniqueId());  // NOTE: new ID form
+	  pop(file_xml);
+
+	  // The forward prop params with the mass of this propagator
+	  ChromaProp_t out_param = params.param;
+	  {
+	    std::istringstream fermact_is(params.param.fermact.xml);
+	    XMLReader fermact_reader(fermact_is);
+	    fermact_reader.set<QDP::Real>("/FermionAction/Mass", masses[m]);
+
+	    XMLReader xml_read(fermact_reader, "/");
+	    out_param.fermact = readXMLGroup(xml_read, "FermionAction", "FermAct");
+	  }
+
+	  XMLBufferWriter record_xml;
+	  XMLReader xml_tmp(source_record_xml, "/MakeSource");
+
+	  push(record_xml, "Propagator");
+	  write(record_xml, "ForwardProp", out_param);
+	  record_xml << xml_tmp;  // write out all the stuff under MakeSource
+	  pop(record_xml);
+
+	  std::ostringstream prop_id;
+	  prop_id << params.named_obj.prop_id << "_" << std::setw(3) << std::setfill('0') << m;
+
+	  TheNamedObjMap::Instance().create<LatticeStaggeredPropagator>(prop_id.str());
+	  TheNamedObjMap::Instance().getData<LatticeStaggeredPropagator>(prop_id.str()) 
+	    = quark_propagator[m];
+
+	  // Write the propagator xml info
+	  TheNamedObjMap::Instance().get(prop_id.str()).setFileXML(file_xml);
+	  TheNamedObjMap::Instance().get(prop_id.str()).setRecordXML(record_xml);
+
+	  QDPIO::cout << "Propagator " << prop_id.str() << " successfully updated" << endl;
+	}
+	catch (std::bad_cast)
+	{
+	  QDPIO::cerr << name << ": caught dynamic cast error" 
+		      << endl;
+	  QDP_abort(1);
+	}
+	catch (const string& e) 
+	{
+	  QDPIO::cerr << name << ": error saving multi-mass prop: " << e << endl;
+	  QDP_abort(1);
+	}
+      }
+
+      END_CODE();
+    }
+
   }
 }
@@ -32,6 +32,7 @@ namespace Chroma
       unsigned long     frequency;
 
       ChromaProp_t      param;
+      multi1d<Real>     multi_masses;   /*!< if not empty, one propagator per mass */
 
       struct NamedObject_t
       {
@@ -63,6 +64,12 @@ namespace Chroma
       void func(const unsigned long update_no,
 		XMLWriter& xml_out); 
 
+      //! Propagators of all the multi masses
+      void multiMassFunc(XMLWriter& xml_out,
+			 const multi1d<LatticeColorMatrix>& u,
+			 const LatticeStaggeredPropagator& quark_prop_source,
+			 XMLReader& source_record_xml);
+
     private:
       Params params;
     };
@@ -0,0 +1,189 @@
+/*! \file
+ * \brief Inline task to write a gauge field in the compact format
+ *
+ * Named object writing with 12 or 8 reals per link
+ */
+
+#include "chromabase.h"
+#include "meas/inline/abs_inline_measurement_factory.h"
+#include "meas/inline/io/inline_compact_write_obj.h"
+#include "io/compact_gauge_io.h"
+#include "meas/inline/io/named_objmap.h"
+
+namespace Chroma 
+{ 
+  namespace InlineCompactWriteNamedObjEnv 
+  { 
+    namespace
+    {
+      AbsInlineMeasurement* createMeasurement(XMLReader& xml_in, 
+					      const std::string& path) 
+      {
+	return new InlineMeas(Params(xml_in, path));
+      }
+
+      //! Local registration flag
+      bool registered = false;
+
+      const std::string name = "COMPACT_WRITE_NAMED_OBJECT";
+    }
+
+    //! Register all the factories
+    bool registerAll() 
+    {
+      bool success = true; 
+      if (! registered)
+      {
+	success &= TheInlineMeasurementFactory::Instance().registerObject(name, createMeasurement);
+	registered = true;
+      }
+      return success;
+    }
+
+
+    //! Object buffer
+    void write(XMLWriter& xml, const string& path, const Params::NamedObject_t& input)
+    {
+      push(xml, path);
+
+      write(xml, "object_id", input.object_id);
+
+      pop(xml);
+    }
+
+    //! File output
+    void write(XMLWriter& xml, const string& path, const Params::File_t& input)
+    {
+      push(xml, path);
+
+      write(xml, "file_name", input.file_name);
+      write(xml, "reconstruct", input.reconstruct);
+
+      pop(xml);
+    }
+
+
+    //! Object buffer
+    void read(XMLReader& xml, const string& path, Params::NamedObject_t& input)
+    {
+      XMLReader inputtop(xml, path);
+
+      read(inputtop, "object_id", input.object_id);
+    }
+
+    //! File output
+    void read(XMLReader& xml, const string& path, Params::File_t& input)
+    {
+      XMLReader inputtop(xml, path);
+
+      read(inputtop, "file_name", input.file_name);
+
+      if (inputtop.count("reconstruct") == 1)
+	read(inputtop, "reconstruct", input.reconstruct);
+      else
+	input.reconstruct = 12;
+    }
+
+
+    // Param stuff
+    Params::Params() { frequency = 0; }
+
+    Params::Params(XMLReader& xml_in, const std::string& path) 
+    {
+      try 
+      {
+	XMLReader paramtop(xml_in, path);
+
+	if (paramtop.count("Frequency") == 1)
+	  read(paramtop, "Frequency", frequency);
+	else
+	  frequency = 1;
+
+	// Parameters for source construction
+	read(paramtop, "NamedObject", named_obj);
+
+	// Read in the destination
+	read(paramtop, "File", file);
+      }
+      catch(const std::string& e) 
+      {
+	QDPIO::cerr << __func__ << ": caught Exception reading XML: " << e << endl;
+	QDP_abort(1);
+      }
+    }
+
+
+    void
+    Params::writeXML(XMLWriter& xml_out, const std::string& path) 
+    {
+      push(xml_out, path);
+    
+      // Parameters for source construction
+      write(xml_out, "NamedObject", named_obj);
+
+      // Write out the destination
+      write(xml_out, "File", file);
+
+      pop(xml_out);
+    }
+
+
+    void 
+    InlineMeas::operator()(unsigned long update_no,
+			   XMLWriter& xml_out) 
+    {
+      START_CODE();
+
+      push(xml_out, "compact_write_named_obj");
+      write(xml_out, "update_no", update_no);
+
+      QDPIO::cout << name << ": object writer" << endl;
+      StopWatch swatch;
+
+      // Write the object
+      // ONLY the compact gauge format is supported in this task
+      QDPIO::cout << "Attempt to write object name = " << params.named_obj.object_id << endl;
+      write(xml_out, "object_id", params.named_obj.object_id);
+      try
+      {
+	swatch.reset();
+
+	multi1d<LatticeColorMatrix> u = 
+	  TheNamedObjMap::Instance().getData< multi1d<LatticeColorMatrix> >(params.named_obj.object_id);
+
+	XMLBufferWriter file_xml, record_xml;
+	TheNamedObjMap::Instance().get(params.named_obj.object_id).getFileXML(file_xml);
+	TheNamedObjMap::Instance().get(params.named_obj.object_id).getRecordXML(record_xml);
+
+	// Write the object
+	swatch.start();
+	writeCompactGauge(file_xml, record_xml, u, params.file.file_name, params.file.reconstruct);
+	swatch.stop();
+
+	QDPIO::cout << "Object successfully written: time= " 
+		    << swatch.getTimeInSeconds() 
+		    << " secs" << endl;
+      }
+      catch( std::bad_cast ) 
+      {
+	QDPIO::cerr << name << ": cast error" 
+		    << endl;
+	QDP_abort(1);
+      }
+      catch (const string& e) 
+      {
+	QDPIO::cerr << name << ": error message: " << e 
+		    << endl;
+	QDP_abort(1);
+      }
+    
+      QDPIO::cout << name << ": ran successfully" << endl;
+
+      pop(xml_out);  // write_named_obj
+
+      END_CODE();
+    } 
+
+  } // namespace InlineCompactWriteNamedObjEnv 
+
+} // namespace Chroma
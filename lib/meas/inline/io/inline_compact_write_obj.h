@@ -0,0 +1,67 @@
+// -*- C++ -*-
+/*! \file
+ * \brief Inline task to write a gauge field in the compact format
+ *
+ * Named object writing with 12 or 8 reals per link
+ */
+
+#ifndef __inline_compact_write_obj_h__
+#define __inline_compact_write_obj_h__
+
+#include "chromabase.h"
+#include "meas/inline/abs_inline_measurement.h"
+#include "io/qprop_io.h"
+
+namespace Chroma 
+{ 
+  /*! \ingroup inlineio */
+  namespace InlineCompactWriteNamedObjEnv 
+  {
+    bool registerAll();
+
+    //! Parameter structure
+    /*! \ingroup inlineio */
+    struct Params 
+    {
+      Params();
+      Params(XMLReader& xml_in, const std::string& path);
+      void writeXML(XMLWriter& xml_out, const std::string& path);
+
+      unsigned long frequency;
+
+      struct NamedObject_t
+      {
+	std::string   object_id;
+      } named_obj;
+
+      struct File_t
+      {
+	std::string   file_name;
+	int           reconstruct;   /*!< 12 or 8 reals per link */
+      } file;
+    };
+
+    //! Inline writing of memory objects
+    /*! \ingroup inlineio */
+    class InlineMeas : public AbsInlineMeasurement 
+    {
+    public:
+      ~InlineMeas() {}
+      InlineMeas(const Params& p) : params(p) {}
+
+      unsigned long getFrequency(void) const {return params.frequency;}
+
+      //! Do the writing
+      void operator()(const unsigned long update_no,
+		      XMLWriter& xml_out); 
+
+    private:
+      Params params;
+    };
+
+  } // namespace InlineCompactWriteNamedObjEnv 
+
+} // namespace Chroma
+
+
+#endif
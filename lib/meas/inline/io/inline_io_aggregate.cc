@@ -8,11 +8,13 @@
 #include "meas/inline/io/inline_qio_write_erase_obj.h"
 #include "meas/inline/io/inline_qio_read_obj.h"
 #include "meas/inline/io/inline_erase_obj.h"
+#include "meas/inline/io/inline_named_obj_budget.h"
 #include "meas/inline/io/inline_list_obj.h"
 #include "meas/inline/io/inline_szin_read_obj.h"
 #include "meas/inline/io/inline_szin_write_obj.h"
 #include "meas/inline/io/inline_nersc_read_obj.h"
 #include "meas/inline/io/inline_nersc_write_obj.h"
+#include "meas/inline/io/inline_compact_write_obj.h"
 
 #include "meas/inline/io/inline_rng.h"
 
@@ -54,6 +56,7 @@ namespace Chroma
 	success &= InlineQIOWriteNamedObjEnv::registerAll();
 	success &= InlineQIOWriteEraseNamedObjEnv::registerAll();
 	success &= InlineEraseNamedObjEnv::registerAll();
+	success &= InlineNamedObjBudgetEnv::registerAll();
 	success &= InlineListNamedObjEnv::registerAll();
 
 	success &= InlineGaussianInitNamedObjEnv::registerAll();
@@ -64,6 +67,8 @@ namespace Chroma
 	success &= InlineNERSCReadNamedObjEnv::registerAll();
 	success &= InlineNERSCWriteNamedObjEnv::registerAll();
 
+	success &= InlineCompactWriteNamedObjEnv::registerAll();
+
 	success &= InlineEigenBinColVecReadNamedObjEnv::registerAll();
 	success &= InlineEigenLimeColVecReadNamedObjEnv::registerAll();
 	success &= InlineEigenBinLimeColVecReadNamedObjEnv::registerAll();
@@ -0,0 +1,138 @@
+/*! \file
+ * \brief Inline task to set the memory budget of the named object map
+ *
+ * Past the budget, least recently used lattice objects are spilled to scratch
+ */
+
+#include "meas/inline/abs_inline_measurement_factory.h"
+#include "meas/inline/io/inline_named_obj_budget.h"
+#include "meas/inline/io/named_objmap.h"
+
+namespace Chroma 
+{ 
+  namespace InlineNamedObjBudgetEnv 
+  { 
+    namespace
+    {
+      AbsInlineMeasurement* createMeasurement(XMLReader& xml_in, 
+					      const std::string& path) 
+      {
+	return new InlineMeas(Params(xml_in, path));
+      }
+
+      //! Local registration flag
+      bool registered = false;
+
+      const std::string name = "NAMED_OBJECT_BUDGET";
+    }
+
+    //! Register all the factories
+    bool registerAll() 
+    {
+      bool success = true; 
+      if (! registered)
+      {
+	success &= TheInlineMeasurementFactory::Instance().registerObject(name, createMeasurement);
+	registered = true;
+      }
+      return success;
+    }
+
+
+    //! Budget
+    void write(XMLWriter& xml, const string& path, const Params::Budget_t& input)
+    {
+      push(xml, path);
+
+      write(xml, "budget_mb", input.budget_mb);
+      write(xml, "scratch_dir", input.scratch_dir);
+
+      pop(xml);
+    }
+
+
+    //! Budget
+    void read(XMLReader& xml, const string& path, Params::Budget_t& input)
+    {
+      XMLReader inputtop(xml, path);
+
+      read(inputtop, "budget_mb", input.budget_mb);
+
+      if (inputtop.count("scratch_dir") == 1)
+	read(inputtop, "scratch_dir", input.scratch_dir);
+      else
+	input.scratch_dir = ".";
+    }
+
+
+    // Param stuff
+    Params::Params() { frequency = 0; }
+
+    Params::Params(XMLReader& xml_in, const std::string& path) 
+    {
+      try 
+      {
+	XMLReader paramtop(xml_in, path);
+
+	if (paramtop.count("Frequency") == 1)
+	  read(paramtop, "Frequency", frequency);
+	else
+	  frequency = 1;
+
+	read(paramtop, "Budget", budget);
+      }
+      catch(const std::string& e) 
+      {
+	QDPIO::cerr << __func__ << ": caught Exception reading XML: " << e << endl;
+	QDP_abort(1);
+      }
+    }
+
+
+    void
+    Params::writeXML(XMLWriter& xml_out, const std::string& path) 
+    {
+      push(xml_out, path);
+    
+      write(xml_out, "Budget", budget);
+
+      pop(xml_out);
+    }
+
+
+    void 
+    InlineMeas::operator()(unsigned long update_no,
+			   XMLWriter& xml_out) 
+    {
+      START_CODE();
+
+      push(xml_out, "named_obj_budget");
+      write(xml_out, "update_no", update_no);
+
+      QDPIO::cout << name << ": budget = " << params.budget.budget_mb 
+		  << " MB  scratch_dir = " << params.budget.scratch_dir << endl;
+
+      try
+      {
+	size_t bytes = size_t(params.budget.budget_mb * 1024 * 1024);
+	TheNamedObjMap::Instance().setMemoryBudget(bytes, params.budget.scratch_dir);
+
+	write(xml_out, "resident_bytes", double(TheNamedObjMap::Instance().residentBytes()));
+      }
+      catch (const string& e) 
+      {
+	QDPIO::cerr << name << ": error message: " << e 
+		    << endl;
+	QDP_abort(1);
+      }
+    
+      QDPIO::cout << name << ": ran successfully" << endl;
+
+      pop(xml_out);  // named_obj_budget
+
+      END_CODE();
+    } 
+
+  }
+
+}
@@ -0,0 +1,60 @@
+// -*- C++ -*-
+/*! \file
+ * \brief Inline task to set the memory budget of the named object map
+ *
+ * Past the budget, least recently used lattice objects are spilled to scratch
+ */
+
+#ifndef __inline_named_obj_budget_h__
+#define __inline_named_obj_budget_h__
+
+#include "chromabase.h"
+#include "meas/inline/abs_inline_measurement.h"
+
+namespace Chroma 
+{ 
+  /*! \ingroup inlineio */
+  namespace InlineNamedObjBudgetEnv 
+  {
+    bool registerAll();
+
+    //! Parameter structure
+    /*! \ingroup inlineio */
+    struct Params 
+    {
+      Params();
+      Params(XMLReader& xml_in, const std::string& path);
+      void writeXML(XMLWriter& xml_out, const std::string& path);
+
+      unsigned long frequency;
+
+      struct Budget_t
+      {
+	double        budget_mb;     /*!< megabytes per node, 0 for no budget */
+	std::string   scratch_dir;   /*!< node local directory for spilled objects */
+      } budget;
+    };
+
+    //! Inline setting of the named object memory budget
+    /*! \ingroup inlineio */
+    class InlineMeas : public AbsInlineMeasurement 
+    {
+    public:
+      ~InlineMeas() {}
+      InlineMeas(const Params& p) : params(p) {}
+
+      unsigned long getFrequency(void) const {return params.frequency;}
+
+      //! Set the budget
+      void operator()(const unsigned long update_no,
+		      XMLWriter& xml_out); 
+
+    private:
+      Params params;
+    };
+
+  }
+
+}
+
+#endif
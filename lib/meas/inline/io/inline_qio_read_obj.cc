@@ -15,6 +15,7 @@
 #include "util/ferm/eigeninfo.h"
 #include "util/ferm/subset_vectors.h"
 #include "util/ferm/key_prop_colorvec.h"
+#include "util/ferm/compressed_lattice.h"
 #include "handle.h"
 #include "actions/ferm/invert/containers.h"
 
@@ -68,7 +69,24 @@ namespace Chroma
 	    XMLReader file_xml, record_xml;
 
 	    QDPFileReader to(file_xml,params.file.file_name,serpar);
-	    read(to,record_xml,obj);
+
+	    if (isCompressedXML(file_xml))
+	    {
+	      // Half precision with a scale per block
+	      CompressedLattice<LatticePropagator> cobj;
+	      cobj.resize();
+
+	      XMLReader record_xml_dummy;
+	      read(to,record_xml,cobj.scale);
+	      read(to,record_xml_dummy,cobj.words);
+	      cobj.decompress(obj);
+
+	      unwrapCompressedFileXML(file_xml);
+	    }
+	    else
+	    {
+	      read(to,record_xml,obj);
+	    }
 	    close(to);
 
 	    TheNamedObjMap::Instance().create<LatticePropagator>(params.named_obj.object_id);
@@ -197,6 +215,11 @@ namespace Chroma
 	    // Open file
 	    QDPFileReader to(file_xml,params.file.file_name,serpar);
 
+	    // Half precision with a scale per block
+	    bool compressed = isCompressedXML(file_xml);
+	    if (compressed)
+	      unwrapCompressedFileXML(file_xml);
+
 	    // Extract number of EVs from XML
 	    int N, decay_dir;
 	    try { 
@@ -235,7 +258,20 @@ namespace Chroma
 	      XMLReader record_xml_dummy;
 	      EVPair<LatticeColorVector> read_pair;
 	  
-	      read(to, record_xml_dummy, read_pair.eigenVector);
+	      if (compressed)
+	      {
+		CompressedLattice<LatticeColorVector> cvec;
+		cvec.resize();
+
+		XMLReader words_xml_dummy;
+		read(to, record_xml_dummy, cvec.scale);
+		read(to, words_xml_dummy, cvec.words);
+		cvec.decompress(read_pair.eigenVector);
+	      }
+	      else
+	      {
+		read(to, record_xml_dummy, read_pair.eigenVector);
+	      }
 	  
 	      read_pair.eigenValue.weights.resize(Lt);
 	      read(record_xml_dummy, "/VectorInfo/weights", read_pair.eigenValue.weights);
@@ -9,6 +9,7 @@
 #include "meas/inline/io/named_objmap.h"
 #include "meas/inline/io/qio_write_obj_funcmap.h"
 #include "io/enum_io/enum_qdpvolfmt_io.h"
+#include "io/scidac_checksum.h"
 
 namespace Chroma 
 { 
@@ -65,6 +66,7 @@ namespace Chroma
       write(xml, "file_name", input.file_name);
       write(xml, "file_volfmt", input.file_volfmt);
       write(xml, "parallel_io", input.parallel_io);
+      write(xml, "checksum", input.checksum);
 
       pop(xml);
     }
@@ -93,6 +95,62 @@ namespace Chroma
 	input.parallel_io = false;
       }
 
+      input.checksum = false;
+      if (inputtop.count("checksum") > 0)
+	read(inputtop, "checksum", input.checksum);
+    }
+
+
+    //! SciDAC checksum of the record QIO writes for the object
+    /*!
+     * A separate pass over the named object after QIO has written it,
+     * converted to the precision of the file, so the checksum can be
+     * reported and compared with the file. Returns false for types not
+     * handled.
+     */
+    bool objectChecksum(const std::string& object_type, const std::string& object_id,
+			ScidacChecksum_t& sum)
+    {
+      if (object_type == "LatticePropagator")
+	scidacChecksum(TheNamedObjMap::Instance().getData<LatticePropagator>(object_id), sum);
+      else if (object_type == "LatticePropagatorF")
+      {
+	LatticePropagatorF q = TheNamedObjMap::Instance().getData<LatticePropagator>(object_id);
+	scidacChecksum(q, sum);
+      }
+      else if (object_type == "LatticePropagatorD")
+      {
+	LatticePropagatorD q = TheNamedObjMap::Instance().getData<LatticePropagator>(object_id);
+	scidacChecksum(q, sum);
+      }
+      else if (object_type == "LatticeFermion")
+	scidacChecksum(TheNamedObjMap::Instance().getData<LatticeFermion>(object_id), sum);
+      else if (object_type == "LatticeStaggeredPropagator")
+	scidacChecksum(TheNamedObjMap::Instance().getData<LatticeStaggeredPropagator>(object_id), sum);
+      else if (object_type == "Multi1dLatticeColorMatrix")
+	scidacChecksum(TheNamedObjMap::Instance().getData< multi1d<LatticeColorMatrix> >(object_id), sum);
+      else if (object_type == "Multi1dLatticeColorMatrixF")
+      {
+	const multi1d<LatticeColorMatrix>& u = 
+	  TheNamedObjMap::Instance().getData< multi1d<LatticeColorMatrix> >(object_id);
+	multi1d<LatticeColorMatrixF> uf(u.size());
+	for(int mu=0; mu < u.size(); ++mu)
+	  uf[mu] = u[mu];
+	scidacChecksum(uf, sum);
+      }
+      else if (object_type == "Multi1dLatticeColorMatrixD")
+      {
+	const multi1d<LatticeColorMatrix>& u = 
+	  TheNamedObjMap::Instance().getData< multi1d<LatticeColorMatrix> >(object_id);
+	multi1d<LatticeColorMatrixD> ud(u.size());
+	for(int mu=0; mu < u.size(); ++mu)
+	  ud[mu] = u[mu];
+	scidacChecksum(ud, sum);
+      }
+      else
+	return false;
+
+      return true;
     }
 
 
@@ -181,6 +239,27 @@ namespace Chroma
 	QDPIO::cout << "Object successfully written: time= " 
 		    << swatch.getTimeInSeconds() 
 		    << " secs" << endl;
+
+	if (params.file.checksum)
+	{
+	  ScidacChecksum_t sum;
+
+	  swatch.reset();
+	  swatch.start();
+	  bool found = objectChecksum(params.named_obj.object_type, params.named_obj.object_id, sum);
+	  swatch.stop();
+
+	  if (found)
+	  {
+	    write(xml_out, "scidac_checksum", sum);
+	    QDPIO::cout << "SciDAC checksum computed: time= "
+			<< swatch.getTimeInSeconds() 
+			<< " secs" << endl;
+	  }
+	  else
+	    QDPIO::cout << "No SciDAC checksum for object_type= " 
+			<< params.named_obj.object_type << endl;
+	}
       }
       catch( std::bad_cast ) 
       {
@@ -40,6 +40,7 @@ namespace Chroma
 	std::string   file_name;
 	QDP_volfmt_t  file_volfmt;
 	bool          parallel_io;
+	bool          checksum;      /*!< report the SciDAC checksum of the record */
       } file;
     };
 
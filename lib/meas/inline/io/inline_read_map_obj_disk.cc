@@ -11,6 +11,7 @@
 #include "meas/inline/io/named_objmap.h"
 #include "util/ferm/key_prop_colorvec.h"
 #include "util/ferm/subset_ev_pair.h"
+#include "util/ferm/map_obj/map_obj_compressed_w.h"
 #include "qdp_map_obj_disk.h"
 #include <string>
 
@@ -48,16 +49,45 @@ namespace Chroma
 	  return obj_handle->size();
 	}
 
+	//! Read a map object whose values may have been stored compressed as CV
+	template<typename K, typename V, typename CV>
+	int readCompressibleMapObj(const std::string& object_id,
+				   const std::string& file_name)
+	{
+	  std::string user_data;
+	  {
+	    QDP::MapObjectDisk<K,V> obj_obj;
+	    obj_obj.open(file_name);
+	    obj_obj.getUserdata(user_data);
+	  }
+
+	  if (! isCompressedUserdata(user_data))
+	    return readMapObj<K,V>(object_id, file_name);
+
+	  QDPIO::cout << "Map object in " << file_name << " is compressed" << endl;
+
+	  QDP::MapObjectDisk<K,CV>* obj_obj = new QDP::MapObjectDisk<K,CV>();
+	  obj_obj->open(file_name);
+
+	  Handle<QDP::MapObject<K,V> > obj_handle(
+	    new MapObjectCompressed<K,V,CV>(Handle< QDP::MapObject<K,CV> >(obj_obj)));
+	  TheNamedObjMap::Instance().create< Handle<QDP::MapObject<K,V> >, Handle<QDP::MapObject<K,V> > >(object_id, obj_handle);
+
+	  return obj_handle->size();
+	}
+
 	bool registerAll(void) 
 	{
 	  bool success = true; 
 	  if (! registered ) 
 	  { 
 	    success &= TheReadMapObjFuncMap::Instance().registerFunction("KeyTKeyPropColorVec_tValTLatticeFermion",
-									 readMapObj<KeyPropColorVec_t, LatticeFermion>);
+									 readCompressibleMapObj<KeyPropColorVec_t, LatticeFermion,
+									 CompressedLattice<LatticeFermion> >);
 
 	    success &= TheReadMapObjFuncMap::Instance().registerFunction("KeyTintValTEVPairLatticeColorVector",
-									 readMapObj<int, EVPair<LatticeColorVector> >);
+									 readCompressibleMapObj<int, EVPair<LatticeColorVector>,
+									 EVPair< CompressedLattice<LatticeColorVector> > >);
 
 	    success &= TheReadMapObjFuncMap::Instance().registerFunction("KeyTcharValTfloat",
 									 readMapObj<char, float>);
@@ -14,6 +14,7 @@
 #include "meas/inline/io/named_objmap.h"
 
 #include "util/info/proginfo.h"
+#include "io/slab_io.h"
 
 #include "util/ferm/subset_ev_pair.h"
 #include "util/ferm/subset_vectors.h"
@@ -45,6 +46,59 @@ namespace Chroma
       { 
 	static bool registered = false;
 
+	//! A time slice record, gathered already and in file byte order
+	/*!
+	 * Only the primary node holds the bytes. They are those TimeSliceIO
+	 * writes for the slice, so the files are read back with TimeSliceIO.
+	 */
+	struct TimeSliceRecord
+	{
+	  const char*  bytes;
+	  size_t       len;
+	};
+
+	void write(BinaryWriter& bin, const TimeSliceRecord& r)
+	{
+	  if (Layout::primaryNode())
+	    bin.writeArray(r.bytes, 1, r.len);
+	}
+
+	void read(BinaryReader& bin, TimeSliceRecord& r)
+	{
+	  QDPIO::cerr << "TimeSliceRecord: records are only written here, read them with TimeSliceIO" << endl;
+	  QDP_abort(1);
+	}
+
+	//! Every site, in lexicographic order
+	SiteSlab lexicoSlab()
+	{
+	  multi1d<int> lex(Layout::vol());
+	  for(int i=0; i < lex.size(); ++i)
+	    lex[i] = i;
+	  return SiteSlab(lex);
+	}
+
+	//! Write the time slices of a field, slice t under keys[t]
+	/*!
+	 * The field is gathered once and its slices are appended back to back,
+	 * rather than gathered slice by slice. The map keeps the index until
+	 * it is flushed.
+	 */
+	template<typename K, typename T>
+	void insertTimeSlices(QDP::MapObjectDisk<K,TimeSliceRecord>& output_obj, 
+			      const std::vector<K>& keys, const OLattice<T>& f, const SiteSlab& slab)
+	{
+	  std::vector<char> buf;
+	  gatherLexico(f, slab, buf);
+
+	  const size_t slice_bytes = sizeof(T) * (Layout::vol() / keys.size());
+	  for(int t=0; t < keys.size(); t++) 
+	  {
+	    TimeSliceRecord r = {(buf.size() > 0) ? &buf[t*slice_bytes] : 0, slice_bytes};
+	    output_obj.insert(keys[t], r);
+	  }
+	}
+
 	void writeMapObjEVPairLCV(const Params& params)
 	{
 	  // Input object
@@ -66,13 +120,14 @@ namespace Chroma
 	  pop(file_xml);
 
 	  // Create the entry
-	  QDP::MapObjectDisk<KeyTimeSliceColorVec_t,TimeSliceIO<LatticeColorVector> > output_obj;
+	  QDP::MapObjectDisk<KeyTimeSliceColorVec_t,TimeSliceRecord> output_obj;
 
 	  output_obj.insertUserdata(file_xml.str());
 	  output_obj.open(params.named_obj.output_file, std::ios_base::in | std::ios_base::out | std::ios_base::trunc);
 
 	  // Copy the key/value-s
 	  int Lt = Layout::lattSize()[decay_dir];
+	  SiteSlab slab = lexicoSlab();
 
 	  for(int i=0; i < keys.size(); i++) 
 	  {
@@ -81,14 +136,14 @@ namespace Chroma
 
 	    // We know the keys are simple integers from 0 to N-1.
 	    // Write with a time-slice key.
+	    std::vector<KeyTimeSliceColorVec_t> time_keys(Lt);
 	    for(int t=0; t < Lt; t++) 
 	    {
-	      KeyTimeSliceColorVec_t time_key;
-	      time_key.t_slice = t;
-	      time_key.colorvec = keys[i];
-
-	      output_obj.insert(time_key, TimeSliceIO<LatticeColorVector>(tmpvec.eigenVector,t));
+	      time_keys[t].t_slice = t;
+	      time_keys[t].colorvec = keys[i];
 	    }
+
+	    insertTimeSlices(output_obj, time_keys, tmpvec.eigenVector, slab);
 	  }
 
 	  output_obj.flush();
@@ -100,8 +155,7 @@ namespace Chroma
 	  // Input object
 	  XMLBufferWriter gauge_xml;
 
-	  // Make a copy because the TimeSliceIO critter wants a modifiable reference
-	  multi1d<LatticeColorMatrix> u = TheNamedObjMap::Instance().getData< multi1d<LatticeColorMatrix> >(params.named_obj.input_id);
+	  const multi1d<LatticeColorMatrix>& u = TheNamedObjMap::Instance().getData< multi1d<LatticeColorMatrix> >(params.named_obj.input_id);
 	  TheNamedObjMap::Instance().get(params.named_obj.input_id).getRecordXML(gauge_xml);
 
 	  const int decay_dir = Nd-1;
@@ -117,25 +171,26 @@ namespace Chroma
 	  pop(file_xml);
 
 	  // Create the entry
-	  QDP::MapObjectDisk<KeyTimeSliceGauge_t,TimeSliceIO<LatticeColorMatrix> > output_obj;
+	  QDP::MapObjectDisk<KeyTimeSliceGauge_t,TimeSliceRecord> output_obj;
 
 	  output_obj.insertUserdata(file_xml.str());
 	  output_obj.open(params.named_obj.output_file, std::ios_base::in | std::ios_base::out | std::ios_base::trunc);
 
 	  // Copy the key/value-s
 	  int Lt = Layout::lattSize()[decay_dir];
+	  SiteSlab slab = lexicoSlab();
 
 	  for(int mu=0; mu < u.size(); mu++) 
 	  {
 	    // Write with a time-slice key.
+	    std::vector<KeyTimeSliceGauge_t> time_keys(Lt);
 	    for(int t=0; t < Lt; t++) 
 	    {
-	      KeyTimeSliceGauge_t time_key;
-	      time_key.t_slice = t;
-	      time_key.dir     = mu;
-
-	      output_obj.insert(time_key, TimeSliceIO<LatticeColorMatrix>(u[mu],t));
+	      time_keys[t].t_slice = t;
+	      time_keys[t].dir     = mu;
 	    }
+
+	    insertTimeSlices(output_obj, time_keys, u[mu], slab);
 	  }
 
 	  output_obj.flush();
@@ -149,8 +204,7 @@ namespace Chroma
 	  // Input object
 	  XMLBufferWriter gauge_xml;
 
-	  // Make a copy because the TimeSliceIO critter wants a modifiable reference
-	  V u = TheNamedObjMap::Instance().getData<V>(params.named_obj.input_id);
+	  const V& u = TheNamedObjMap::Instance().getData<V>(params.named_obj.input_id);
 	  TheNamedObjMap::Instance().get(params.named_obj.input_id).getRecordXML(gauge_xml);
 
 	  const int decay_dir = Nd-1;
@@ -166,7 +220,7 @@ namespace Chroma
 	  pop(file_xml);
 
 	  // Create the entry
-	  QDP::MapObjectDisk<int,TimeSliceIO<V> > output_obj;
+	  QDP::MapObjectDisk<int,TimeSliceRecord> output_obj;
 
 	  output_obj.insertUserdata(file_xml.str());
 
@@ -179,10 +233,11 @@ namespace Chroma
 	  int Lt = Layout::lattSize()[decay_dir];
 
 	  // Write with a time-slice key.
+	  std::vector<int> time_keys(Lt);
 	  for(int t=0; t < Lt; t++) 
-	  {
-	    output_obj.insert(t, TimeSliceIO<V>(u,t));
-	  }
+	    time_keys[t] = t;
+
+	  insertTimeSlices(output_obj, time_keys, u, lexicoSlab());
 
 	  output_obj.flush();
 	}
@@ -12,6 +12,7 @@
 #include "util/ferm/eigeninfo.h"
 #include "util/ferm/subset_vectors.h"
 #include "util/ferm/key_prop_colorvec.h"
+#include "util/ferm/compressed_lattice.h"
 #include "handle.h"
 #include "qdp_map_obj_memory.h"
 
@@ -83,6 +84,39 @@ namespace Chroma
       }
 
 
+      //! Write a propagator in half precision with a scale per block
+      /*! 
+       * The file xml is wrapped in the CompressedLattice group holding the 
+       * error bound. The block scales and the compressed words are two records.
+       */
+      void QIOWriteLatPropH(const string& buffer_id,
+			    const string& file, 
+			    QDP_volfmt_t volfmt, QDP_serialparallel_t serpar)
+      {
+	XMLBufferWriter file_xml, record_xml;
+
+	const LatticePropagator& obj = TheNamedObjMap::Instance().getData<LatticePropagator>(buffer_id);
+	TheNamedObjMap::Instance().get(buffer_id).getFileXML(file_xml);
+	TheNamedObjMap::Instance().get(buffer_id).getRecordXML(record_xml);
+
+	CompressedLattice<LatticePropagator> cobj;
+	cobj.compress(obj);
+
+	XMLBufferWriter cfile_xml;
+	writeCompressedXML(cfile_xml, cobj.blockSize(), cobj.relBlockErrorBound(), 
+			   toDouble(cobj.relNormError(obj)), file_xml.printCurrentContext());
+
+	XMLBufferWriter record_xml_dummy;
+	push(record_xml_dummy, "dummy_record_xml");
+	pop(record_xml_dummy);
+
+	QDPFileWriter to(cfile_xml,file,volfmt,serpar,QDPIO_OPEN);
+	write(to,record_xml,cobj.scale);
+	write(to,record_xml_dummy,cobj.words);
+	close(to);
+      }
+
+
       //------------------------------------------------------------------------
       //! Write a fermion
       void QIOWriteLatFerm(const string& buffer_id,
@@ -457,6 +491,66 @@ namespace Chroma
 	close(to);
       }
 
+      //----------------------------------------------------------------------
+      //! Write subset vectors in half precision with a scale per block
+      /*!
+       * As for a propagator, each vector is two records and its record xml
+       * carries its relative norm error.
+       */
+      void QIOWriteSubsetVectorsH(const string& buffer_id,
+				  const string& file,
+				  QDP_volfmt_t volfmt, QDP_serialparallel_t serpar)
+      {
+	// A shorthand for the object
+	QDP::MapObject<int,EVPair<LatticeColorVector> >& obj =
+	  *(TheNamedObjMap::Instance().getData< Handle< QDP::MapObject<int,EVPair<LatticeColorVector> > > >(buffer_id));
+
+	// Yuk. Could read this back in.
+	int decay_dir = Nd-1;
+
+	// Write number of EVs to XML
+	XMLBufferWriter vec_xml;
+
+	push(vec_xml, "AllVectors");
+	write(vec_xml, "n_vec", obj.size());
+	write(vec_xml, "decay_dir", decay_dir);
+	pop(vec_xml);
+
+	XMLBufferWriter file_xml;
+	writeCompressedXML(file_xml, CompressedLattice<LatticeColorVector>::blockSize(), 
+			   CompressedLattice<LatticeColorVector>::relBlockErrorBound(), 
+			   -1, vec_xml.printCurrentContext());
+
+	// Open file
+	QDPFileWriter to(file_xml,file,volfmt,serpar,QDPIO_OPEN);
+
+	XMLBufferWriter record_xml_dummy;
+	push(record_xml_dummy, "dummy_record_xml");
+	pop(record_xml_dummy);
+
+	// Loop and write evecs
+	for(int n=0; n < obj.size(); n++)
+	{
+	  EVPair<LatticeColorVector> write_pair;
+	  obj.get(n, write_pair);
+
+	  CompressedLattice<LatticeColorVector> cvec;
+	  cvec.compress(write_pair.eigenVector);
+
+	  XMLBufferWriter record_xml;
+	  push(record_xml, "VectorInfo");
+	  write(record_xml, "weights", write_pair.eigenValue.weights);
+	  write(record_xml, "rel_norm_error", cvec.relNormError(write_pair.eigenVector));
+	  pop(record_xml);
+
+	  write(to, record_xml, cvec.scale);
+	  write(to, record_xml_dummy, cvec.words);
+	}
+
+	// Done
+	close(to);
+      }
+
       //------------------------------------------------------------------------
       //! Write out a MapObject Type
       template<typename K, typename V>
@@ -515,6 +609,8 @@ namespace Chroma
 								      QIOWriteLatPropF);
 	success &= TheQIOWriteObjFuncMap::Instance().registerFunction(string("LatticePropagatorD"), 
 								      QIOWriteLatPropD);
+	success &= TheQIOWriteObjFuncMap::Instance().registerFunction(string("LatticePropagatorH"), 
+								      QIOWriteLatPropH);
 
 	success &= TheQIOWriteObjFuncMap::Instance().registerFunction(string("LatticeFermion"), 
 								      QIOWriteLatFerm);
@@ -548,6 +644,8 @@ namespace Chroma
 	
 	success &= TheQIOWriteObjFuncMap::Instance().registerFunction(string("SubsetVectorsLatticeColorVector"), 
 								      QIOWriteSubsetVectors);
+	success &= TheQIOWriteObjFuncMap::Instance().registerFunction(string("SubsetVectorsLatticeColorVectorH"), 
+								      QIOWriteSubsetVectorsH);
 
 	success &= TheQIOWriteObjFuncMap::Instance().registerFunction(string("MapObjMemoryKeyPropColorVecLatticeFermion"), 
 								      QIOWriteMapObjMemory<KeyPropColorVec_t,LatticeFermion>);
@@ -18,6 +18,8 @@
 #include "handle.h"
 #include <map>
 #include <string>
+#include <fstream>
+#include <cstdio>
 
 namespace Chroma
 {
@@ -54,11 +56,86 @@ namespace Chroma
     //! Getter
     virtual void getRecordXML(XMLBufferWriter& xml) const = 0;
 
+    //! Bytes of data that can be spilled to scratch, 0 if none
+    virtual size_t spillBytes() const {return 0;}
+
+    //! Is the data in memory?
+    virtual bool resident() const {return true;}
+
+    //! Move the data to a scratch file
+    virtual void spill(const std::string& file) {}
+
+    //! Bring spilled data back into memory
+    virtual void reload() {}
+
     // This is key for cleanup
     virtual ~NamedObjectBase() {}
   };
 
 
+  //--------------------------------------------------------------------------------------
+  //! How a named object is written to scratch
+  /*! @ingroup support
+   *
+   * The default is an object that cannot be spilled. Lattice fields
+   * and arrays of them are spilled as the raw node local sites.
+   */
+  template<typename T>
+  struct NamedObjectSpill
+  {
+    static size_t bytes(const T& x) {return 0;}
+    static void write(std::ostream& os, const T& x) {}
+    static void read(std::istream& is, T& x) {}
+  };
+
+  //! Spill a lattice field
+  template<typename T>
+  struct NamedObjectSpill< OLattice<T> >
+  {
+    static size_t bytes(const OLattice<T>& x) 
+    {
+      return Layout::sitesOnNode() * sizeof(T);
+    }
+
+    static void write(std::ostream& os, const OLattice<T>& x) 
+    {
+      os.write((const char *)&(x.elem(0)), bytes(x));
+    }
+
+    static void read(std::istream& is, OLattice<T>& x) 
+    {
+      is.read((char *)&(x.elem(0)), bytes(x));
+    }
+  };
+
+  //! Spill an array of lattice fields
+  template<typename T>
+  struct NamedObjectSpill< multi1d< OLattice<T> > >
+  {
+    static size_t bytes(const multi1d< OLattice<T> >& x) 
+    {
+      return x.size() * Layout::sitesOnNode() * sizeof(T);
+    }
+
+    static void write(std::ostream& os, const multi1d< OLattice<T> >& x) 
+    {
+      int n = x.size();
+      os.write((const char *)&n, sizeof(int));
+      for(int i=0; i < n; ++i)
+	NamedObjectSpill< OLattice<T> >::write(os, x[i]);
+    }
+
+    static void read(std::istream& is, multi1d< OLattice<T> >& x) 
+    {
+      int n;
+      is.read((char *)&n, sizeof(int));
+      x.resize(n);
+      for(int i=0; i < n; ++i)
+	NamedObjectSpill< OLattice<T> >::read(is, x[i]);
+    }
+  };
+
+
   //--------------------------------------------------------------------------------------
   //! Type specific named object
   /*! @ingroup support
@@ -68,13 +145,17 @@ namespace Chroma
   {
   public:
     //! Constructor
-    NamedObject() : data(new T) {}
+    NamedObject() : data(new T), spill_bytes(0) {}
   
     template<typename P1>
-    NamedObject(const P1& p1) : data(new T(p1)) {}
+    NamedObject(const P1& p1) : data(new T(p1)), spill_bytes(0) {}
  
     //! Destructor
-    ~NamedObject() {}
+    ~NamedObject() 
+    {
+      if (spill_file.size() > 0)
+	std::remove(spill_file.c_str());
+    }
 
     //! Setter
     void setFileXML(XMLReader& xml) 
@@ -140,22 +221,84 @@ namespace Chroma
       return *data;
     }
 
+    //! Bytes of data that can be spilled to scratch, 0 if none
+    size_t spillBytes() const
+    {
+      return resident() ? NamedObjectSpill<T>::bytes(*data) : spill_bytes;
+    }
+
+    //! Is the data in memory?
+    bool resident() const {return spill_file.size() == 0;}
+
+    //! Move the data to a scratch file
+    void spill(const std::string& file)
+    {
+      if (! resident())
+	return;
+
+      std::ofstream os(file.c_str(), std::ios::binary | std::ios::trunc);
+      NamedObjectSpill<T>::write(os, *data);
+      os.close();
+      if (os.fail())
+      {
+	std::remove(file.c_str());
+	ostringstream error_stream;
+	error_stream << "NamedObject::spill : error writing scratch file = " << file << endl;
+	throw error_stream.str();
+      }
+
+      // Release the payload; a new one is made on reload
+      spill_bytes = NamedObjectSpill<T>::bytes(*data);
+      spill_file  = file;
+      data = Handle<T>();
+    }
+
+    //! Bring spilled data back into memory
+    void reload()
+    {
+      if (resident())
+	return;
+
+      data = new T;
+
+      std::ifstream is(spill_file.c_str(), std::ios::binary);
+      NamedObjectSpill<T>::read(is, *data);
+      if (is.fail())
+      {
+	ostringstream error_stream;
+	error_stream << "NamedObject::reload : error reading scratch file = " << spill_file << endl;
+	throw error_stream.str();
+      }
+      is.close();
+
+      std::remove(spill_file.c_str());
+      spill_file = "";
+    }
+
   private:
     Handle<T>   data;
     std::string file_xml;
     std::string record_xml;
+    std::string spill_file;
+    size_t      spill_bytes;
   };
 
 
   //--------------------------------------------------------------------------------------
   //! The Map Itself
   /*! @ingroup support
+   *
+   * An optional memory budget bounds the bytes of lattice data held in
+   * memory. Past the budget the least recently used objects are spilled
+   * in their node local layout to a scratch directory and reloaded when
+   * next looked up. Objects looked up since the last call to newTask()
+   * are never spilled, so references taken within a task stay valid.
    */
   class NamedObjectMap 
   {
   public:
     // Creation: clear the map
-    NamedObjectMap() {
+    NamedObjectMap() : budget(0), clock(0), task(0), num_spill(0) {
       the_map.clear();
     };
 
@@ -199,6 +342,8 @@ namespace Chroma
         error_stream << "NamedObjectMap::create : error creating NamedObject for id= " << id << endl;
         throw error_stream.str();
       }
+
+      touch(id);
     }
 
     //! Create an entry of arbitrary type, with 1 parameter
@@ -225,6 +370,8 @@ namespace Chroma
         error_stream << "NamedObjectMap::create : error creating NamedObject for id= " << id << endl;
         throw error_stream.str();
       }
+
+      touch(id);
     }
 
 
@@ -253,6 +400,7 @@ namespace Chroma
 
 	// Delete the record
 	the_map.erase(iter);
+	usage.erase(id);
       }
       else 
       {
@@ -264,6 +412,17 @@ namespace Chroma
     }
   
   
+    //! Delete all items
+    void clear()
+    {
+      while( ! the_map.empty() ) 
+      {
+	std::string id = the_map.begin()->first;
+	erase(id);
+      }
+    }
+  
+  
     //! Dump out all objects
     void dump() const
     {
@@ -287,7 +446,8 @@ namespace Chroma
       }
       else 
       {
-	// Found, return the reference
+	// Found, bring it into memory and return the reference
+	touch(id);
 	return *(iter->second);
       }
     }
@@ -320,9 +480,144 @@ namespace Chroma
       return dynamic_cast<NamedObject<T>&>(get(id)).getData();
     }
 
+    //! Set the memory budget in bytes, 0 for none, and the scratch directory
+    void setMemoryBudget(size_t budget_, const std::string& scratch_dir_)
+    {
+      budget = budget_;
+      scratch_dir = scratch_dir_;
+      enforceBudget("");
+    }
+
+    //! Start a new task; objects used by earlier tasks may be spilled
+    void newTask() {++task;}
+
+    //! Bytes of spillable data held in memory
+    size_t residentBytes() const
+    {
+      size_t bytes = 0;
+      for(MapType_t::const_iterator j = the_map.begin(); j != the_map.end(); j++) 
+	if (j->second->resident())
+	  bytes += j->second->spillBytes();
+
+      return bytes;
+    }
+
   private:
+    //! Record a use of id, reload it if spilled, and keep to the budget
+    void touch(const std::string& id) const
+    {
+      NamedObjectBase* obj = the_map.find(id)->second;
+      if (! obj->resident())
+      {
+	QDPIO::cout << "NamedObjectMap: reloading id = " << id << endl;
+
+	int failed = 0;
+	try
+	{
+	  obj->reload();
+	}
+	catch(const std::string& e)
+	{
+	  std::cerr << "Node " << Layout::nodeNumber() << ": " << e;
+	  failed = 1;
+	}
+	abortOnFailure(failed, "reload", id);
+      }
+
+      Usage_t& u = usage[id];
+      u.last_use = ++clock;
+      u.task = task;
+
+      enforceBudget(id);
+    }
+
+    //! Spill least recently used objects until within the budget
+    void enforceBudget(const std::string& keep) const
+    {
+      if (budget == 0)
+	return;
+
+      // Every node must take the same decisions, since spilling and
+      // reloading go with the collectives of the fields
+      size_t bytes = residentBytes();
+      for(;;)
+      {
+	int over = (bytes > budget) ? 1 : 0;
+	QDPInternal::globalSum(over);
+	if (over == 0)
+	  break;
+
+	// Oldest resident spillable object not used by the current task
+	MapType_t::const_iterator victim = the_map.end();
+	unsigned long oldest = 0;
+	for(MapType_t::const_iterator j = the_map.begin(); j != the_map.end(); j++) 
+	{
+	  const Usage_t& u = usage[j->first];
+	  if (j->first == keep || u.task == task || 
+	      ! j->second->resident() || j->second->spillBytes() == 0)
+	    continue;
+
+	  if (victim == the_map.end() || u.last_use < oldest)
+	  {
+	    victim = j;
+	    oldest = u.last_use;
+	  }
+	}
+
+	int found = (victim == the_map.end()) ? 0 : 1;
+	QDPInternal::globalSum(found);
+	if (found < Layout::numNodes())
+	  break;
+
+	// Every node spills its own sites to its own file
+	std::ostringstream file;
+	file << scratch_dir << "/named_obj_" << Layout::nodeNumber() << "_" << num_spill++ << ".bin";
+
+	QDPIO::cout << "NamedObjectMap: spilling id = " << victim->first << endl;
+	bytes -= victim->second->spillBytes();
+
+	int failed = 0;
+	try
+	{
+	  victim->second->spill(file.str());
+	}
+	catch(const std::string& e)
+	{
+	  std::cerr << "Node " << Layout::nodeNumber() << ": " << e;
+	  failed = 1;
+	}
+	abortOnFailure(failed, "spill", victim->first);
+      }
+    }
+
+    //! Abort on every node if the scratch I/O of any node failed
+    void abortOnFailure(int failed, const std::string& what, const std::string& id) const
+    {
+      QDPInternal::globalSum(failed);
+      if (failed > 0)
+      {
+	QDPIO::cerr << "NamedObjectMap: could not " << what << " id = " << id 
+		    << " on " << failed << " nodes" << endl;
+	QDP_abort(1);
+      }
+    }
+
+    //! Use of an object
+    struct Usage_t
+    {
+      unsigned long last_use;   /*!< clock of the last lookup */
+      unsigned long task;       /*!< task of the last lookup */
+    };
+
     typedef std::map<std::string, NamedObjectBase*> MapType_t;
     MapType_t the_map;
+
+    size_t        budget;
+    std::string   scratch_dir;
+    mutable std::map<std::string, Usage_t>  usage;
+    mutable unsigned long  clock;
+    unsigned long  task;
+    mutable unsigned long  num_spill;
   };
 
 }
@@ -116,6 +116,26 @@ namespace Chroma
     /*! Default implementation provided */
     virtual SystemSolver<T>* qprop(Handle< FermState<T,P,Q> > state,
 				   const GroupXML_t& invParam) const;
+
+    //! Propagators of several masses from one multi-shift solve per source
+    /*!
+     * Provides a default version
+     *
+     * \param q_sol         quark propagators, one per mass ( Write )
+     * \param xml_out       diagnostic output ( Modify )
+     * \param q_src         source ( Read )
+     * \param state         gauge connection state ( Read )
+     * \param masses        quark masses ( Read )
+     * \param invParam      CG inverter parameters ( Read )
+     * \param ncg_had       number of solver iterations ( Write )
+     */
+    virtual void multiQuarkProp(multi1d<typename PropTypeTraits<T>::Type_t>& q_sol,
+				XMLWriter& xml_out,
+				const typename PropTypeTraits<T>::Type_t& q_src,
+				Handle< FermState<T,P,Q> > state,
+				const multi1d<Real>& masses,
+				const GroupXML_t& invParam,
+				int& ncg_had) const;
   };
 
 }
@@ -10,6 +10,12 @@
 
 #include "update/molecdyn/monomial/remez.h"
 
+#include <sstream>
+#include <iomanip>
+#include <fstream>
+#include <cstdio>
+#include <unistd.h>
+
 namespace Chroma 
 { 
 
@@ -70,6 +76,9 @@ namespace Chroma
 	read(paramtop, "digitPrecision", digitPrecision);
       else
 	digitPrecision = 50;
+
+      if (paramtop.count("cacheDir") != 0)
+	read(paramtop, "cacheDir", cacheDir);
     }
 
 
@@ -85,16 +94,157 @@ namespace Chroma
       write(xml, "upperMax", upperMax);
       write(xml, "degree", degree);
       write(xml, "digitPrecision", digitPrecision);
+      if (cacheDir != "")
+	write(xml, "cacheDir", cacheDir);
       
       pop(xml);
     }
 
 
+    //! Anonymous namespace for the coefficient cache
+    namespace
+    {
+      //! Version of the cache file layout. Bump if the contents change.
+      const int cache_version = 1;
+
+      //! Unique key for a set of params
+      std::string cacheKey(const Params& params)
+      {
+	std::ostringstream os;
+	os << std::setprecision(17)
+	   << "n" << params.numPower 
+	   << "_d" << params.denPower
+	   << "_lo" << toDouble(params.lowerMin)
+	   << "_hi" << toDouble(params.upperMax)
+	   << "_deg" << params.degree
+	   << "_prec" << params.digitPrecision;
+	return os.str();
+      }
+
+      //! Cache file name for a set of params
+      std::string cacheFileName(const Params& params)
+      {
+	return params.cacheDir + "/remez_" + cacheKey(params) + ".xml";
+      }
+
+      //! Check on the primary node whether a file exists and tell everybody
+      bool cacheFileExists(const std::string& file)
+      {
+	int exists = 0;
+	if (Layout::primaryNode())
+	{
+	  std::ifstream f(file.c_str());
+	  exists = (f.good()) ? 1 : 0;
+	}
+	QDPInternal::broadcast(exists);
+	return (exists != 0);
+      }
+
+      //! Read coefficients from the cache. Returns false if the file does not match.
+      bool readCache(const Params& params, RemezCoeff_t& pfe, RemezCoeff_t& ipfe)
+      {
+	const std::string file = cacheFileName(params);
+	if (! cacheFileExists(file))
+	  return false;
+
+	try
+	{
+	  XMLReader xml_in(file);
+	  XMLReader paramtop(xml_in, "/RemezCache");
+
+	  int version;
+	  std::string key;
+	  read(paramtop, "version", version);
+	  read(paramtop, "key", key);
+
+	  if (version != cache_version || key != cacheKey(params))
+	  {
+	    QDPIO::cout << name << ": cache file " << file << " does not match params - ignoring it" << endl;
+	    return false;
+	  }
+
+	  XMLReader pfe_in(paramtop, "PFECoeffs");
+	  read(pfe_in, "norm", pfe.norm);
+	  read(pfe_in, "res", pfe.res);
+	  read(pfe_in, "pole", pfe.pole);
+	  XMLReader ipfe_in(paramtop, "IPFECoeffs");
+	  read(ipfe_in, "norm", ipfe.norm);
+	  read(ipfe_in, "res", ipfe.res);
+	  read(ipfe_in, "pole", ipfe.pole);
+	}
+	catch(const std::string& e)
+	{
+	  QDPIO::cout << name << ": error reading cache file " << file << ": " << e << endl;
+	  return false;
+	}
+
+	if (pfe.res.size() != params.degree || pfe.pole.size() != params.degree ||
+	    ipfe.res.size() != params.degree || ipfe.pole.size() != params.degree)
+	{
+	  QDPIO::cout << name << ": cache file " << file << " has wrong degree - ignoring it" << endl;
+	  return false;
+	}
+
+	return true;
+      }
+
+      //! Write coefficients to the cache
+      /*! The file is written under a temporary name and then renamed, so
+       *  concurrent jobs never see a partially written cache file. */
+      void writeCache(const Params& params, const RemezCoeff_t& pfe, const RemezCoeff_t& ipfe)
+      {
+	const std::string file = cacheFileName(params);
+
+	std::ostringstream tmp_file;
+	tmp_file << file << ".tmp" << getpid();
+
+	{
+	  XMLFileWriter xml_out(tmp_file.str());
+	  push(xml_out, "RemezCache");
+	  write(xml_out, "version", cache_version);
+	  write(xml_out, "key", cacheKey(params));
+	  push(xml_out, "PFECoeffs");
+	  write(xml_out, "norm", pfe.norm);
+	  write(xml_out, "res", pfe.res);
+	  write(xml_out, "pole", pfe.pole);
+	  pop(xml_out);
+	  push(xml_out, "IPFECoeffs");
+	  write(xml_out, "norm", ipfe.norm);
+	  write(xml_out, "res", ipfe.res);
+	  write(xml_out, "pole", ipfe.pole);
+	  pop(xml_out);
+	  pop(xml_out);
+	  xml_out.close();
+	}
+
+	if (Layout::primaryNode())
+	{
+	  if (std::rename(tmp_file.str().c_str(), file.c_str()) != 0)
+	  {
+	    std::cerr << name << ": could not rename " << tmp_file.str() 
+		      << " to " << file << " - not cached" << endl;
+	    std::remove(tmp_file.str().c_str());
+	  }
+	}
+      }
+    }
+
+
     // Produce the partial-fraction-expansion (PFE) and its inverse (IPFE)
     void RatApprox::operator()(RemezCoeff_t& pfe, RemezCoeff_t& ipfe) const
     {
       START_CODE();
 
+      if (params.cacheDir != "")
+      {
+	if (readCache(params, pfe, ipfe))
+	{
+	  QDPIO::cout << name << ": read coefficients from cache " << cacheFileName(params) << endl;
+	  END_CODE();
+	  return;
+	}
+      }
+
       unsigned long prec = abs(params.digitPrecision);
       unsigned long power_num = abs(params.numPower);
       unsigned long power_den = abs(params.denPower);
@@ -131,6 +281,12 @@ namespace Chroma
 	ipfe = remez.getPFE();
       }
 
+      if (params.cacheDir != "")
+      {
+	QDPIO::cout << name << ": writing coefficients to cache " << cacheFileName(params) << endl;
+	writeCache(params, pfe, ipfe);
+      }
+
       END_CODE();
     }
 
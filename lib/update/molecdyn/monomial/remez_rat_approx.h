@@ -32,6 +32,7 @@ namespace Chroma
       Real upperMax;        /*!< upper bound of approximation region */
       int  degree;          /*!< degree of approximation */
       int  digitPrecision;  /*!< number of digits used for bigfloat calcs */
+      std::string cacheDir; /*!< directory for cached coefficients (empty means no cache) */
     };
 
 
@@ -18,17 +18,28 @@ namespace Chroma
 								   const std::string& path) 
       {
 	unsigned int max_chrono = 1;
+	bool single_prec = false;
 	
 	try 
 	{
 	  XMLReader paramtop(xml, path);
 	  read( paramtop, "./MaxChrono", max_chrono);
+
+	  // Optionally keep the history in single precision
+	  if( paramtop.count("./SinglePrecHistory") == 1 ) {
+	    read( paramtop, "./SinglePrecHistory", single_prec);
+	  }
 	}
 	catch( const std::string& e ) { 
 	  QDPIO::cerr << "Caught exception reading XML: " << e << endl;
 	  QDP_abort(1);
 	}
       
+	if( single_prec ) { 
+	  QDPIO::cout << "MRE Predictor: storing history in single precision" << endl;
+	  return new MinimalResidualExtrapolation4DChronoPredictor<LatticeFermion,LatticeFermionF>(max_chrono);
+	}
+
 	return new MinimalResidualExtrapolation4DChronoPredictor<LatticeFermion>(max_chrono);
       }
     
@@ -67,18 +78,29 @@ namespace Chroma
 								   const std::string& path) 
       {
 	unsigned int max_chrono = 1;
+	bool single_prec = false;
 
 	try 
 	{
 	  XMLReader paramtop(xml, path);
 	  read( paramtop, "./MaxChrono", max_chrono);
+
+	  // Optionally keep the history in single precision
+	  if( paramtop.count("./SinglePrecHistory") == 1 ) {
+	    read( paramtop, "./SinglePrecHistory", single_prec);
+	  }
 	}
 	catch( const std::string& e ) { 
 	  QDPIO::cerr << "Caught exception reading XML: " << e << endl;
 	  QDP_abort(1);
 	}
 	
-	return new MinimalResidualExtrapolation5DChronoPredictor(N5,max_chrono);
+	if( single_prec ) { 
+	  QDPIO::cout << "MRE Predictor: storing history in single precision" << endl;
+	  return new MinimalResidualExtrapolation5DChronoPredictor<LatticeFermionF>(N5,max_chrono);
+	}
+
+	return new MinimalResidualExtrapolation5DChronoPredictor<LatticeFermion>(N5,max_chrono);
       }
       
       //! Local registration flag
@@ -102,7 +124,8 @@ namespace Chroma
 
 
 
-  void MinimalResidualExtrapolation5DChronoPredictor::operator()(
+  template<typename TS>
+  void MinimalResidualExtrapolation5DChronoPredictor<TS>::operator()(
 		    multi1d<LatticeFermion>& psi,
 		    const LinearOperatorArray<LatticeFermion>& M,
 		    const multi1d<LatticeFermion>& chi) 
@@ -120,7 +143,7 @@ namespace Chroma
     case 1:
       {
 	QDPIO::cout << "MRE Predictor: Only 1 vector stored. Giving you last solution " << endl;
-	chrono_buf->get(0,psi);
+	getVec(0,psi);
       }
       break;
     default:
@@ -135,8 +158,9 @@ namespace Chroma
   }
 
 
+  template<typename TS>
   void 
-  MinimalResidualExtrapolation5DChronoPredictor::find_extrap_solution(
+  MinimalResidualExtrapolation5DChronoPredictor<TS>::find_extrap_solution(
 		       	  multi1d<LatticeFermion>& psi,
 			  const LinearOperatorArray<LatticeFermion>& A,
 			  const multi1d<LatticeFermion>& chi) 
@@ -161,7 +185,7 @@ namespace Chroma
 
       // Grab the relevant vector from the chronobuf
       multi1d<LatticeFermion> tmpvec(N5);
-      chrono_buf->get(i, tmpvec);
+      getVec(i, tmpvec);
 
       if( i == 0 ) { 
 	// First vector we just take
@@ -28,21 +28,41 @@ namespace Chroma
   }
 
   //! Minimal residual predictor
-  /*! @ingroup predictor */
-  template<typename T>
+  /*! @ingroup predictor
+   *
+   * The history vectors are kept in the storage type TS, which
+   * may be of lower precision than T (e.g. LatticeFermionF). They are
+   * promoted back to T when the extrapolation basis is built.
+   */
+  template<typename T, typename TS = T>
   class MinimalResidualExtrapolation4DChronoPredictor  
     : public AbsTwoStepChronologicalPredictor4D<T> 
   {
   private:
-    Handle< CircularBuffer<T> > chrono_bufX;
-    Handle< CircularBuffer<T> > chrono_bufY;
+    Handle< CircularBuffer<TS> > chrono_bufX;
+    Handle< CircularBuffer<TS> > chrono_bufY;
+
+    //! Get the i-th most recent vector, promoted to type T
+    void getVec(const Handle< CircularBuffer<TS> >& chrono_buf, 
+		unsigned int i, T& x) const
+    {
+      TS tmp;
+      chrono_buf->get(i, tmp);
+      x = tmp;
+    }
+
+    //! Convert a vector to the storage type
+    void toStorage(const T& x, TS& tmp) const
+    {
+      tmp = x;
+    }
 
   void 
   find_extrap_solution(
 		       T& psi,
 		       const LinearOperator<T>& M,
 		       const T& chi,
-		       const Handle<CircularBuffer<T> >& chrono_buf, 
+		       const Handle<CircularBuffer<TS> >& chrono_buf, 
 		       enum PlusMinus isign) 
     {
       START_CODE();
@@ -77,7 +97,7 @@ namespace Chroma
 	
 	// Grab the relevant vector from the chronobuf
 	T tmpvec;
-	chrono_buf->get(i, tmpvec);
+	getVec(chrono_buf, i, tmpvec);
 	
 	if( i == 0 ) { 
 	  // First vector we just take
@@ -177,8 +197,8 @@ namespace Chroma
   public:
     
     MinimalResidualExtrapolation4DChronoPredictor(unsigned int max_chrono) : 
-      chrono_bufX(new CircularBuffer<T>(max_chrono)),
-      chrono_bufY(new CircularBuffer<T>(max_chrono)) {}
+      chrono_bufX(new CircularBuffer<TS>(max_chrono)),
+      chrono_bufY(new CircularBuffer<TS>(max_chrono)) {}
     
     // Destructor is automagic
     ~MinimalResidualExtrapolation4DChronoPredictor(void) {}
@@ -203,7 +223,7 @@ namespace Chroma
       case 1:
 	{
 	  QDPIO::cout << "MRE Predictor: Only 1 vector stored. Giving you last solution " << endl;
-	  chrono_bufX->get(0,X);
+	  getVec(chrono_bufX, 0, X);
 	}
 	break;
       default:
@@ -243,7 +263,7 @@ namespace Chroma
       case 1:
 	{
 	  QDPIO::cout << "MRE Predictor: Only 1 vector stored. Giving you last solution " << endl;
-	  chrono_bufY->get(0,Y);
+	  getVec(chrono_bufY, 0, Y);
 	}
 	break;
       default:
@@ -272,7 +292,9 @@ namespace Chroma
       START_CODE();
 
       QDPIO::cout << "MREPredictor: registering new X solution. " << endl;
-      chrono_bufX->push(X);
+      TS tmp;
+      toStorage(X, tmp);
+      chrono_bufX->push(tmp);
       QDPIO::cout << "MREPredictor: number of X vectors stored is = " << chrono_bufX->size() << endl;
     
       END_CODE();
@@ -284,7 +306,9 @@ namespace Chroma
       START_CODE();
 
       QDPIO::cout << "MREPredictor: registering new Y solution. " << endl;
-      chrono_bufY->push(Y);
+      TS tmp;
+      toStorage(Y, tmp);
+      chrono_bufY->push(tmp);
       QDPIO::cout << "MREPredictor: number of Y vectors stored is = " << chrono_bufY->size() << endl;
     
       END_CODE();
@@ -292,12 +316,16 @@ namespace Chroma
 
     void replaceXHead(const T& v)
     {
-      chrono_bufX->replaceHead(v);
+      TS tmp;
+      toStorage(v, tmp);
+      chrono_bufX->replaceHead(tmp);
     }
 
     void replaceYHead(const T& v)
     {
-      chrono_bufY->replaceHead(v);
+      TS tmp;
+      toStorage(v, tmp);
+      chrono_bufY->replaceHead(tmp);
     }
 
 
@@ -314,20 +342,37 @@ namespace Chroma
 
   
   //! Minimal residual predictor
-  /*! @ingroup predictor */
+  /*! @ingroup predictor
+   *
+   * The history is kept in the storage type TS, which may be of lower 
+   * precision than LatticeFermion (e.g. LatticeFermionF).
+   */
+  template<typename TS>
   class MinimalResidualExtrapolation5DChronoPredictor :
     public AbsChronologicalPredictor5D<LatticeFermion> {
     
   private: 
-    Handle< CircularBufferArray<LatticeFermion>  > chrono_buf;
+    Handle< CircularBufferArray<TS>  > chrono_buf;
     const int N5;
 
+    //! Get the i-th most recent vector, promoted to LatticeFermion
+    void getVec(unsigned int i, multi1d<LatticeFermion>& x) const
+    {
+      multi1d<TS> tmp(N5);
+      chrono_buf->get(i, tmp);
+
+      x.resize(N5);
+      for(int s=0; s < N5; s++) { 
+	x[s] = tmp[s];
+      }
+    }
+
     void find_extrap_solution(multi1d<LatticeFermion>& psi, 
 			      const LinearOperatorArray<LatticeFermion>& A,
 			      const multi1d<LatticeFermion>& chi);
 
   public:
-    MinimalResidualExtrapolation5DChronoPredictor(const int N5_, const unsigned int max_chrono) : chrono_buf( new CircularBufferArray<LatticeFermion>(max_chrono, N5_) ), N5(N5_) {}
+    MinimalResidualExtrapolation5DChronoPredictor(const int N5_, const unsigned int max_chrono) : chrono_buf( new CircularBufferArray<TS>(max_chrono, N5_) ), N5(N5_) {}
 
       
     ~MinimalResidualExtrapolation5DChronoPredictor(void) {}
@@ -353,7 +398,11 @@ namespace Chroma
       START_CODE();
 
       QDPIO::cout << "MRE Predictor: registering new solution. " << endl;
-      chrono_buf->push(psi);
+      multi1d<TS> tmp(psi.size());
+      for(int s=0; s < psi.size(); s++) { 
+	tmp[s] = psi[s];
+      }
+      chrono_buf->push(tmp);
       QDPIO::cout << "MRE Predictor: number of vectors stored is = " << chrono_buf->size() << endl;
     
       END_CODE();
@@ -0,0 +1,146 @@
+/*! \file
+ *  \brief Error bounded compressed storage of lattice fields
+ */
+
+#include "util/ferm/compressed_lattice.h"
+
+#include <sstream>
+
+namespace Chroma
+{
+
+  // Metadata of compressed storage
+  void writeCompressedXML(XMLWriter& xml, int block_size, double rel_block_error_bound,
+			  double rel_norm_error, const std::string& file_xml)
+  {
+    push(xml, "CompressedLattice");
+
+    write(xml, "codec", std::string("HALF_BLOCK"));
+    write(xml, "block_size", block_size);
+    write(xml, "rel_block_error_bound", rel_block_error_bound);
+
+    if (rel_norm_error >= 0)
+      write(xml, "rel_norm_error", rel_norm_error);
+
+    if (file_xml.size() > 0)
+    {
+      push(xml, "FileXML");
+      xml.writeXML(file_xml);
+      pop(xml);
+    }
+
+    pop(xml);
+  }
+
+
+  // Does the file xml describe compressed storage?
+  bool isCompressedXML(XMLReader& file_xml)
+  {
+    if (file_xml.count("/CompressedLattice") != 1)
+      return false;
+
+    std::string codec;
+    int block_size;
+    read(file_xml, "/CompressedLattice/codec", codec);
+    read(file_xml, "/CompressedLattice/block_size", block_size);
+
+    if (codec != "HALF_BLOCK" || block_size != 2*Nc)
+    {
+      QDPIO::cerr << __func__ << ": unsupported codec " << codec 
+		  << " with block_size= " << block_size << endl;
+      QDP_abort(1);
+    }
+
+    return true;
+  }
+
+
+  //! Anonymous namespace
+  namespace
+  {
+    const std::string marker_open  = "<CompressedLattice>";
+    const std::string marker_close = "</CompressedLattice>";
+
+    //! End of the marker that leads the user data of a compressed map object
+    /*! Returns npos if the user data does not start with the marker */
+    size_t markerEnd(const std::string& user_data)
+    {
+      size_t pos = 0;
+
+      // Skip the prologue of the xml writer
+      if (user_data.compare(0, 5, "<?xml") == 0)
+      {
+	pos = user_data.find("?>");
+	if (pos == std::string::npos)
+	  return std::string::npos;
+	pos = user_data.find_first_not_of(" \t\r\n", pos+2);
+	if (pos == std::string::npos)
+	  return std::string::npos;
+      }
+
+      if (user_data.compare(pos, marker_open.size(), marker_open) != 0)
+	return std::string::npos;
+
+      size_t end = user_data.find(marker_close, pos);
+      if (end == std::string::npos)
+	return std::string::npos;
+
+      return end + marker_close.size();
+    }
+  }
+
+
+  // Does the user data of a map object describe compressed storage?
+  bool isCompressedUserdata(const std::string& user_data)
+  {
+    // The user data need not be xml at all
+    size_t end = markerEnd(user_data);
+    if (end == std::string::npos)
+      return false;
+
+    std::istringstream is(user_data.substr(0, end));
+    XMLReader xml(is);
+
+    return isCompressedXML(xml);
+  }
+
+
+  // User data of a compressed map object
+  std::string wrapCompressedUserdata(const std::string& user_data)
+  {
+    XMLBufferWriter marker;
+    writeCompressedXML(marker, CompressedLattice<LatticeColorVector>::blockSize(),
+		       CompressedLattice<LatticeColorVector>::relBlockErrorBound(), -1, "");
+
+    return marker.printCurrentContext() + "\n" + user_data;
+  }
+
+
+  // The caller's user data in that of a compressed map object
+  std::string unwrapCompressedUserdata(const std::string& user_data)
+  {
+    size_t end = markerEnd(user_data);
+    if (end == std::string::npos)
+      return user_data;
+
+    if (end < user_data.size() && user_data[end] == '\n')
+      ++end;
+
+    return user_data.substr(end);
+  }
+
+
+  // Replace the file xml of compressed storage by the original
+  void unwrapCompressedFileXML(XMLReader& file_xml)
+  {
+    std::ostringstream os;
+    {
+      XMLReader orig(file_xml, "/CompressedLattice/FileXML/*");
+      orig.printCurrentContext(os);
+    }
+
+    std::istringstream is(os.str());
+    file_xml.open(is);
+  }
+
+}  // end namespace Chroma
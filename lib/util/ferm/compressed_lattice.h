@@ -0,0 +1,275 @@
+// -*- C++ -*-
+/*! \file
+ *  \brief Error bounded compressed storage of lattice fields
+ */
+
+#ifndef __compressed_lattice_h__
+#define __compressed_lattice_h__
+
+#include "chromabase.h"
+#include "util/ferm/subset_ev_pair.h"
+
+namespace Chroma
+{
+
+  //! Half precision storage of a lattice field with a scale per block
+  /*! \ingroup ferm
+   *
+   * The reals of every site are cut into blocks of 2*Nc, a colour vector
+   * or a row of a colour matrix. A block keeps its largest magnitude in
+   * single precision and its reals as 16 bit integers relative to it. Each
+   * real is then off by at most relBlockErrorBound() times the largest
+   * magnitude of its block.
+   *
+   * The pieces are ordinary lattice fields so they can go through QIO or a
+   * BinaryWriter unchanged.
+   */
+  template<typename T>
+  class CompressedLattice
+  {
+  public:
+    //! Floating type of the field
+    typedef typename WordType<T>::Type_t W;
+
+    //! Reals in a block
+    static int blockSize() {return 2*Nc;}
+
+    //! Reals in a site
+    static int numReals() {return sizeof(typename T::Subtype_t) / sizeof(W);}
+
+    //! Bound on the error of a real relative to the largest of its block
+    static double relBlockErrorBound() {return 0.5/32767 + 1.0/(1 << 23);}
+
+    //! Size the pieces for a field of type T
+    void resize()
+    {
+      scale.resize(numReals() / blockSize());
+      words.resize(numReals() / 2);
+    }
+
+    //! Compress a field
+    void compress(const T& x);
+
+    //! Decompress into a field
+    void decompress(T& x) const;
+
+    //! Relative error in the norm of x after a round trip
+    Double relNormError(const T& x) const
+    {
+      T y;
+      decompress(y);
+      return sqrt(norm2(x - y) / norm2(x));
+    }
+
+    multi1d<LatticeRealF>    scale;   /*!< largest magnitude of each block */
+    multi1d<LatticeInteger>  words;   /*!< two 16 bit integers per word, low one first */
+  };
+
+
+  //! Thread kernels of the compressed storage
+  namespace CompressedLatticeEnv
+  {
+    template<typename T>
+    struct CompressArgs
+    {
+      const T&                 x;
+      CompressedLattice<T>&    c;
+    };
+
+    template<typename T>
+    void compressSiteLoop(int lo, int hi, int myId, CompressArgs<T>* a)
+    {
+      typedef typename CompressedLattice<T>::W  W;
+
+      const int nb = CompressedLattice<T>::blockSize();
+      const int nblock = CompressedLattice<T>::numReals() / nb;
+
+      int q[2*Nc];
+
+      for(int site=lo; site < hi; ++site)
+      {
+	const W* x = (const W *)&(a->x.elem(site));
+
+	for(int b=0; b < nblock; ++b, x += nb)
+	{
+	  W m = 0;
+	  for(int k=0; k < nb; ++k)
+	  {
+	    W ax = (x[k] < 0) ? -x[k] : x[k];
+	    if (ax > m)
+	      m = ax;
+	  }
+
+	  REAL32& sm = a->c.scale[b].elem(site).elem().elem().elem();
+	  sm = m;
+
+	  double inv = (sm > 0) ? 32767.0 / sm : 0.0;
+	  for(int k=0; k < nb; ++k)
+	  {
+	    double r = floor(x[k]*inv + 0.5);
+	    q[k] = (r > 32767) ? 32767 : ((r < -32767) ? -32767 : int(r));
+	  }
+
+	  for(int k=0; k < nb; k += 2)
+	  {
+	    unsigned int w = (((unsigned int)q[k]) & 0xffff) | ((((unsigned int)q[k+1]) & 0xffff) << 16);
+	    a->c.words[(b*nb + k)/2].elem(site).elem().elem().elem() = w;
+	  }
+	}
+      }
+    }
+
+    template<typename T>
+    struct DecompressArgs
+    {
+      const CompressedLattice<T>&  c;
+      T&                           x;
+    };
+
+    template<typename T>
+    void decompressSiteLoop(int lo, int hi, int myId, DecompressArgs<T>* a)
+    {
+      typedef typename CompressedLattice<T>::W  W;
+
+      const int nb = CompressedLattice<T>::blockSize();
+      const int nblock = CompressedLattice<T>::numReals() / nb;
+
+      for(int site=lo; site < hi; ++site)
+      {
+	W* x = (W *)&(a->x.elem(site));
+
+	for(int b=0; b < nblock; ++b, x += nb)
+	{
+	  double f = a->c.scale[b].elem(site).elem().elem().elem() / 32767.0;
+
+	  for(int k=0; k < nb; k += 2)
+	  {
+	    unsigned int w = a->c.words[(b*nb + k)/2].elem(site).elem().elem().elem();
+	    x[k]   = W(short(w & 0xffff) * f);
+	    x[k+1] = W(short(w >> 16) * f);
+	  }
+	}
+      }
+    }
+  }
+
+
+  // Compress a field
+  template<typename T>
+  void CompressedLattice<T>::compress(const T& x)
+  {
+    START_CODE();
+
+    resize();
+
+    CompressedLatticeEnv::CompressArgs<T> a = {x, *this};
+    dispatch_to_threads(Layout::sitesOnNode(), a, CompressedLatticeEnv::compressSiteLoop<T>);
+
+    END_CODE();
+  }
+
+
+  // Decompress into a field
+  template<typename T>
+  void CompressedLattice<T>::decompress(T& x) const
+  {
+    START_CODE();
+
+    CompressedLatticeEnv::DecompressArgs<T> a = {*this, x};
+    dispatch_to_threads(Layout::sitesOnNode(), a, CompressedLatticeEnv::decompressSiteLoop<T>);
+
+    END_CODE();
+  }
+
+
+  /*!
+   * \ingroup ferm
+   * @{
+   */
+  //! CompressedLattice read
+  template<typename T>
+  void read(BinaryReader& bin, CompressedLattice<T>& c)
+  {
+    c.resize();
+    for(int i=0; i < c.scale.size(); ++i)
+      read(bin, c.scale[i]);
+    for(int i=0; i < c.words.size(); ++i)
+      read(bin, c.words[i]);
+  }
+
+  //! CompressedLattice write
+  template<typename T>
+  void write(BinaryWriter& bin, const CompressedLattice<T>& c)
+  {
+    for(int i=0; i < c.scale.size(); ++i)
+      write(bin, c.scale[i]);
+    for(int i=0; i < c.words.size(); ++i)
+      write(bin, c.words[i]);
+  }
+
+  //! Compress a map object value
+  template<typename T>
+  void compressValue(const T& x, CompressedLattice<T>& c)
+  {
+    c.compress(x);
+  }
+
+  //! Decompress a map object value
+  template<typename T>
+  void decompressValue(const CompressedLattice<T>& c, T& x)
+  {
+    c.decompress(x);
+  }
+
+  //! Compress a map object value
+  template<typename T>
+  void compressValue(const EVPair<T>& x, EVPair< CompressedLattice<T> >& c)
+  {
+    c.eigenValue = x.eigenValue;
+    c.eigenVector.compress(x.eigenVector);
+  }
+
+  //! Decompress a map object value
+  template<typename T>
+  void decompressValue(const EVPair< CompressedLattice<T> >& c, EVPair<T>& x)
+  {
+    x.eigenValue = c.eigenValue;
+    c.eigenVector.decompress(x.eigenVector);
+  }
+
+
+  //! Metadata of compressed storage
+  /*!
+   * Writes the CompressedLattice group naming the codec and its error
+   * bound. The relative norm error is written if not negative, and the
+   * original file xml, if given, under FileXML.
+   */
+  void writeCompressedXML(XMLWriter& xml, int block_size, double rel_block_error_bound,
+			  double rel_norm_error, const std::string& file_xml);
+
+  //! Does the file xml describe compressed storage?
+  /*! Aborts on a codec it cannot read */
+  bool isCompressedXML(XMLReader& file_xml);
+
+  //! Does the user data of a map object describe compressed storage?
+  /*! Aborts on a codec it cannot read */
+  bool isCompressedUserdata(const std::string& user_data);
+
+  //! User data of a compressed map object
+  /*!
+   * The CompressedLattice group leads, followed on a new line by the
+   * caller's user data, which need not be xml.
+   */
+  std::string wrapCompressedUserdata(const std::string& user_data);
+
+  //! The caller's user data in that of a compressed map object
+  /*! User data without the CompressedLattice group is returned as is */
+  std::string unwrapCompressedUserdata(const std::string& user_data);
+
+  //! Replace the file xml of compressed storage by the original
+  void unwrapCompressedFileXML(XMLReader& file_xml);
+  /*! @} */  // end of group ferm
+
+} // namespace Chroma
+
+#endif
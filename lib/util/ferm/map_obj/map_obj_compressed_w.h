@@ -0,0 +1,87 @@
+// -*- C++ -*-
+/*! \file
+ * \brief Map object holding its values in compressed form
+ */
+
+#ifndef __map_obj_compressed_w_h__
+#define __map_obj_compressed_w_h__
+
+#include "chromabase.h"
+#include "qdp_map_obj.h"
+#include "handle.h"
+#include "util/ferm/compressed_lattice.h"
+
+namespace Chroma
+{
+
+  //! Map object holding its values in compressed form
+  /*! \ingroup ferm
+   *
+   * Values of type V are compressed into CV on insert and decompressed on
+   * get. The values live in another map object, typically on disk. Its
+   * user data starts with the CompressedLattice group that tells readers
+   * the values are compressed, and user data given here is kept after it.
+   */
+  template<typename K, typename V, typename CV>
+  class MapObjectCompressed : public QDP::MapObject<K,V>
+  {
+  public:
+    //! Wrap the map object holding the compressed values
+    MapObjectCompressed(Handle< QDP::MapObject<K,CV> > obj_) : obj(obj_) {}
+
+    //! Destructor
+    ~MapObjectCompressed() {}
+
+    //! Exists?
+    bool exist(const K& key) const {return obj->exist(key);}
+
+    //! Insert
+    int insert(const K& key, const V& val)
+    {
+      CV cval;
+      compressValue(val, cval);
+      return obj->insert(key, cval);
+    }
+
+    //! Accessor
+    int get(const K& key, V& val) const
+    {
+      CV cval;
+      int ret = obj->get(key, cval);
+      if (ret == 0)
+	decompressValue(cval, val);
+
+      return ret;
+    }
+
+    //! Flush out state of object
+    void flush() {obj->flush();}
+
+    //! Size of map
+    unsigned int size() const {return obj->size();}
+
+    //! Dump keys
+    void keys(std::vector<K>& keys_) const {obj->keys(keys_);}
+
+    //! Insert user data
+    int insertUserdata(const std::string& user_data) 
+    {
+      return obj->insertUserdata(wrapCompressedUserdata(user_data));
+    }
+
+    //! Get user data
+    int getUserdata(std::string& user_data) const 
+    {
+      std::string u;
+      int ret = obj->getUserdata(u);
+      user_data = unwrapCompressedUserdata(u);
+      return ret;
+    }
+
+  private:
+    Handle< QDP::MapObject<K,CV> >  obj;
+  };
+
+}
+
+#endif
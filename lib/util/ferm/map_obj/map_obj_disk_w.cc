@@ -7,6 +7,7 @@
 #include "qdp_map_obj_disk.h"
 #include "util/ferm/map_obj/map_obj_factory_w.h"
 #include "util/ferm/map_obj/map_obj_disk_w.h"
+#include "util/ferm/map_obj/map_obj_compressed_w.h"
 #include "util/ferm/key_prop_colorvec.h"
 #include <string>
 
@@ -25,6 +26,7 @@ namespace Chroma
 	Params(XMLReader& xml_in, const std::string& path);
 
 	std::string   file_name;
+	bool          compress;    /*!< store the values in half precision with a scale per block */
       };
 
       // Reader for input parameters
@@ -33,6 +35,35 @@ namespace Chroma
 	XMLReader paramtop(xml, path);
 
 	read(paramtop, "FileName", file_name);
+
+	compress = false;
+	if (paramtop.count("Compress") == 1)
+	  read(paramtop, "Compress", compress);
+      }
+
+
+      //! Disk map object, compressed if asked for
+      template<typename K, typename V, typename CV>
+      QDP::MapObject<K,V>* createMapObjDisk(const Params& params)
+      {
+	if (! params.compress)
+	{
+	  std::string  user_data;
+
+	  QDP::MapObjectDisk<K,V>* obj = new QDP::MapObjectDisk<K,V>();
+	  obj->insertUserdata(user_data);
+	  obj->open(params.file_name, std::ios_base::in |  std::ios_base::out |  std::ios_base::trunc);
+
+	  return obj;
+	}
+
+	// The user data tells readers the values are compressed
+	QDP::MapObjectDisk<K,CV>* obj = new QDP::MapObjectDisk<K,CV>();
+	MapObjectCompressed<K,V,CV>* cobj = new MapObjectCompressed<K,V,CV>(Handle< QDP::MapObject<K,CV> >(obj));
+	cobj->insertUserdata(std::string());
+	obj->open(params.file_name, std::ios_base::in |  std::ios_base::out |  std::ios_base::trunc);
+
+	return cobj;
       }
 
 
@@ -43,13 +74,9 @@ namespace Chroma
       {
 	// Needs parameters...
 	Params params(xml_in, path);
-	std::string  user_data;
-	
-	QDP::MapObjectDisk<int,EVPair<LatticeColorVector> >* obj = new QDP::MapObjectDisk<int,EVPair<LatticeColorVector> >();
-	obj->insertUserdata(user_data);
-	obj->open(params.file_name, std::ios_base::in |  std::ios_base::out |  std::ios_base::trunc);
 
-	return obj;
+	return createMapObjDisk<int, EVPair<LatticeColorVector>, 
+	  EVPair< CompressedLattice<LatticeColorVector> > >(params);
       }
 
       //! Callback function
@@ -58,13 +85,9 @@ namespace Chroma
       {
 	// Needs parameters...
 	Params params(xml_in, path);
-	std::string  user_data;
-
-	QDP::MapObjectDisk<KeyPropColorVec_t,LatticeFermion>* obj = new QDP::MapObjectDisk<KeyPropColorVec_t,LatticeFermion>();
-	obj->insertUserdata(user_data);
-	obj->open(params.file_name, std::ios_base::in |  std::ios_base::out |  std::ios_base::trunc);
 
-	return obj;
+	return createMapObjDisk<KeyPropColorVec_t, LatticeFermion, 
+	  CompressedLattice<LatticeFermion> >(params);
       }
 
       //! Local registration flag
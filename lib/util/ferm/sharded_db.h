@@ -0,0 +1,531 @@
+// -*- C++ -*-
+/*! \file
+ * \brief Key/value DB split into shards written by different nodes
+ */
+
+#ifndef __sharded_db_h__
+#define __sharded_db_h__
+
+#include "chromabase.h"
+#include "handle.h"
+#include "qdp_db.h"
+#include "util/ferm/key_val_db.h"
+
+#include <fcntl.h>
+#include <fstream>
+#include <vector>
+
+namespace Chroma
+{
+  //---------------------------------------------------------------------
+  //! Already serialized key
+  /*! \ingroup ferm
+   *
+   * Carries the bytes of a SerialDBKey so a shard stores exactly what a
+   * SerialDBKey would, without the QDP buffers that only live on the
+   * primary node.
+   */
+  class RawDBKey : public DBKey
+  {
+  public:
+    //! Default constructor
+    RawDBKey() {}
+
+    //! Constructor from bytes
+    RawDBKey(const std::string& b) : bytes_(b) {}
+
+    //! Getter
+    const std::string& bytes() const {return bytes_;}
+
+    // Part of Serializable
+    const unsigned short serialID (void) const {return 456;}
+
+    void writeObject (std::string& output) const throw (SerializeException) {
+      output = bytes_;
+    }
+
+    void readObject (const std::string& input) throw (SerializeException) {
+      bytes_ = input;
+    }
+
+    // Part of DBKey
+    int hasHashFunc (void) const {return 0;}
+    int hasCompareFunc (void) const {return 0;}
+
+    /**
+     * Empty hash and compare functions. We are using default functions.
+     */
+    static unsigned int hash (const void* bytes, unsigned int len) {return 0;}
+    static int compare (const FFDB_DBT* k1, const FFDB_DBT* k2) {return 0;}
+
+  private:
+    std::string  bytes_;
+  };
+
+
+  //---------------------------------------------------------------------
+  //! Already serialized value
+  /*! \ingroup ferm */
+  class RawDBData : public DBData
+  {
+  public:
+    //! Default constructor
+    RawDBData() {}
+
+    //! Constructor from bytes
+    RawDBData(const std::string& b) : bytes_(b) {}
+
+    //! Getter
+    const std::string& bytes() const {return bytes_;}
+
+    // Part of Serializable
+    const unsigned short serialID (void) const {return 123;}
+
+    void writeObject (std::string& output) const throw (SerializeException) {
+      output = bytes_;
+    }
+
+    void readObject (const std::string& input) throw (SerializeException) {
+      bytes_ = input;
+    }
+
+  private:
+    std::string  bytes_;
+  };
+
+
+  //---------------------------------------------------------------------
+  //! Binary buffer writer that writes on every node
+  /*! \ingroup ferm
+   *
+   * BinaryBufferWriter only keeps the bytes on the primary node. This one
+   * keeps the same big endian bytes on whatever node serializes, so a
+   * node can serialize the pairs of its own shards.
+   */
+  class NodeBinaryBufferWriter : public BinaryBufferWriter
+  {
+  public:
+    //! Write data on this node
+    void writeArray(const char* output, size_t size, size_t nmemb)
+    {
+      if (QDPUtil::big_endian())
+	getOstream().write(output, size*nmemb);
+      else
+      {
+	std::vector<char> buf(output, output + size*nmemb);
+	QDPUtil::byte_swap((void *)&buf[0], size, nmemb);
+	getOstream().write(&buf[0], size*nmemb);
+      }
+    }
+
+    //! The bytes written on this node
+    std::string str() const {return strPrimaryNode();}
+  };
+
+  //! Bytes of a key, serialized on this node
+  template<typename T>
+  std::string nodeBytes(const SerialDBKey<T>& k)
+  {
+    NodeBinaryBufferWriter bin;
+    write(bin, k.key());
+    return bin.str();
+  }
+
+  //! Bytes of a value, serialized on this node
+  template<typename T>
+  std::string nodeBytes(const SerialDBData<T>& d)
+  {
+    NodeBinaryBufferWriter bin;
+    write(bin, d.data());
+    return bin.str();
+  }
+
+
+  //---------------------------------------------------------------------
+  //! Key/value DB split into shards written by different nodes
+  /*! \ingroup ferm
+   *
+   * A drop-in for BinaryStoreDB. With no shards, it is a single file
+   * written by the primary node. With N shards, the file is a small xml
+   * manifest, and shard s is the DB file.shard<s>, written by its own
+   * node. A key lives in the shard given by a hash of its bytes. Each
+   * shard is an ordinary DB of the same keys and values and carries the
+   * same user data.
+   *
+   * Every node makes the same inserts with the same pairs, as for any
+   * global QDP data. The node owning the shard of a key serializes the
+   * pair itself and writes it, and the other nodes skip it, so no pair
+   * goes through the primary node and no messages are sent.
+   *
+   * Lookups need the DB opened read only. The primary node then opens
+   * every shard, presenting them as one map, and broadcasts the results.
+   * An existing manifest fixes the number of shards, so readers need not
+   * set it, and a node may own several shards when a DB is opened on
+   * fewer nodes than wrote it. A single file DB is never turned into a
+   * sharded one.
+   */
+  template<typename K, typename D>
+  class ShardedStoreDB
+  {
+  public:
+    //! Single file by default
+    ShardedStoreDB() : num_shards(0), shards_set(false), max_user_info_len(0), 
+		       readonly(false), is_open(false) {}
+
+    //! Close
+    ~ShardedStoreDB() {close();}
+
+    //! Number of shards for a new DB, 0 for a single file
+    void setNumShards(int n)
+    {
+      if (n < 0 || n > Layout::numNodes())
+      {
+	QDPIO::cerr << __func__ << ": number of shards must be between 0 and the number of nodes, found "
+		    << n << endl;
+	QDP_abort(1);
+      }
+      num_shards = n;
+      shards_set = true;
+    }
+
+    //! Number of shards
+    int numShards() const {return num_shards;}
+
+    //! Does the DB, or its manifest, exist?
+    bool fileExists(const std::string& file) const
+    {
+      int ret = 0;
+      if (Layout::primaryNode())
+      {
+	std::ifstream f(file.c_str());
+	ret = f.good() ? 1 : 0;
+      }
+      QDPInternal::broadcast(ret);
+      return (ret == 1);
+    }
+
+    //! Room for the user data
+    void setMaxUserInfoLen(unsigned int len) {max_user_info_len = len;}
+
+    //! Open the DB
+    void open(const std::string& file_, int open_flags, int mode)
+    {
+      file = file_;
+      readonly = ((open_flags & O_ACCMODE) == O_RDONLY);
+      is_open = true;
+
+      // The primary node knows the user data length
+      QDPInternal::broadcast(max_user_info_len);
+
+      // An existing manifest fixes the number of shards
+      int n = no_file;
+      if (Layout::primaryNode())
+	n = readManifest();
+      QDPInternal::broadcast(n);
+
+      if (n == single_file && num_shards > 0)
+      {
+	QDPIO::cerr << "ShardedStoreDB: " << file << " is an existing single file DB; "
+		    << "it cannot be opened with num_shards = " << num_shards << endl;
+	QDP_abort(1);
+      }
+      else if (n >= 0)
+      {
+	if (shards_set && n != num_shards)
+	{
+	  QDPIO::cerr << "ShardedStoreDB: " << file << " has " << n 
+		      << " shards, but num_shards = " << num_shards << " was asked for" << endl;
+	  if (! readonly)
+	    QDP_abort(1);
+	}
+	num_shards = n;
+      }
+      else if (n == no_file && num_shards > 0 && ! readonly && Layout::primaryNode())
+	writeManifest();
+
+      if (num_shards == 0)
+      {
+	if (Layout::primaryNode())
+	  openShard(file, open_flags, mode);
+      }
+      else if (readonly)
+      {
+	// The primary node presents all the shards
+	if (Layout::primaryNode())
+	  for(int s=0; s < num_shards; ++s)
+	    openShard(shardName(s), open_flags, mode);
+      }
+      else
+      {
+	// Each shard is only touched by its own node
+	for(int s=0; s < num_shards; ++s)
+	  if (shardNode(s) == Layout::nodeNumber())
+	    openShard(shardName(s), open_flags, mode);
+      }
+    }
+
+    //! Close the DB
+    void close()
+    {
+      for(int s=0; s < dbs.size(); ++s)
+	dbs[s]->close();
+      dbs.clear();
+      is_open = false;
+    }
+
+    //! Insert user data into every shard
+    void insertUserdata(const std::string& user_data_)
+    {
+      std::string user_data(user_data_);
+      QDPInternal::broadcast_str(user_data);
+
+      for(int s=0; s < dbs.size(); ++s)
+	dbs[s]->insertUserdata(user_data);
+    }
+
+    //! Get the user data
+    void getUserdata(std::string& user_data)
+    {
+      if (Layout::primaryNode() && dbs.size() > 0)
+	dbs[0]->getUserdata(user_data);
+      QDPInternal::broadcast_str(user_data);
+    }
+
+    //! Insert a pair, on every node
+    void insert(const K& key, const D& data)
+    {
+      if (num_shards == 0)
+      {
+	std::string key_str, data_str;
+	key.writeObject(key_str);
+	data.writeObject(data_str);
+
+	if (Layout::primaryNode())
+	  localDB(0).insert(RawDBKey(key_str), RawDBData(data_str));
+	return;
+      }
+
+      // Only the owner of the shard serializes the value
+      std::string key_str = nodeBytes(key);
+      int s = shardOf(key_str);
+
+      if (shardNode(s) == Layout::nodeNumber())
+	localDB(s).insert(RawDBKey(key_str), RawDBData(nodeBytes(data)));
+    }
+
+    //! Look up a pair, collective. Returns 0 if found.
+    int get(const K& key, D& data)
+    {
+      std::string data_str;
+      int ret = lookup(key, data_str);
+
+      if (ret == 0)
+	data.readObject(data_str);
+
+      return ret;
+    }
+
+    //! Does a key exist? Collective.
+    bool exist(const K& key)
+    {
+      std::string data_str;
+      return (lookup(key, data_str) == 0);
+    }
+
+    //! All the keys, collective
+    void keys(std::vector<K>& keys_)
+    {
+      checkLookup();
+
+      std::vector<RawDBKey> raw;
+      if (Layout::primaryNode())
+	for(int s=0; s < dbs.size(); ++s)
+	{
+	  std::vector<RawDBKey> k;
+	  dbs[s]->keys(k);
+	  raw.insert(raw.end(), k.begin(), k.end());
+	}
+
+      int n = raw.size();
+      QDPInternal::broadcast(n);
+
+      keys_.resize(n);
+      for(int i=0; i < n; ++i)
+      {
+	std::string key_str;
+	if (Layout::primaryNode())
+	  key_str = raw[i].bytes();
+	keys_[i].readObject(key_str);
+      }
+    }
+
+  private:
+    typedef FILEDB::ConfDataStoreDB<RawDBKey,RawDBData>  DB_t;
+
+    //! What readManifest found besides a number of shards
+    enum {no_file = -2, single_file = -1};
+
+    //! Name of a shard
+    std::string shardName(int s) const
+    {
+      std::ostringstream os;
+      os << file << ".shard" << s;
+      return os.str();
+    }
+
+    //! Node writing a shard, spread over the machine. A node may own several.
+    int shardNode(int s) const
+    {
+      return int((long(s) * Layout::numNodes()) / num_shards);
+    }
+
+    //! Shard of a serialized key
+    int shardOf(const std::string& key_str) const
+    {
+      if (num_shards == 0)
+	return 0;
+
+      // FNV-1a
+      unsigned int h = 2166136261u;
+      for(int i=0; i < key_str.size(); ++i)
+      {
+	h ^= (unsigned char)(key_str[i]);
+	h *= 16777619u;
+      }
+      return int(h % (unsigned int)(num_shards));
+    }
+
+    //! Open one shard on this node
+    void openShard(const std::string& name, int open_flags, int mode)
+    {
+      Handle<DB_t> db(new DB_t);
+      if (max_user_info_len > 0)
+	db->setMaxUserInfoLen(max_user_info_len);
+
+      if (db->open(name, open_flags, mode) != 0)
+      {
+	std::cerr << __func__ << ": error opening DB " << name << endl;
+	QDP_abort(1);
+      }
+      dbs.push_back(db);
+    }
+
+    //! The shard s as opened on this node
+    DB_t& localDB(int s)
+    {
+      // A writer holds at most the shards of its node, in order
+      int n = 0;
+      if (! readonly && num_shards > 0)
+	for(int r=0; r < s; ++r)
+	  if (shardNode(r) == Layout::nodeNumber())
+	    ++n;
+
+      return *(dbs[readonly ? s : n]);
+    }
+
+    //! Lookups need every shard on the primary node
+    void checkLookup() const
+    {
+      if (num_shards > 0 && ! readonly)
+      {
+	QDPIO::cerr << "ShardedStoreDB: lookups in a sharded DB need it opened read only" << endl;
+	QDP_abort(1);
+      }
+    }
+
+    //! Look up the bytes of a value, collective
+    int lookup(const K& key, std::string& data_str)
+    {
+      checkLookup();
+
+      std::string key_str;
+      key.writeObject(key_str);
+
+      int ret = -1;
+      if (Layout::primaryNode())
+      {
+	RawDBData raw;
+	ret = localDB(shardOf(key_str)).get(RawDBKey(key_str), raw);
+	data_str = raw.bytes();
+      }
+      QDPInternal::broadcast(ret);
+
+      return ret;
+    }
+
+    //! Number of shards in an existing manifest, no_file, or single_file for anything else
+    int readManifest() const
+    {
+      std::ifstream f(file.c_str());
+      if (! f.good())
+	return no_file;
+
+      std::string tag;
+      if (! (f >> tag) || tag != "<ShardedDB>")
+	return single_file;
+
+      int n = -1;
+      f >> tag >> n;
+      return (tag == "<num_shards>" && n >= 0) ? n : single_file;
+    }
+
+    //! Write the manifest
+    void writeManifest() const
+    {
+      std::ofstream f(file.c_str(), std::ios::trunc);
+      f << "<ShardedDB>\n"
+	<< "  <num_shards> " << num_shards << " </num_shards>\n"
+	<< "  <shard_pattern>" << file << ".shard%d</shard_pattern>\n"
+	<< "</ShardedDB>\n";
+      if (f.fail())
+      {
+	std::cerr << "ShardedStoreDB: error writing manifest " << file << endl;
+	QDP_abort(1);
+      }
+    }
+
+    int                          num_shards;
+    bool                         shards_set;
+    unsigned int                 max_user_info_len;
+    bool                         readonly;
+    bool                         is_open;
+    std::string                  file;
+    std::vector< Handle<DB_t> >  dbs;
+  };
+
+
+  //---------------------------------------------------------------------
+  //! Merge the shards of a DB into one file
+  /*! \ingroup ferm
+   *
+   * For tools that only read a single DB. The user data is copied from
+   * the first shard.
+   */
+  template<typename K, typename D>
+  void mergeShardedDB(const std::string& sharded_file, const std::string& merged_file)
+  {
+    ShardedStoreDB<K,D> in;
+    in.open(sharded_file, O_RDONLY, 0400);
+
+    std::string user_data;
+    in.getUserdata(user_data);
+
+    std::vector<K> keys;
+    in.keys(keys);
+
+    BinaryStoreDB<K,D> out;
+    out.setMaxUserInfoLen(user_data.size());
+    out.open(merged_file, O_RDWR | O_CREAT, 0664);
+    out.insertUserdata(user_data);
+
+    for(int i=0; i < keys.size(); ++i)
+    {
+      D data;
+      in.get(keys[i], data);
+      out.insert(keys[i], data);
+    }
+  }
+
+} // namespace Chroma
+
+#endif
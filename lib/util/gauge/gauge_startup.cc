@@ -16,6 +16,7 @@
 #include "io/readmilc_d.h"
 #include "io/kyugauge_io.h"
 #include "io/readcppacs.h"
+#include "io/compact_gauge_io.h"
 
 #include "util/gauge/hotst.h"
 #include "util/gauge/weak_field.h"
@@ -66,6 +67,10 @@ namespace Chroma
       readMILC_d(gauge_xml, u, cfg.cfg_file);
       break;
 
+    case CFG_TYPE_COMPACT:
+      readCompactGauge(gauge_file_xml, gauge_xml, u, cfg.cfg_file);
+      break;
+
     case CFG_TYPE_CPPACS :
       readCPPACS(gauge_xml, u, cfg.cfg_file);
       break;
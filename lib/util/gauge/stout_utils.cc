@@ -7,6 +7,7 @@
 #include "chroma_config.h"
 #include "chromabase.h"
 #include "util/gauge/stout_utils.h"
+#include "util/thread/tuned_dispatch.h"
 
 //#if defined(BUILD_JIT_CLOVER_TERM)
 //#include "util/gauge/stout_utils_ptx.h"
@@ -896,7 +897,8 @@ namespace Chroma
 
 #if !defined(BUILD_JIT_CLOVER_TERM)
 #warning "Using QDP++ stouting"
-      dispatch_to_threads(num_sites, args, StoutUtils::getFsAndBsSiteLoop);
+      tunedDispatchToThreads((dobs) ? "stout_fs_bs" : "stout_fs",
+			     num_sites, args, StoutUtils::getFsAndBsSiteLoop);
 #else
 #if defined(QDPJIT_IS_QDPJITPTX)
       #warning "Using QDP-JIT/PTX stouting"
@@ -7,6 +7,7 @@
 #include "chromabase.h"
 #include "util/info/printgeom.h"
 #include "util/info/proginfo.h"
+#include "util/thread/numa_affinity.h"
 #include <ctime>
 
 
@@ -47,6 +48,7 @@ namespace Chroma
     write(xml,"run_date", date);
 
     printgeom(xml);
+    NumaAffinityEnv::printThreadInfo(xml);
     pop(xml);
 
     END_CODE();
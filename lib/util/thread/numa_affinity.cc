@@ -0,0 +1,353 @@
+/*! \file
+ *  \brief Thread pinning and NUMA first touch of lattice fields
+ */
+
+#include "chromabase.h"
+#include "util/thread/numa_affinity.h"
+
+#include <vector>
+#include <algorithm>
+#include <utility>
+#include <sstream>
+#include <cstdio>
+
+#if defined(QDP_USE_OMP_THREADS)
+#include <omp.h>
+#endif
+
+#if defined(__linux__)
+#include <sched.h>
+#include <unistd.h>
+#include <dirent.h>
+#include <sys/syscall.h>
+#endif
+
+namespace Chroma
+{
+
+  namespace NumaAffinityEnv
+  {
+    //! Anonymous namespace
+    namespace
+    {
+      bool enabled = false;
+      bool pinned = false;
+
+      //! Cpu of each thread, -1 if unknown
+      std::vector<int> thread_cpu;
+
+      //! NUMA node of a cpu, 0 if unknown
+      int cpuNode(int cpu)
+      {
+#if defined(__linux__)
+	std::ostringstream dir;
+	dir << "/sys/devices/system/cpu/cpu" << cpu;
+
+	DIR* d = opendir(dir.str().c_str());
+	if (d == 0)
+	  return 0;
+
+	int node = 0;
+	struct dirent* e;
+	while ((e = readdir(d)) != 0)
+	{
+	  int n;
+	  if (std::sscanf(e->d_name, "node%d", &n) == 1)
+	  {
+	    node = n;
+	    break;
+	  }
+	}
+	closedir(d);
+	return node;
+#else
+	return 0;
+#endif
+      }
+
+      //! Number of NUMA nodes of the machine, 1 if unknown
+      int numNodes()
+      {
+#if defined(__linux__)
+	DIR* d = opendir("/sys/devices/system/node");
+	if (d == 0)
+	  return 1;
+
+	int num = 0;
+	struct dirent* e;
+	while ((e = readdir(d)) != 0)
+	{
+	  int n;
+	  if (std::sscanf(e->d_name, "node%d", &n) == 1)
+	    ++num;
+	}
+	closedir(d);
+	return (num > 0) ? num : 1;
+#else
+	return 1;
+#endif
+      }
+
+      //! Number of ranks on the host of this rank
+      /*! Collective. Hosts are told apart by a hash of their names. */
+      int localRanks()
+      {
+	double h = 0;
+#if defined(__linux__)
+	char name[256];
+	if (gethostname(name, sizeof(name)) == 0)
+	{
+	  name[sizeof(name)-1] = '\0';
+	  unsigned long hash = 5381;
+	  for(const char* c = name; *c != '\0'; ++c)
+	    hash = 33*hash + (unsigned char)(*c);
+	  h = double(hash % 2147483647UL) + 1;
+	}
+#endif
+
+	multi1d<double> hosts(Layout::numNodes());
+	for(int i=0; i < hosts.size(); ++i)
+	  hosts[i] = 0;
+	hosts[Layout::nodeNumber()] = h;
+	QDPInternal::globalSumArray(hosts.slice(), hosts.size());
+
+	int n = 0;
+	for(int i=0; i < hosts.size(); ++i)
+	  if (hosts[i] == h)
+	    ++n;
+	return n;
+      }
+
+      //! Note where each thread runs
+      void findThreadCpus()
+      {
+#if defined(QDP_USE_OMP_THREADS) && defined(__linux__)
+	thread_cpu.assign(qdpNumThreads(), -1);
+#pragma omp parallel
+	{
+	  thread_cpu[omp_get_thread_num()] = sched_getcpu();
+	}
+#else
+	thread_cpu.assign(1, -1);
+#endif
+      }
+
+      //! Count the pages of a field that sit on the node of their thread
+      /*!
+       * The thread blocks are those of dispatch_to_threads on each
+       * checkerboard. Returns false if the pages cannot be queried.
+       */
+      template<typename S>
+      bool countLocalPages(const S* base, double& local, double& total)
+      {
+	local = 0;
+	total = 0;
+
+#if defined(__linux__) && defined(SYS_move_pages)
+	const long page = sysconf(_SC_PAGESIZE);
+	const int nthreads = thread_cpu.size();
+
+	for(int cb=0; cb < rb.numSubsets(); ++cb)
+	{
+	  const multi1d<int>& tab = rb[cb].siteTable();
+	  const int n = rb[cb].numSiteTable();
+
+	  for(int t=0; t < nthreads; ++t)
+	  {
+	    if (thread_cpu[t] < 0)
+	      return false;
+
+	    const int node = cpuNode(thread_cpu[t]);
+	    const int lo = n*t/nthreads;
+	    const int hi = n*(t+1)/nthreads;
+
+	    // Pages of this block, once each
+	    std::vector<void*> pages;
+	    for(int j=lo; j < hi; ++j)
+	    {
+	      unsigned long p = (unsigned long)(base + tab[j]) & ~(unsigned long)(page-1);
+	      if (pages.empty() || pages.back() != (void*)p)
+		pages.push_back((void*)p);
+	    }
+	    if (pages.empty())
+	      continue;
+
+	    // With no target nodes move_pages only reports where the pages are
+	    std::vector<int> status(pages.size());
+	    if (syscall(SYS_move_pages, 0, pages.size(), &pages[0], (void*)0, &status[0], 0) != 0)
+	      return false;
+
+	    for(int i=0; i < status.size(); ++i)
+	    {
+	      if (status[i] < 0)
+		continue;
+	      total += 1;
+	      if (status[i] == node)
+		local += 1;
+	    }
+	  }
+	}
+
+	return true;
+#else
+	return false;
+#endif
+      }
+    }
+
+
+    // Pin the threads and first touch fields from now on
+    void enable()
+    {
+      enabled = true;
+      pinThreads();
+    }
+
+
+    // Is the NUMA mode on?
+    bool isEnabled()
+    {
+      return enabled;
+    }
+
+
+    // Pin each thread to one cpu of the process, in thread order
+    void pinThreads()
+    {
+#if defined(QDP_USE_OMP_THREADS) && defined(__linux__)
+      const int local_ranks = localRanks();
+
+      cpu_set_t allowed;
+      CPU_ZERO(&allowed);
+      bool known = (sched_getaffinity(0, sizeof(allowed), &allowed) == 0);
+
+      std::vector<int> cpus;
+      for(int c=0; c < CPU_SETSIZE && known; ++c)
+	if (CPU_ISSET(c, &allowed))
+	  cpus.push_back(c);
+
+      // Ranks on one host whose cpus add up to more than the host has
+      // share cpus, and would pin their threads onto the same cores.
+      // All the ranks must agree, so this comes before any return.
+      const long host_cpus = sysconf(_SC_NPROCESSORS_ONLN);
+      int shared = (local_ranks > 1 && host_cpus > 0 && 
+		    long(local_ranks * cpus.size()) > host_cpus) ? 1 : 0;
+      QDPInternal::globalSum(shared);
+
+      if (! known)
+      {
+	QDPIO::cerr << "NumaAffinityEnv: cannot get the cpus of the process - threads not pinned" << endl;
+	return;
+      }
+
+      if (cpus.empty())
+	return;
+
+      if (shared > 0)
+      {
+	QDPIO::cerr << "NumaAffinityEnv: " << local_ranks << " ranks on a host of " << host_cpus
+		    << " cpus may each use " << cpus.size() << " of them - threads not pinned."
+		    << " Bind the ranks to disjoint cpus with the MPI launcher." << endl;
+	return;
+      }
+
+      // Cpus of a socket may be numbered apart, e.g. interleaved with
+      // those of the other sockets, so order them by NUMA node first
+      std::vector< std::pair<int,int> > by_node;
+      for(int i=0; i < cpus.size(); ++i)
+	by_node.push_back(std::make_pair(cpuNode(cpus[i]), cpus[i]));
+      std::sort(by_node.begin(), by_node.end());
+      for(int i=0; i < cpus.size(); ++i)
+	cpus[i] = by_node[i].second;
+
+      if (cpus.size() < qdpNumThreads())
+	QDPIO::cout << "NumaAffinityEnv: " << qdpNumThreads() << " threads on "
+		    << cpus.size() << " cpus - some threads share a cpu" << endl;
+
+      int failed = 0;
+
+      // Consecutive threads on cpus of the same NUMA node, so each thread
+      // block of a site loop stays on one socket
+#pragma omp parallel reduction(+:failed)
+      {
+	cpu_set_t mine;
+	CPU_ZERO(&mine);
+	CPU_SET(cpus[omp_get_thread_num() % cpus.size()], &mine);
+	if (sched_setaffinity(0, sizeof(mine), &mine) != 0)
+	  failed = 1;
+      }
+
+      if (failed)
+	QDPIO::cerr << "NumaAffinityEnv: could not pin " << failed << " threads" << endl;
+      else
+	pinned = true;
+#endif
+    }
+
+
+    // Write the threads, their cpus and the locality of a probe field
+    void printThreadInfo(XMLWriter& xml)
+    {
+      START_CODE();
+
+      findThreadCpus();
+
+      const int nodes = numNodes();
+
+      // A probe, placed the way the fields of this run are placed
+      LatticeColorMatrix probe;
+      if (isEnabled())
+	firstTouch(probe);
+      probe = zero;
+
+      double counts[2];
+      bool known = countLocalPages(&(probe.elem(0)), counts[0], counts[1]);
+
+      // All the ranks must join the sum
+      int all_known = (known) ? 1 : 0;
+      QDPInternal::globalSum(all_known);
+      if (all_known == Layout::numNodes())
+	QDPInternal::globalSumArray(counts, 2);
+      else
+	known = false;
+
+      multi1d<int> cpu(thread_cpu.size());
+      multi1d<int> node(thread_cpu.size());
+      for(int t=0; t < cpu.size(); ++t)
+      {
+	cpu[t] = thread_cpu[t];
+	node[t] = (thread_cpu[t] < 0) ? -1 : cpuNode(thread_cpu[t]);
+      }
+
+      push(xml, "ThreadInfo");
+      write(xml, "num_threads", cpu.size());
+      write(xml, "numa_mode", isEnabled());
+      write(xml, "pinned", pinned);
+      write(xml, "placed_fields", std::string((isEnabled()) ? "gauge clover" : ""));
+      write(xml, "numa_nodes", nodes);
+      write(xml, "thread_cpu", cpu);
+      write(xml, "thread_node", node);
+      if (known && counts[1] > 0)
+	write(xml, "local_page_fraction", counts[0] / counts[1]);
+      pop(xml);
+
+      QDPIO::cout << "Threads: " << cpu.size()
+		  << "  NUMA nodes: " << nodes
+		  << "  NUMA mode: " << ((isEnabled()) ? "on" : "off")
+		  << "  pinned: " << ((pinned) ? "yes" : "no") << endl;
+
+      if (isEnabled())
+	QDPIO::cout << "NUMA placement: gauge field and clover term only; other fields, "
+		    << "e.g. those of the solvers, go where they are first written" << endl;
+
+      if (known && counts[1] > 0)
+	QDPIO::cout << "Memory locality: " << 100.0 * counts[0] / counts[1]
+		    << "% of field pages on the NUMA node of their thread" << endl;
+      else
+	QDPIO::cout << "Memory locality: unknown" << endl;
+
+      END_CODE();
+    }
+  }
+
+}  // end namespace Chroma
@@ -0,0 +1,120 @@
+// -*- C++ -*-
+/*! \file
+ *  \brief Thread pinning and NUMA first touch of lattice fields
+ *
+ *  With one rank per multi-socket node, the pages of a field should live
+ *  on the socket of the threads that work on them. Linux places a page
+ *  where it is first written, so a field is first touched in the same
+ *  thread blocks as dispatch_to_threads uses for its checkerboards, with
+ *  the threads pinned so the blocks do not move between sockets.
+ *
+ *  Only the gauge field and the clover term are placed this way. The
+ *  fields of the solvers and of the measurements are allocated and first
+ *  written by QDP, whose site loops on the whole lattice split the sites
+ *  over the threads differently than on each checkerboard, so their pages
+ *  land wherever they happen to be first written.
+ */
+
+#ifndef __numa_affinity_h__
+#define __numa_affinity_h__
+
+#include "chromabase.h"
+
+#include <cstring>
+
+namespace Chroma
+{
+
+  //! NUMA placement of lattice fields
+  /*! \ingroup util */
+  namespace NumaAffinityEnv
+  {
+    //! Pin the threads and first touch fields from now on
+    void enable();
+
+    //! Is the NUMA mode on?
+    bool isEnabled();
+
+    //! Pin each thread to one cpu of the process, in thread order
+    /*!
+     * The cpus are taken by NUMA node, then by number. Does nothing
+     * without OpenMP threads or off Linux. Collective. With several ranks
+     * on a host each must be bound to its own cpus by the launcher,
+     * otherwise the threads are not pinned and a warning is printed.
+     */
+    void pinThreads();
+
+    //! Write the threads, their cpus and the locality of a probe field
+    /*! Also printed to QDPIO::cout. Needs the layout. */
+    void printThreadInfo(XMLWriter& xml);
+
+    template<typename S>
+    struct TouchArgs
+    {
+      S*                   base;
+      const multi1d<int>&  tab;
+    };
+
+    //! Zero the sites of one thread block, placing their pages
+    template<typename S>
+    void touchSiteLoop(int lo, int hi, int myId, TouchArgs<S>* a)
+    {
+      for(int j=lo; j < hi; ++j)
+	std::memset((void*)(a->base + a->tab[j]), 0, sizeof(S));
+    }
+
+    //! First touch an array of site objects, indexed by site
+    /*!
+     * The checkerboards are touched one after the other, since the
+     * solvers run over one checkerboard at a time. Only the first write
+     * to a page places it, so call this before anything else writes.
+     * Does nothing when the NUMA mode is off.
+     *
+     * \param base    first site ( Modify )
+     */
+    template<typename S>
+    void firstTouchSites(S* base)
+    {
+      if (! isEnabled())
+	return;
+
+      for(int cb=0; cb < rb.numSubsets(); ++cb)
+      {
+	TouchArgs<S> a = {base, rb[cb].siteTable()};
+	dispatch_to_threads(rb[cb].numSiteTable(), a, touchSiteLoop<S>);
+      }
+    }
+
+    //! First touch a lattice field
+    template<typename T>
+    void firstTouch(OLattice<T>& f)
+    {
+      firstTouchSites(&(f.elem(0)));
+    }
+
+    //! First touch an array of lattice fields
+    template<typename T>
+    void firstTouch(multi1d< OLattice<T> >& f)
+    {
+      for(int i=0; i < f.size(); ++i)
+	firstTouch(f[i]);
+    }
+
+    //! First touch a per site array
+    template<typename S>
+    void firstTouch(multi1d<S>& f)
+    {
+      if (f.size() != Layout::sitesOnNode())
+      {
+	QDPIO::cerr << "NumaAffinityEnv::firstTouch: array has " << f.size()
+		    << " elements, not one per site" << endl;
+	QDP_abort(1);
+      }
+
+      firstTouchSites(f.slice());
+    }
+  }
+
+}  // end namespace Chroma
+
+#endif
@@ -0,0 +1,333 @@
+/*! \file
+ *  \brief Site loops threaded with an autotuned schedule
+ */
+
+#include "chromabase.h"
+#include "util/thread/tuned_dispatch.h"
+#include "util/thread/numa_affinity.h"
+
+#include <map>
+#include <sstream>
+#include <fstream>
+#include <cstdio>
+#include <unistd.h>
+
+namespace Chroma
+{
+
+  namespace TunedDispatchEnv
+  {
+    //! Anonymous namespace for the tuning table
+    namespace
+    {
+      //! Version of the cache file layout. Bump if the contents change.
+      const int cache_version = 1;
+
+      //! Schedule names in the cache file
+      const char* schedule_names[] = {"STATIC_BLOCK", "STATIC_CHUNK", "DYNAMIC", "GUIDED"};
+      const int num_schedules = 4;
+
+      //! Smallest chunk worth trying
+      const int min_chunk = 8;
+
+      bool enabled = false;
+      std::string cache_file;
+
+      typedef std::map<std::string, TuneRecord*> Table_t;
+
+      //! The tuning state of everything seen so far
+      Table_t& table()
+      {
+	static Table_t* t = new Table_t;
+	return *t;
+      }
+
+      int numThreads()
+      {
+#if defined(QDP_USE_OMP_THREADS)
+	return qdpNumThreads();
+#else
+	return 1;
+#endif
+      }
+
+      //! Unique key of a kernel on n sites with the present threads
+      std::string tuneKey(const std::string& kernel, int n, int nthreads)
+      {
+	std::ostringstream os;
+	os << kernel << "_v" << n << "_t" << nthreads;
+	return os.str();
+      }
+
+      //! Check on the primary node whether a file exists and tell everybody
+      bool cacheFileExists(const std::string& file)
+      {
+	int exists = 0;
+	if (Layout::primaryNode())
+	{
+	  std::ifstream f(file.c_str());
+	  exists = (f.good()) ? 1 : 0;
+	}
+	QDPInternal::broadcast(exists);
+	return (exists != 0);
+      }
+
+      //! Cached entry as it stands in the file
+      struct CacheEntry_t
+      {
+	std::string kernel;
+	int sites;
+	int threads;
+	TunedDispatchConfig_t config;
+      };
+
+      //! Entries read from the cache file, kept so other runs' entries are written back
+      std::map<std::string, CacheEntry_t>& cacheEntries()
+      {
+	static std::map<std::string, CacheEntry_t>* c = new std::map<std::string, CacheEntry_t>;
+	return *c;
+      }
+
+      //! Read the cache file. A mismatched or unreadable file is ignored.
+      void readCache()
+      {
+	if (! cacheFileExists(cache_file))
+	  return;
+
+	try
+	{
+	  XMLReader xml_in(cache_file);
+	  XMLReader paramtop(xml_in, "/TunedDispatch");
+
+	  int version;
+	  read(paramtop, "version", version);
+	  if (version != cache_version)
+	  {
+	    QDPIO::cout << "TunedDispatch: cache file " << cache_file
+			<< " has version " << version << " - ignoring it" << endl;
+	    return;
+	  }
+
+	  XMLReader entries(paramtop, "Entries");
+	  int n = entries.count("elem");
+	  for(int i=0; i < n; ++i)
+	  {
+	    std::ostringstream path;
+	    path << "elem[" << i+1 << "]";
+	    XMLReader e(entries, path.str());
+
+	    CacheEntry_t c;
+	    std::string sched;
+	    read(e, "kernel", c.kernel);
+	    read(e, "sites", c.sites);
+	    read(e, "threads", c.threads);
+	    read(e, "schedule", sched);
+	    read(e, "chunk", c.config.chunk);
+
+	    c.config.schedule = -1;
+	    for(int s=0; s < num_schedules; ++s)
+	      if (sched == schedule_names[s])
+		c.config.schedule = s;
+
+	    if (c.config.schedule < 0 ||
+		(c.config.schedule != TUNED_STATIC_BLOCK && c.config.chunk < 1))
+	    {
+	      QDPIO::cout << "TunedDispatch: bad schedule " << sched << " chunk " << c.config.chunk
+			  << " for " << c.kernel << " - ignoring it" << endl;
+	      continue;
+	    }
+
+	    cacheEntries()[tuneKey(c.kernel, c.sites, c.threads)] = c;
+	  }
+	}
+	catch(const std::string& e)
+	{
+	  QDPIO::cout << "TunedDispatch: error reading cache file " << cache_file << ": " << e << endl;
+	  cacheEntries().clear();
+	  return;
+	}
+
+	QDPIO::cout << "TunedDispatch: read " << cacheEntries().size()
+		    << " schedules from " << cache_file << endl;
+      }
+    }
+
+
+    // Candidates of a loop over n sites
+    TuneRecord::TuneRecord(int n) : trial(0)
+    {
+      const int nthreads = numThreads();
+
+      TunedDispatchConfig_t c;
+      c.schedule = TUNED_STATIC_BLOCK;
+      c.chunk = 0;
+      cands.push_back(c);
+      best = c;
+
+      // Chunks of 1/2 down to 1/16 of a thread's block. Chunks move sites
+      // off the thread that first touched them, so not in NUMA mode.
+      int last = 0;
+      for(int div=2; div <= 16 && ! NumaAffinityEnv::isEnabled(); div *= 2)
+      {
+	int chunk = n / (nthreads*div);
+	if (chunk < min_chunk || chunk == last)
+	  break;
+	last = chunk;
+
+	c.chunk = chunk;
+	c.schedule = TUNED_STATIC_CHUNK;
+	cands.push_back(c);
+	c.schedule = TUNED_DYNAMIC;
+	cands.push_back(c);
+	c.schedule = TUNED_GUIDED;
+	cands.push_back(c);
+      }
+
+      times.resize(cands.size());
+      for(int i=0; i < times.size(); ++i)
+	times[i] = -1;
+
+      // Nothing to choose between
+      if (cands.size() == 1)
+	trial = num_trials;
+    }
+
+
+    // Set from the cache
+    TuneRecord::TuneRecord(const TunedDispatchConfig_t& c) : trial(0), best(c) {}
+
+
+    // Time of the last trial. The best of num_trials calls is kept.
+    void TuneRecord::report(double secs)
+    {
+      int i = trial % cands.size();
+      if (times[i] < 0 || secs < times[i])
+	times[i] = secs;
+
+      if (++trial < int(cands.size())*num_trials)
+	return;
+
+      int ibest = 0;
+      for(int j=1; j < times.size(); ++j)
+	if (times[j] < times[ibest])
+	  ibest = j;
+
+      best = cands[ibest];
+    }
+
+
+    // Tuning state of a kernel over n sites, made at first use
+    TuneRecord& record(const std::string& kernel, int n)
+    {
+      const int nthreads = numThreads();
+      const std::string key = tuneKey(kernel, n, nthreads);
+
+      Table_t::iterator it = table().find(key);
+      if (it != table().end())
+	return *(it->second);
+
+      TuneRecord* rec;
+      std::map<std::string, CacheEntry_t>::const_iterator c = cacheEntries().find(key);
+
+      // NUMA mode keeps the threads on their own blocks
+      if (c != cacheEntries().end() &&
+	  ! (NumaAffinityEnv::isEnabled() && c->second.config.schedule != TUNED_STATIC_BLOCK))
+	rec = new TuneRecord(c->second.config);
+      else
+	rec = new TuneRecord(n);
+
+      table()[key] = rec;
+
+      CacheEntry_t& e = cacheEntries()[key];
+      e.kernel = kernel;
+      e.sites = n;
+      e.threads = nthreads;
+
+      return *rec;
+    }
+
+
+    // Turn tuning on
+    void enable()
+    {
+      enabled = true;
+    }
+
+
+    // Is tuning on?
+    bool isEnabled()
+    {
+      return enabled;
+    }
+
+
+    // Turn tuning on and keep the tuned schedules in a file
+    void setCacheFile(const std::string& file)
+    {
+      enabled = true;
+      cache_file = file;
+      readCache();
+    }
+
+
+    // Write the tuned schedules to the cache file
+    /*! The file is written under a temporary name and then renamed, so
+     *  concurrent jobs never see a partially written cache file. */
+    void writeCache()
+    {
+      if (! enabled || cache_file == "")
+	return;
+
+      // Fold in what was tuned in this run
+      for(Table_t::const_iterator it = table().begin(); it != table().end(); ++it)
+      {
+	if (! it->second->tuned())
+	  continue;
+	cacheEntries()[it->first].config = it->second->config();
+      }
+
+      std::ostringstream tmp_file;
+      tmp_file << cache_file << ".tmp" << getpid();
+
+      {
+	XMLFileWriter xml_out(tmp_file.str());
+	push(xml_out, "TunedDispatch");
+	write(xml_out, "version", cache_version);
+	push(xml_out, "Entries");
+
+	for(std::map<std::string, CacheEntry_t>::const_iterator it = cacheEntries().begin();
+	    it != cacheEntries().end(); ++it)
+	{
+	  // Seen but never finished tuning
+	  Table_t::const_iterator t = table().find(it->first);
+	  if (t != table().end() && ! t->second->tuned())
+	    continue;
+
+	  const CacheEntry_t& c = it->second;
+	  push(xml_out, "elem");
+	  write(xml_out, "kernel", c.kernel);
+	  write(xml_out, "sites", c.sites);
+	  write(xml_out, "threads", c.threads);
+	  write(xml_out, "schedule", std::string(schedule_names[c.config.schedule]));
+	  write(xml_out, "chunk", c.config.chunk);
+	  pop(xml_out);
+	}
+
+	pop(xml_out);
+	pop(xml_out);
+	xml_out.close();
+      }
+
+      if (Layout::primaryNode())
+      {
+	if (std::rename(tmp_file.str().c_str(), cache_file.c_str()) != 0)
+	{
+	  std::cerr << "TunedDispatch: could not rename " << tmp_file.str()
+		    << " to " << cache_file << " - not cached" << endl;
+	  std::remove(tmp_file.str().c_str());
+	}
+      }
+    }
+  }
+
+}  // end namespace Chroma
@@ -0,0 +1,198 @@
+// -*- C++ -*-
+/*! \file
+ *  \brief Site loops threaded with an autotuned schedule
+ *
+ *  A drop in for dispatch_to_threads. The schedule of each kernel and
+ *  site count is tuned on its first calls and may be kept in a cache file
+ *  for later runs.
+ *
+ *  Each node tunes on its own, so the nodes may settle on different
+ *  schedules. Only kernels whose result does not depend on the order of
+ *  the sites may be tuned: loops that leave per thread partial sums stay
+ *  on dispatch_to_threads, whose blocks add up the same way every call.
+ */
+
+#ifndef __tuned_dispatch_h__
+#define __tuned_dispatch_h__
+
+#include "chromabase.h"
+
+#include <string>
+#include <vector>
+
+#if defined(QDP_USE_OMP_THREADS)
+#include <omp.h>
+#endif
+
+namespace Chroma
+{
+
+  //! Schedules of a tuned site loop
+  /*! \ingroup util */
+  enum TunedSchedule
+  {
+    TUNED_STATIC_BLOCK = 0,   /*!< one contiguous block per thread, as dispatch_to_threads */
+    TUNED_STATIC_CHUNK,       /*!< chunks dealt round robin */
+    TUNED_DYNAMIC,            /*!< chunks taken first come first served */
+    TUNED_GUIDED              /*!< shrinking chunks taken first come first served */
+  };
+
+  //! Schedule of a site loop
+  /*! \ingroup util */
+  struct TunedDispatchConfig_t
+  {
+    int schedule;             /*!< a TunedSchedule */
+    int chunk;                /*!< sites per chunk, unused for TUNED_STATIC_BLOCK */
+  };
+
+
+  //! Tuning of the threaded site loops
+  /*! \ingroup util */
+  namespace TunedDispatchEnv
+  {
+    //! Turn tuning on. Without it the loops use dispatch_to_threads
+    void enable();
+
+    //! Is tuning on?
+    bool isEnabled();
+
+    //! Turn tuning on and keep the tuned schedules in a file
+    /*! Schedules already in the file are used without retuning */
+    void setCacheFile(const std::string& file);
+
+    //! Write the tuned schedules to the cache file, if there is one
+    void writeCache();
+
+    //! Tuning state of one kernel at one site count
+    class TuneRecord
+    {
+    public:
+      //! Candidates of a loop over n sites
+      TuneRecord(int n);
+
+      //! Set from the cache
+      TuneRecord(const TunedDispatchConfig_t& c);
+
+      //! Has a schedule been chosen?
+      bool tuned() const {return trial >= int(cands.size())*num_trials;}
+
+      //! The chosen schedule
+      const TunedDispatchConfig_t& config() const {return best;}
+
+      //! Schedule of the next trial
+      const TunedDispatchConfig_t& next() const {return cands[trial % cands.size()];}
+
+      //! Time of the last trial
+      void report(double secs);
+
+    private:
+      static const int num_trials = 2;
+
+      std::vector<TunedDispatchConfig_t> cands;
+      std::vector<double> times;
+      int trial;
+      TunedDispatchConfig_t best;
+    };
+
+    //! Tuning state of a kernel over n sites, made at first use
+    TuneRecord& record(const std::string& kernel, int n);
+
+    //! One chunk of a loop
+    template<class Arg>
+    inline void runChunk(int k, int chunk, int n, int myId, Arg& a,
+			 void (*func)(int,int,int,Arg*))
+    {
+      int lo = k*chunk;
+      int hi = (lo + chunk < n) ? lo + chunk : n;
+
+      func(lo, hi, myId, &a);
+    }
+
+    //! Run a loop with a given schedule
+    template<class Arg>
+    void runSchedule(const TunedDispatchConfig_t& c, int n, Arg& a,
+		     void (*func)(int,int,int,Arg*))
+    {
+#if defined(QDP_USE_OMP_THREADS)
+      if (c.schedule == TUNED_STATIC_BLOCK || n == 0)
+      {
+	dispatch_to_threads(n, a, func);
+	return;
+      }
+
+      const int chunk = c.chunk;
+      const int nchunk = (n + chunk - 1) / chunk;
+
+#pragma omp parallel default(shared)
+      {
+	const int myId = omp_get_thread_num();
+
+	switch (c.schedule)
+	{
+	case TUNED_STATIC_CHUNK:
+#pragma omp for schedule(static,1)
+	  for(int k=0; k < nchunk; ++k)
+	    runChunk(k, chunk, n, myId, a, func);
+	  break;
+
+	case TUNED_DYNAMIC:
+#pragma omp for schedule(dynamic,1)
+	  for(int k=0; k < nchunk; ++k)
+	    runChunk(k, chunk, n, myId, a, func);
+	  break;
+
+	case TUNED_GUIDED:
+#pragma omp for schedule(guided,1)
+	  for(int k=0; k < nchunk; ++k)
+	    runChunk(k, chunk, n, myId, a, func);
+	  break;
+	}
+      }
+#else
+      dispatch_to_threads(n, a, func);
+#endif
+    }
+  }
+
+
+  //! Threaded site loop with a tuned schedule
+  /*! \ingroup util
+   *
+   * Same contract as dispatch_to_threads: func(lo, hi, myId, &a) must
+   * handle any range of sites, and must not leave partial sums per
+   * thread. The trials during tuning are real calls, so kernels that
+   * update in place are safe to tune.
+   *
+   * \param kernel  name of the kernel, with its precision ( Read )
+   * \param n       number of sites ( Read )
+   * \param a       kernel arguments ( Read )
+   * \param func    site loop ( Read )
+   */
+  template<class Arg>
+  void tunedDispatchToThreads(const std::string& kernel, int n, Arg a,
+			      void (*func)(int,int,int,Arg*))
+  {
+    if (! TunedDispatchEnv::isEnabled())
+    {
+      dispatch_to_threads(n, a, func);
+      return;
+    }
+
+    TunedDispatchEnv::TuneRecord& rec = TunedDispatchEnv::record(kernel, n);
+    if (rec.tuned())
+    {
+      TunedDispatchEnv::runSchedule(rec.config(), n, a, func);
+      return;
+    }
+
+    StopWatch swatch;
+    swatch.reset();
+    swatch.start();
+    TunedDispatchEnv::runSchedule(rec.next(), n, a, func);
+    swatch.stop();
+    rec.report(swatch.getTimeInSeconds());
+  }
+
+}  // end namespace Chroma
+
+#endif
@@ -4,6 +4,10 @@
  */
 
 #include "chroma.h"
+#include "util/thread/numa_affinity.h"
+
+#include <fcntl.h>
+#include <unistd.h>
 
 using namespace Chroma;
 extern "C" { 
@@ -21,9 +25,10 @@ struct Params_t
 
 struct Inline_input_t
 {
-  Params_t        param;
-  GroupXML_t      cfg;
-  QDP::Seed       rng_seed;
+  Params_t             param;
+  multi1d<GroupXML_t>  cfgs;       // one Cfg, or each of a CfgList
+  bool                 stream;     // was a CfgList given?
+  QDP::Seed            rng_seed;
 };
 
 
@@ -47,7 +52,16 @@ void read(XMLReader& xml, const std::string& path, Inline_input_t& p)
     XMLReader paramtop(xml, path);
       
     read(paramtop, "Param", p.param);
-    p.cfg = readXMLGroup(paramtop, "Cfg", "cfg_type");
+
+    // Either one config, or a list measured in turn by the same process
+    p.stream = (paramtop.count("CfgList") > 0);
+    if (p.stream)
+      p.cfgs = readXMLArrayGroup(paramtop, "CfgList", "cfg_type");
+    else
+    {
+      p.cfgs.resize(1);
+      p.cfgs[0] = readXMLGroup(paramtop, "Cfg", "cfg_type");
+    }
 
     if (paramtop.count("RNG") > 0)
       read(paramtop, "RNG", p.rng_seed);
@@ -63,96 +77,197 @@ void read(XMLReader& xml, const std::string& path, Inline_input_t& p)
 
  
 
-bool linkageHack(void)
+//! Ask for a config file to be read ahead while other work goes on
+/*!
+ * The kernel reads the file into the page cache in the background on the
+ * primary node, which does the reading for the serial formats. The
+ * decoding stays on the main thread since QDP is not thread safe.
+ */
+void prefetchConfig(const GroupXML_t& cfg)
 {
-  bool foo = true;
+  std::string cfg_file;
+  try
+  {
+    std::istringstream  xml_c(cfg.xml);
+    XMLReader  cfgtop(xml_c);
+    XMLReader  paramtop(cfgtop, cfg.path);
 
-  // Inline Measurements
-  foo &= InlineAggregateEnv::registerAll();
-  foo &= GaugeInitEnv::registerAll();
+    if (paramtop.count("cfg_file") == 0)
+      return;
 
-  return foo;
+    read(paramtop, "cfg_file", cfg_file);
+  }
+  catch(const std::string& e) 
+  {
+    return;
+  }
+
+  if (! Layout::primaryNode())
+    return;
+
+  int fd = open(cfg_file.c_str(), O_RDONLY);
+  if (fd < 0)
+    return;
+
+#if defined(POSIX_FADV_WILLNEED)
+  posix_fadvise(fd, 0, 0, POSIX_FADV_WILLNEED);
+#endif
+  close(fd);
+
+  QDPIO::cout << "CHROMA: prefetching " << cfg_file << endl;
 }
 
-//! Main program to run all measurement codes
-/*! \defgroup chromamain Main program to run all measurement codes.
- *  \ingroup main
- *
- * Main program to run all measurement codes.
- */
 
-int main(int argc, char *argv[]) 
+//! Token in the measurements replaced by the position of the config in a CfgList
+const std::string cfg_token = "%cfg%";
+
+
+//! Replace every cfg_token in the measurement xml by the config number
+std::string substituteCfg(const std::string& xml, int cfg_num)
 {
-  // Chroma Init stuff
-  Chroma::initialize(&argc, &argv);
-  
-  START_CODE();
+  std::ostringstream num;
+  num << cfg_num;
 
-  QDPIO::cout << "Linkage = " << linkageHack() << endl;
+  std::string out(xml);
+  for(size_t pos = out.find(cfg_token); pos != std::string::npos; 
+      pos = out.find(cfg_token, pos + num.str().size()))
+    out.replace(pos, cfg_token.size(), num.str());
 
-  StopWatch snoop;
-  snoop.reset();
-  snoop.start();
+  return out;
+}
 
-  XMLReader xml_in;
 
-  // Input parameter structure
-  Inline_input_t  input;
-  try
+//! Build the measurements
+void readMeasurements(const std::string& xml, 
+		      multi1d < Handle< AbsInlineMeasurement > >& the_measurements)
+{
+  try 
   {
-    xml_in.open(Chroma::getXMLInputFileName());
-    read(xml_in, "/chroma", input);
+    std::istringstream Measurements_is(xml);
+    XMLReader MeasXML(Measurements_is);
+    read(MeasXML, "/InlineMeasurements", the_measurements);
+
+    QDPIO::cout << "There are " << the_measurements.size() << " measurements " << endl;
   }
   catch(const std::string& e) 
   {
-    QDPIO::cerr << "CHROMA: Caught Exception reading XML: " << e << endl;
+    QDPIO::cerr << "CHROMA: Caught Exception reading measurements: " << e << endl;
     QDP_abort(1);
   }
-  catch(std::exception& e) 
+}
+
+
+//! Which measurements mention cfg_token, and so change with the config
+multi1d<bool> perCfgMeasurements(const std::string& xml)
+{
+  std::istringstream Measurements_is(xml);
+  XMLReader MeasXML(Measurements_is);
+
+  multi1d<bool> per_cfg(MeasXML.count("/InlineMeasurements/elem"));
+  for(int m=0; m < per_cfg.size(); ++m)
   {
-    QDPIO::cerr << "CHROMA: Caught standard library exception: " << e.what() << endl;
-    QDP_abort(1);
+    std::ostringstream path;
+    path << "/InlineMeasurements/elem[" << m+1 << "]";
+    XMLReader meas(MeasXML, path.str());
+
+    std::ostringstream os;
+    meas.print(os);
+    per_cfg[m] = (os.str().find(cfg_token) != std::string::npos);
   }
-  catch(...)
+
+  return per_cfg;
+}
+
+
+//! Rebuild the measurements that change with the config
+/*! The others are kept, with whatever state they carry. */
+void rebuildPerCfgMeasurements(const std::string& xml, const multi1d<bool>& per_cfg,
+			       multi1d < Handle< AbsInlineMeasurement > >& the_measurements)
+{
+  try 
   {
-    QDPIO::cerr << "CHROMA: caught generic exception reading XML" << endl;
+    std::istringstream Measurements_is(xml);
+    XMLReader MeasXML(Measurements_is);
+
+    for(int m=0; m < per_cfg.size(); ++m)
+    {
+      if (! per_cfg[m])
+	continue;
+
+      std::ostringstream path;
+      path << "/InlineMeasurements/elem[" << m+1 << "]";
+      read(MeasXML, path.str(), the_measurements[m]);
+    }
+  }
+  catch(const std::string& e) 
+  {
+    QDPIO::cerr << "CHROMA: Caught Exception reading measurements: " << e << endl;
     QDP_abort(1);
   }
+}
 
-  XMLFileWriter& xml_out = Chroma::getXMLOutputInstance();
-  push(xml_out, "chroma");
 
-  // Write out the input
-  write(xml_out, "Input", xml_in);
+//! With several configs, warn about measurements naming files that do not depend on the config
+/*!
+ * The measurements run once per config, so a fixed output file name
+ * would be overwritten for every config. Input files, such as a common
+ * eigenvector file, may well be fixed, and they cannot be told apart
+ * from the output files here, so this only warns. A file is any element
+ * whose name contains "file".
+ */
+void checkPerCfgFiles(const std::string& xml, const multi1d<bool>& per_cfg)
+{
+  std::istringstream Measurements_is(xml);
+  XMLReader MeasXML(Measurements_is);
 
-  Layout::setLattSize(input.param.nrow);
-  Layout::create();
+  int fixed = 0;
+  for(int m=0; m < per_cfg.size(); ++m)
+  {
+    if (per_cfg[m])
+      continue;
 
-  proginfo(xml_out);    // Print out basic program info
+    std::ostringstream path;
+    path << "/InlineMeasurements/elem[" << m+1 << "]";
+    XMLReader meas(MeasXML, path.str());
 
-  // Initialise the RNG
-  QDP::RNG::setrn(input.rng_seed);
-  write(xml_out,"RNG", input.rng_seed);
+    if (meas.count(".//*[contains(local-name(),'file')]") == 0)
+      continue;
+
+    std::string name;
+    if (meas.count("Name") > 0)
+      read(meas, "Name", name);
+
+    QDPIO::cerr << "CHROMA: warning: measurement " << m << " (" << name << ") names a file without "
+		<< cfg_token << ", so every config uses the same file" << endl;
+    ++fixed;
+  }
+
+  if (fixed > 0)
+    QDPIO::cerr << "CHROMA: with a CfgList put " << cfg_token 
+		<< " in every output file name; it is replaced by the position of the config in the list" << endl;
+}
 
-  // Start up the config
-  StopWatch swatch;
-  swatch.reset();
-  multi1d<LatticeColorMatrix> u(Nd);
-  XMLReader gauge_file_xml, gauge_xml;
 
+//! Start up a gauge field
+void startGauge(const GroupXML_t& cfg, 
+		XMLReader& gauge_file_xml, XMLReader& gauge_xml,
+		multi1d<LatticeColorMatrix>& u)
+{
   // Start up the gauge field
   QDPIO::cout << "Attempt to read gauge field" << endl;
+  StopWatch swatch;
+  swatch.reset();
   swatch.start();
   try 
   {
-    std::istringstream  xml_c(input.cfg.xml);
+    std::istringstream  xml_c(cfg.xml);
     XMLReader  cfgtop(xml_c);
-    QDPIO::cout << "Gauge initialization: cfg_type = " << input.cfg.id << endl;
+    QDPIO::cout << "Gauge initialization: cfg_type = " << cfg.id << endl;
 
     Handle< GaugeInit >
-      gaugeInit(TheGaugeInitFactory::Instance().createObject(input.cfg.id,
+      gaugeInit(TheGaugeInitFactory::Instance().createObject(cfg.id,
 							     cfgtop,
-							     input.cfg.path));
+							     cfg.path));
     (*gaugeInit)(gauge_file_xml, gauge_xml, u);
   }
   catch(std::bad_cast) 
@@ -188,82 +303,52 @@ int main(int argc, char *argv[])
   QDPIO::cout << "Gauge field successfully read: time= " 
 	      << swatch.getTimeInSeconds() 
 	      << " secs" << endl;
+}
 
-  XMLBufferWriter config_xml;
-  config_xml << gauge_xml;
-
-  // Write out the config header
-  write(xml_out, "Config_info", gauge_xml);
-  
-  // Calculate some gauge invariant observables
-  MesPlq(xml_out, "Observables", u);
-
-  // Get the measurements
-  try 
-  {
-    std::istringstream Measurements_is(input.param.inline_measurement_xml);
-    XMLReader MeasXML(Measurements_is);
-    multi1d < Handle< AbsInlineMeasurement > > the_measurements;
-    read(MeasXML, "/InlineMeasurements", the_measurements);
 
-    QDPIO::cout << "There are " << the_measurements.size() << " measurements " << endl;
+bool linkageHack(void)
+{
+  bool foo = true;
 
-    // Reset and set the default gauge field
-    InlineDefaultGaugeField::reset();
-    InlineDefaultGaugeField::set(u, config_xml);
+  // Inline Measurements
+  foo &= InlineAggregateEnv::registerAll();
+  foo &= GaugeInitEnv::registerAll();
 
-    // Measure inline observables 
-    push(xml_out, "InlineObservables");
-    xml_out.flush();
+  return foo;
+}
 
-    QDPIO::cout << "Doing " << the_measurements.size() 
-		<<" measurements" << endl;
-    swatch.start();
-    unsigned long cur_update = 0;
-    for(int m=0; m < the_measurements.size(); m++) 
-    {
-      AbsInlineMeasurement& the_meas = *(the_measurements[m]);
-      if( cur_update % the_meas.getFrequency() == 0 ) 
-      {
-	// Caller writes elem rule
-	push(xml_out, "elem");
-	the_meas(cur_update, xml_out);
-	pop(xml_out); 
+//! Main program to run all measurement codes
+/*! \defgroup chromamain Main program to run all measurement codes.
+ *  \ingroup main
+ *
+ * Main program to run all measurement codes.
+ */
 
-	xml_out.flush();
-      }
-    }
-    swatch.stop();
+int main(int argc, char *argv[]) 
+{
+  // Chroma Init stuff
+  Chroma::initialize(&argc, &argv);
+  
+  START_CODE();
 
-    QDPIO::cout << "CHROMA measurements: time= " 
-		<< swatch.getTimeInSeconds() 
-		<< " secs" << endl;
+  QDPIO::cout << "Linkage = " << linkageHack() << endl;
 
+  StopWatch snoop;
+  snoop.reset();
+  snoop.start();
 
-    pop(xml_out); // pop("InlineObservables");
+  XMLReader xml_in;
 
-    // Reset the default gauge field
-    InlineDefaultGaugeField::reset();
-  }
-  catch(std::bad_cast) 
+  // Input parameter structure
+  Inline_input_t  input;
+  try
   {
-    QDPIO::cerr << "CHROMA: caught cast error" << endl;
-    QDP_abort(1);
-  }
-  catch(std::bad_alloc) 
-  { 
-    // This might happen on any node, so report it
-    cerr << "CHROMA: caught bad memory allocation" << endl;
-    QDP_abort(1);
+    xml_in.open(Chroma::getXMLInputFileName());
+    read(xml_in, "/chroma", input);
   }
   catch(const std::string& e) 
   {
-    QDPIO::cerr << "CHROMA: Caught Exception: " << e << endl;
-    QDP_abort(1);
-  }
-  catch(const char* e) 
-  { 
-    QDPIO::cout << "CHROMA: Caught const char * exception: " << e << endl;
+    QDPIO::cerr << "CHROMA: Caught Exception reading XML: " << e << endl;
     QDP_abort(1);
   }
   catch(std::exception& e) 
@@ -273,11 +358,168 @@ int main(int argc, char *argv[])
   }
   catch(...)
   {
-    // This might happen on any node, so report it
-    cerr << "CHROMA: caught generic exception during measurement" << endl;
-    cerr << "Rethrowing" << endl;
-    throw;
+    QDPIO::cerr << "CHROMA: caught generic exception reading XML" << endl;
+    QDP_abort(1);
   }
+
+  XMLFileWriter& xml_out = Chroma::getXMLOutputInstance();
+  push(xml_out, "chroma");
+
+  // Write out the input
+  write(xml_out, "Input", xml_in);
+
+  Layout::setLattSize(input.param.nrow);
+  Layout::create();
+
+  proginfo(xml_out);    // Print out basic program info
+
+  // Initialise the RNG
+  QDP::RNG::setrn(input.rng_seed);
+  write(xml_out,"RNG", input.rng_seed);
+
+  // Get the measurements. They live across all the configs, except for
+  // those naming per config files, which are rebuilt for each config.
+  const std::string& meas_xml = input.param.inline_measurement_xml;
+  const multi1d<bool> per_cfg = perCfgMeasurements(meas_xml);
+
+  if (input.cfgs.size() > 1)
+    checkPerCfgFiles(meas_xml, per_cfg);
+
+  multi1d < Handle< AbsInlineMeasurement > > the_measurements;
+  readMeasurements(substituteCfg(meas_xml, 0), the_measurements);
+
+  if (input.stream)
+  {
+    QDPIO::cout << "CHROMA: streaming " << input.cfgs.size() << " configs" << endl;
+    push(xml_out, "Configurations");
+  }
+
+  // Measure each config in turn
+  for(int cfg_num=0; cfg_num < input.cfgs.size(); ++cfg_num)
+  {
+    if (input.stream)
+    {
+      push(xml_out, "elem");
+      write(xml_out, "cfg_num", cfg_num);
+    }
+
+    if (cfg_num > 0)
+      rebuildPerCfgMeasurements(substituteCfg(meas_xml, cfg_num), per_cfg, the_measurements);
+
+    // Start up the config
+    StopWatch swatch;
+    swatch.reset();
+    multi1d<LatticeColorMatrix> u(Nd);
+    NumaAffinityEnv::firstTouch(u);
+    XMLReader gauge_file_xml, gauge_xml;
+
+    // The gauge inits may reallocate, so read into scratch and copy into
+    // the first touched field
+    {
+      multi1d<LatticeColorMatrix> u_read(Nd);
+      startGauge(input.cfgs[cfg_num], gauge_file_xml, gauge_xml, u_read);
+      for(int mu=0; mu < Nd; ++mu)
+	u[mu] = u_read[mu];
+    }
+
+    // Read the next config ahead while this one is measured
+    if (cfg_num+1 < input.cfgs.size())
+      prefetchConfig(input.cfgs[cfg_num+1]);
+
+    XMLBufferWriter config_xml;
+    config_xml << gauge_xml;
+
+    // Write out the config header
+    write(xml_out, "Config_info", gauge_xml);
+  
+    // Calculate some gauge invariant observables
+    MesPlq(xml_out, "Observables", u);
+
+    try 
+    {
+      // Reset and set the default gauge field
+      InlineDefaultGaugeField::reset();
+      InlineDefaultGaugeField::set(u, config_xml);
+
+      // Measure inline observables 
+      push(xml_out, "InlineObservables");
+      xml_out.flush();
+
+      QDPIO::cout << "Doing " << the_measurements.size() 
+		  <<" measurements" << endl;
+      swatch.start();
+      unsigned long cur_update = 0;
+      for(int m=0; m < the_measurements.size(); m++) 
+      {
+	AbsInlineMeasurement& the_meas = *(the_measurements[m]);
+	if( cur_update % the_meas.getFrequency() == 0 ) 
+	{
+	  // Caller writes elem rule
+	  push(xml_out, "elem");
+	  TheNamedObjMap::Instance().newTask();
+	  the_meas(cur_update, xml_out);
+	  pop(xml_out); 
+
+	  xml_out.flush();
+	}
+      }
+      swatch.stop();
+
+      QDPIO::cout << "CHROMA measurements: time= " 
+		  << swatch.getTimeInSeconds() 
+		  << " secs" << endl;
+
+
+      pop(xml_out); // pop("InlineObservables");
+
+      // Reset the default gauge field
+      InlineDefaultGaugeField::reset();
+
+      // Objects made for this config must not clash with the next
+      if (input.stream)
+	TheNamedObjMap::Instance().clear();
+    }
+    catch(std::bad_cast) 
+    {
+      QDPIO::cerr << "CHROMA: caught cast error" << endl;
+      QDP_abort(1);
+    }
+    catch(std::bad_alloc) 
+    { 
+      // This might happen on any node, so report it
+      cerr << "CHROMA: caught bad memory allocation" << endl;
+      QDP_abort(1);
+    }
+    catch(const std::string& e) 
+    {
+      QDPIO::cerr << "CHROMA: Caught Exception: " << e << endl;
+      QDP_abort(1);
+    }
+    catch(const char* e) 
+    { 
+      QDPIO::cout << "CHROMA: Caught const char * exception: " << e << endl;
+      QDP_abort(1);
+    }
+    catch(std::exception& e) 
+    {
+      QDPIO::cerr << "CHROMA: Caught standard library exception: " << e.what() << endl;
+      QDP_abort(1);
+    }
+    catch(...)
+    {
+      // This might happen on any node, so report it
+      cerr << "CHROMA: caught generic exception during measurement" << endl;
+      cerr << "Rethrowing" << endl;
+      throw;
+    }
+
+    if (input.stream)
+      pop(xml_out);  // elem
+  }
+
+  if (input.stream)
+    pop(xml_out);  // Configurations
+
   pop(xml_out);
 
   snoop.stop();
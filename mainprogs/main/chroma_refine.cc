@@ -284,6 +284,7 @@ int main(int argc, char *argv[])
       {
         // Caller writes elem rule
         push(xml_out, "elem");
+        TheNamedObjMap::Instance().newTask();
         the_meas(cur_update, xml_out);
         pop(xml_out); 
 
@@ -581,6 +581,7 @@ namespace Chroma
 	    // Caller writes elem rule 
 	    AbsInlineMeasurement& the_meas = *(default_measurements[m]);
 	    push(xml_out, "elem");
+	    TheNamedObjMap::Instance().newTask();
 	    the_meas(cur_update, xml_out);
 	    pop(xml_out);
 
@@ -601,6 +602,7 @@ namespace Chroma
 		// Caller writes elem rule
 		push(xml_out, "elem");
 		QDPIO::cout << "HMC: calling user measurement number = " << m << endl;
+		TheNamedObjMap::Instance().newTask();
 		the_meas(cur_update, xml_out);
 		QDPIO::cout << "HMC: finished user measurement number = " << m << endl;
 		pop(xml_out); 
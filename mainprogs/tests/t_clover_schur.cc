@@ -0,0 +1,95 @@
+// Test the fused even-odd clover Schur complement against its unfused blocks
+
+#include "chroma.h"
+#include "test_check.h"
+#include "actions/ferm/fermstates/periodic_fermstate.h"
+#include "actions/ferm/linop/eoprec_clover_linop_w.h"
+
+using namespace Chroma;
+
+typedef LatticeFermion               T;
+typedef multi1d<LatticeColorMatrix>  Q;
+
+//! M psi on the odd sites from the blocks: A_oo psi - D_oe A^-1_ee D_eo psi
+void unfusedApply(const EvenOddPrecCloverLinOp& M, T& chi, const T& psi, enum PlusMinus isign)
+{
+  T tmp1, tmp2, tmp3;
+
+  M.evenOddLinOp(tmp1, psi, isign);
+  M.evenEvenInvLinOp(tmp2, tmp1, isign);
+  M.oddEvenLinOp(tmp3, tmp2, isign);
+  M.oddOddLinOp(chi, psi, isign);
+
+  chi[rb[1]] -= tmp3;
+}
+
+//! |x - y| / |y| on the odd sites
+Double relDiff(const T& x, const T& y)
+{
+  T d;
+  d[rb[1]] = x - y;
+  return sqrt(norm2(d, rb[1]) / norm2(y, rb[1]));
+}
+
+int main(int argc, char *argv[])
+{
+  // Put the machine into a known state
+  Chroma::initialize(&argc, &argv);
+
+  // Setup the layout
+  const int foo[] = {4, 4, 4, 8};
+  multi1d<int> nrow(Nd);
+  nrow = foo;
+  Layout::setLattSize(nrow);
+  Layout::create();
+
+  Q u(Nd);
+  for(int mu=0; mu < Nd; ++mu)
+  {
+    gaussian(u[mu]);
+    reunit(u[mu]);
+  }
+
+  CloverFermActParams param;
+  param.Mass = Real(0.1);
+  param.clovCoeffR = Real(1.2);
+  param.clovCoeffT = Real(1.2);
+  param.twisted_m_usedP = false;
+
+  Handle< FermState<T,Q,Q> > state(new PeriodicFermState<T,Q,Q>(u));
+  EvenOddPrecCloverLinOp M(state, param);
+
+  T psi;
+  gaussian(psi);
+
+  const double tol = (sizeof(WordType<T>::Type_t) == sizeof(float)) ? 1.0e-5 : 1.0e-12;
+
+  for(int s=0; s < 2; ++s)
+  {
+    enum PlusMinus isign = (s == 0) ? PLUS : MINUS;
+
+    T fused = zero;
+    T unfused = zero;
+    M(fused, psi, isign);
+    unfusedApply(M, unfused, psi, isign);
+
+    check(toDouble(relDiff(fused, unfused)) < tol,
+	  (isign == PLUS) ? "fused Schur complement, PLUS" : "fused Schur complement, MINUS");
+  }
+
+  // M^dag M against the unfused blocks, applied twice
+  {
+    T mdagm = zero;
+    M.MdagM(mdagm, psi);
+
+    T tmp = zero;
+    T unfused = zero;
+    unfusedApply(M, tmp, psi, PLUS);
+    unfusedApply(M, unfused, tmp, MINUS);
+
+    check(toDouble(relDiff(mdagm, unfused)) < tol, "fused M^dag M");
+  }
+
+  Chroma::finalize();
+  exit(0);
+}
@@ -0,0 +1,81 @@
+// Test the round trip of the compact 12- and 8-real gauge formats
+
+#include "chroma.h"
+#include "test_check.h"
+#include "io/compact_gauge_io.h"
+
+using namespace Chroma;
+
+int main(int argc, char *argv[])
+{
+  // Put the machine into a known state
+  Chroma::initialize(&argc, &argv);
+
+  // Setup the layout
+  const int foo[] = {4, 4, 4, 8};
+  multi1d<int> nrow(Nd);
+  nrow = foo;
+  Layout::setLattSize(nrow);
+  Layout::create();
+
+  // Links rebuilt from unitarity agree to round-off only
+  const double tol = (sizeof(REAL) == sizeof(REAL32)) ? 1.0e-5 : 1.0e-10;
+
+  multi1d<LatticeColorMatrix> u(Nd);
+  Double u_norm = zero;
+  for(int mu=0; mu < Nd; ++mu)
+  {
+    gaussian(u[mu]);
+    reunit(u[mu]);
+    u_norm += norm2(u[mu]);
+  }
+
+  const int reconstructs[] = {12, 8};
+  for(int r=0; r < 2; ++r)
+  {
+    const int reconstruct = reconstructs[r];
+
+    std::ostringstream file;
+    file << "t_compact_gauge_" << reconstruct << ".cfg";
+
+    std::ostringstream what;
+    what << "reconstruct " << reconstruct << ": ";
+
+    XMLBufferWriter file_xml;
+    push(file_xml, "t_compact_gauge");
+    write(file_xml, "reconstruct", reconstruct);
+    pop(file_xml);
+
+    XMLBufferWriter record_xml;
+    push(record_xml, "t_compact_gauge_record");
+    write(record_xml, "nrow", nrow);
+    pop(record_xml);
+
+    writeCompactGauge(file_xml, record_xml, u, file.str(), reconstruct);
+
+    // The reader aborts itself on a checksum mismatch
+    XMLReader file_xml_back, record_xml_back;
+    multi1d<LatticeColorMatrix> u_back(Nd);
+    readCompactGauge(file_xml_back, record_xml_back, u_back, file.str());
+
+    Double diff = zero;
+    for(int mu=0; mu < Nd; ++mu)
+      diff += norm2(u_back[mu] - u[mu]);
+    check(toDouble(sqrt(diff/u_norm)) < tol, what.str() + "links round trip");
+
+    int reconstruct_back;
+    read(file_xml_back, "/t_compact_gauge/reconstruct", reconstruct_back);
+    check(reconstruct_back == reconstruct, what.str() + "file xml");
+
+    multi1d<int> nrow_back;
+    read(record_xml_back, "/t_compact_gauge_record/nrow", nrow_back);
+    bool ok = (nrow_back.size() == Nd);
+    for(int mu=0; mu < Nd && ok; ++mu)
+      if (nrow_back[mu] != nrow[mu])
+	ok = false;
+    check(ok, what.str() + "record xml");
+  }
+
+  Chroma::finalize();
+  exit(0);
+}
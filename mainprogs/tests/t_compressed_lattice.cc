@@ -0,0 +1,142 @@
+// Test the error bounds of compressed lattice fields and the marker of compressed map objects
+
+#include "chroma.h"
+#include "test_check.h"
+#include "qdp_map_obj_memory.h"
+#include "util/ferm/compressed_lattice.h"
+#include "util/ferm/map_obj/map_obj_compressed_w.h"
+
+using namespace Chroma;
+
+//! Is every real of y within the block bound of x?
+template<typename T>
+bool withinBlockBound(const T& x, const T& y)
+{
+  typedef typename CompressedLattice<T>::W  W;
+
+  const int nb = CompressedLattice<T>::blockSize();
+  const int nblock = CompressedLattice<T>::numReals() / nb;
+  const double bound = CompressedLattice<T>::relBlockErrorBound();
+
+  int bad = 0;
+  for(int site=0; site < Layout::sitesOnNode(); ++site)
+  {
+    const W* xs = (const W *)&(x.elem(site));
+    const W* ys = (const W *)&(y.elem(site));
+
+    for(int b=0; b < nblock; ++b, xs += nb, ys += nb)
+    {
+      double m = 0;
+      for(int k=0; k < nb; ++k)
+	m = std::max(m, fabs(double(xs[k])));
+
+      for(int k=0; k < nb; ++k)
+	if (fabs(double(xs[k]) - double(ys[k])) > bound*m)
+	  ++bad;
+    }
+  }
+
+  QDPInternal::globalSum(bad);
+  return (bad == 0);
+}
+
+int main(int argc, char *argv[])
+{
+  // Put the machine into a known state
+  Chroma::initialize(&argc, &argv);
+
+  // Setup the layout
+  const int foo[] = {4, 4, 4, 8};
+  multi1d<int> nrow(Nd);
+  nrow = foo;
+  Layout::setLattSize(nrow);
+  Layout::create();
+
+  typedef CompressedLattice<LatticeFermion>  CF;
+
+  // The norm error follows from the error of each real in its block
+  const double norm_bound = sqrt(double(CF::blockSize())) * CF::relBlockErrorBound();
+
+  LatticeFermion psi;
+  gaussian(psi);
+
+  CF c;
+  c.compress(psi);
+  LatticeFermion psi_back;
+  c.decompress(psi_back);
+
+  check(withinBlockBound(psi, psi_back), "every real within the block error bound");
+  check(toDouble(c.relNormError(psi)) <= norm_bound, "relative norm error within its bound");
+
+  // A field with a zero block and blocks of very different sizes
+  {
+    LatticeColorMatrix u;
+    gaussian(u);
+    u = where(Layout::latticeCoordinate(0) == 0, LatticeColorMatrix(zero), u);
+    u = where(Layout::latticeCoordinate(1) == 0, Real(1.0e-6)*u, u);
+
+    CompressedLattice<LatticeColorMatrix> cu;
+    cu.compress(u);
+    LatticeColorMatrix u_back;
+    cu.decompress(u_back);
+    check(withinBlockBound(u, u_back), "mixed scales within the block error bound");
+  }
+
+  // Through a file
+  {
+    const std::string file = "t_compressed_lattice.bin";
+    {
+      BinaryFileWriter bin(file);
+      write(bin, c);
+      bin.close();
+    }
+
+    CF c_back;
+    {
+      BinaryFileReader bin(file);
+      read(bin, c_back);
+      bin.close();
+    }
+
+    LatticeFermion psi_file;
+    c_back.decompress(psi_file);
+    check(toBool(norm2(psi_file - psi_back) == Double(0)), "file round trip");
+  }
+
+  // The marker in the user data of a compressed map object
+  {
+    const std::string user_data = "<t_compressed_lattice>user data</t_compressed_lattice>";
+
+    check(! isCompressedUserdata(user_data), "plain user data is not compressed");
+    check(! isCompressedUserdata("not xml at all"), "non-xml user data is not compressed");
+
+    std::string wrapped = wrapCompressedUserdata(user_data);
+    check(isCompressedUserdata(wrapped), "wrapped user data is compressed");
+    check(unwrapCompressedUserdata(wrapped) == user_data, "user data unwrapped");
+    check(unwrapCompressedUserdata(user_data) == user_data, "plain user data unwrapped as is");
+
+    // The user data only counts as compressed if the marker leads
+    check(! isCompressedUserdata(user_data + "\n" + wrapped), "marker after user data ignored");
+
+    Handle< QDP::MapObject<int,CF> > store(new MapObjectMemory<int,CF>());
+    MapObjectCompressed<int,LatticeFermion,CF> obj(store);
+
+    obj.insertUserdata(user_data);
+    obj.insert(0, psi);
+
+    std::string u_store;
+    store->getUserdata(u_store);
+    check(isCompressedUserdata(u_store), "map object marked compressed");
+
+    std::string u_back;
+    obj.getUserdata(u_back);
+    check(u_back == user_data, "map object user data");
+
+    LatticeFermion psi_obj;
+    check(obj.get(0, psi_obj) == 0, "map object value found");
+    check(toBool(norm2(psi_obj - psi_back) == Double(0)), "map object value");
+  }
+
+  Chroma::finalize();
+  exit(0);
+}
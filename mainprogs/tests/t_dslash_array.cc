@@ -0,0 +1,91 @@
+// Test the fused array Wilson dslash against the 4D dslash of each slice
+
+#include "chroma.h"
+#include "test_check.h"
+#include "actions/ferm/fermstates/simple_fermstate.h"
+#include "actions/ferm/linop/lwldslash_w.h"
+#include "actions/ferm/linop/lwldslash_array_qdpopt_w.h"
+
+using namespace Chroma;
+
+typedef LatticeFermion               T;
+typedef multi1d<LatticeColorMatrix>  Q;
+
+int main(int argc, char *argv[])
+{
+  // Put the machine into a known state
+  Chroma::initialize(&argc, &argv);
+
+  // Setup the layout
+  const int foo[] = {4, 4, 4, 8};
+  multi1d<int> nrow(Nd);
+  nrow = foo;
+  Layout::setLattSize(nrow);
+  Layout::create();
+
+  // Only the order of the sums differs
+  const double tol = (sizeof(REAL) == sizeof(REAL32)) ? 1.0e-6 : 1.0e-14;
+  const int N5 = 6;
+
+  Q u(Nd);
+  for(int mu=0; mu < Nd; ++mu)
+  {
+    gaussian(u[mu]);
+    reunit(u[mu]);
+  }
+
+  multi1d<int> boundary(Nd);
+  boundary = 1;
+  boundary[Nd-1] = -1;
+  Handle< CreateFermState<T,Q,Q> > cfs(new CreateSimpleFermState<T,Q,Q>(boundary));
+  Handle< FermState<T,Q,Q> > state((*cfs)(u));
+
+  // Anisotropic coefficients, as in an anisotropic action
+  multi1d<Real> coeffs(Nd);
+  coeffs = 1.0;
+  coeffs[Nd-1] = 0.7;
+
+  QDPWilsonDslash D(state, coeffs);
+  QDPWilsonDslashArrayOpt D5;
+  D5.create(state, N5, coeffs);
+
+  multi1d<T> psi(N5);
+  for(int s=0; s < N5; ++s)
+    gaussian(psi[s]);
+
+  for(int isign=0; isign < 2; ++isign)
+  {
+    enum PlusMinus pm = (isign == 0) ? PLUS : MINUS;
+
+    for(int cb=0; cb < 2; ++cb)
+    {
+      std::ostringstream os;
+      os << "isign = " << ((pm == PLUS) ? "PLUS" : "MINUS") << ", cb = " << cb;
+
+      multi1d<T> chi(N5);
+      D5.apply(chi, psi, pm, cb);
+
+      Double diff = zero;
+      Double norm = zero;
+      for(int s=0; s < N5; ++s)
+      {
+	T chi_ref = zero;
+	D.apply(chi_ref, psi[s], pm, cb);
+	diff += norm2(chi[s] - chi_ref, rb[cb]);
+	norm += norm2(chi_ref, rb[cb]);
+      }
+      check(toDouble(sqrt(diff/norm)) < tol, "fused array dslash matches each slice, " + os.str());
+
+      // One slice on its own
+      T chi_1 = zero;
+      T chi_ref = zero;
+      D5.apply(chi_1, psi[0], pm, cb);
+      D.apply(chi_ref, psi[0], pm, cb);
+      check(toDouble(sqrt(norm2(chi_1 - chi_ref, rb[cb]) / norm2(chi_ref, rb[cb]))) < tol, 
+	    "single slice dslash matches, " + os.str());
+    }
+  }
+
+  Chroma::finalize();
+  exit(0);
+}
@@ -0,0 +1,108 @@
+// Test the single pass Asqtad dslash against the Naik term built from shifts
+
+#include "chroma.h"
+#include "test_check.h"
+#include "actions/ferm/fermstates/simple_fermstate.h"
+#include "actions/ferm/fermacts/asqtad_fermact_s.h"
+#include "actions/ferm/linop/asq_dsl_s.h"
+
+using namespace Chroma;
+
+typedef LatticeStaggeredFermion      T;
+typedef multi1d<LatticeColorMatrix>  Q;
+
+//! The Asqtad dslash with the one- and three-hop terms from chained shifts
+void shiftDslash(T& chi, const T& psi, const Q& u_fat, const Q& u_triple, 
+		 enum PlusMinus isign, int cb)
+{
+  chi[rb[cb]] = zero;
+
+  for(int mu=0; mu < Nd; ++mu)
+  {
+    T tmp_0 = shift(psi, FORWARD, mu);
+    T tmp_1 = shift(tmp_0, FORWARD, mu);
+    T tmp_2 = shift(tmp_1, FORWARD, mu);
+    chi[rb[cb]] += u_fat[mu] * tmp_0;
+    chi[rb[cb]] += u_triple[mu] * tmp_2;
+  }
+
+  for(int mu=0; mu < Nd; ++mu)
+  {
+    chi[rb[cb]] -= shift(adj(u_fat[mu]), BACKWARD, mu) * shift(psi, BACKWARD, mu);
+
+    T tmp_0 = shift(adj(u_triple[mu]), BACKWARD, mu) * shift(psi, BACKWARD, mu);
+    T tmp_1 = shift(tmp_0, BACKWARD, mu);
+    T tmp_2 = shift(tmp_1, BACKWARD, mu);
+    chi[rb[cb]] -= tmp_2;
+  }
+
+  if (isign == MINUS)
+    chi[rb[cb]] = -chi;
+}
+
+int main(int argc, char *argv[])
+{
+  // Put the machine into a known state
+  Chroma::initialize(&argc, &argv);
+
+  // Setup the layout
+  const int foo[] = {4, 4, 4, 8};
+  multi1d<int> nrow(Nd);
+  nrow = foo;
+  Layout::setLattSize(nrow);
+  Layout::create();
+
+  // Only the order of the sums differs
+  const double tol = (sizeof(REAL) == sizeof(REAL32)) ? 1.0e-6 : 1.0e-14;
+
+  Q u(Nd);
+  for(int mu=0; mu < Nd; ++mu)
+  {
+    gaussian(u[mu]);
+    reunit(u[mu]);
+  }
+
+  // Antiperiodic in time, so the boundary phases go through the halo
+  multi1d<int> boundary(Nd);
+  boundary = 1;
+  boundary[Nd-1] = -1;
+  Handle< CreateFermState<T,Q,Q> > cfs(new CreateSimpleFermState<T,Q,Q>(boundary));
+
+  AsqtadFermActParams param;
+  param.Mass = 0.1;
+  param.u0 = 1.0;
+  AsqtadFermAct S(cfs, param);
+  Handle<AsqtadConnectStateBase> state(S.createState(u));
+
+  QDPStaggeredDslash D(state);
+
+  T psi;
+  gaussian(psi);
+
+  // Something to spot writes to the other checkerboard
+  T marker;
+  gaussian(marker);
+
+  for(int isign=0; isign < 2; ++isign)
+  {
+    enum PlusMinus pm = (isign == 0) ? PLUS : MINUS;
+
+    for(int cb=0; cb < 2; ++cb)
+    {
+      T chi = marker;
+      T chi_ref = zero;
+      D.apply(chi, psi, pm, cb);
+      shiftDslash(chi_ref, psi, state->getFatLinks(), state->getTripleLinks(), pm, cb);
+
+      Double rel = sqrt(norm2(chi - chi_ref, rb[cb]) / norm2(chi_ref, rb[cb]));
+
+      std::ostringstream os;
+      os << "isign = " << ((pm == PLUS) ? "PLUS" : "MINUS") << ", cb = " << cb;
+      check(toDouble(rel) < tol, "single pass dslash matches, " + os.str());
+      check(toBool(norm2(chi - marker, rb[1-cb]) == Double(0)), "other checkerboard untouched, " + os.str());
+    }
+  }
+
+  Chroma::finalize();
+  exit(0);
+}
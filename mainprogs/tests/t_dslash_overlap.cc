@@ -0,0 +1,75 @@
+// Test the Wilson dslash that overlaps the halo exchange against the QDP dslash
+
+#include "chroma.h"
+#include "test_check.h"
+#include "actions/ferm/fermstates/simple_fermstate.h"
+#include "actions/ferm/linop/lwldslash_w.h"
+#include "actions/ferm/linop/lwldslash_overlap_w.h"
+
+using namespace Chroma;
+
+typedef LatticeFermion               T;
+typedef multi1d<LatticeColorMatrix>  Q;
+
+int main(int argc, char *argv[])
+{
+  // Put the machine into a known state
+  Chroma::initialize(&argc, &argv);
+
+  // Setup the layout
+  const int foo[] = {4, 4, 4, 8};
+  multi1d<int> nrow(Nd);
+  nrow = foo;
+  Layout::setLattSize(nrow);
+  Layout::create();
+
+  // Only the order of the sums differs
+  const double tol = (sizeof(REAL) == sizeof(REAL32)) ? 1.0e-6 : 1.0e-14;
+
+  Q u(Nd);
+  for(int mu=0; mu < Nd; ++mu)
+  {
+    gaussian(u[mu]);
+    reunit(u[mu]);
+  }
+
+  // Antiperiodic in time, so the boundary phases go through the halo
+  multi1d<int> boundary(Nd);
+  boundary = 1;
+  boundary[Nd-1] = -1;
+  Handle< CreateFermState<T,Q,Q> > cfs(new CreateSimpleFermState<T,Q,Q>(boundary));
+  Handle< FermState<T,Q,Q> > state((*cfs)(u));
+
+  // Anisotropic coefficients, as in an anisotropic action
+  multi1d<Real> coeffs(Nd);
+  coeffs = 1.0;
+  coeffs[Nd-1] = 0.7;
+
+  QDPWilsonDslash         D(state, coeffs);
+  QDPWilsonDslashOverlap  D_ov(state, coeffs);
+
+  T psi;
+  gaussian(psi);
+
+  for(int isign=0; isign < 2; ++isign)
+  {
+    enum PlusMinus pm = (isign == 0) ? PLUS : MINUS;
+
+    for(int cb=0; cb < 2; ++cb)
+    {
+      T chi = zero;
+      T chi_ov = zero;
+      D.apply(chi, psi, pm, cb);
+      D_ov.apply(chi_ov, psi, pm, cb);
+
+      Double rel = sqrt(norm2(chi_ov - chi, rb[cb]) / norm2(chi, rb[cb]));
+
+      std::ostringstream os;
+      os << "overlapping dslash matches, isign = " << ((pm == PLUS) ? "PLUS" : "MINUS") << ", cb = " << cb;
+      check(toDouble(rel) < tol, os.str());
+    }
+  }
+
+  Chroma::finalize();
+  exit(0);
+}
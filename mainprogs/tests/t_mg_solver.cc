@@ -0,0 +1,90 @@
+// Test the native Wilson multigrid solver by the true residual of its solutions
+
+#include "chroma.h"
+#include "test_check.h"
+#include "actions/ferm/fermstates/periodic_fermstate.h"
+#include "actions/ferm/linop/unprec_wilson_linop_w.h"
+#include "actions/ferm/invert/syssolver_linop_mg_w.h"
+
+using namespace Chroma;
+
+typedef LatticeFermion               T;
+typedef multi1d<LatticeColorMatrix>  Q;
+
+//! |chi - A psi| / |chi|
+Double trueResidual(const LinearOperator<T>& A, const T& psi, const T& chi)
+{
+  T r;
+  A(r, psi, PLUS);
+  r = chi - r;
+  return sqrt(norm2(r) / norm2(chi));
+}
+
+int main(int argc, char *argv[])
+{
+  // Put the machine into a known state
+  Chroma::initialize(&argc, &argv);
+
+  // Setup the layout
+  const int foo[] = {4, 4, 4, 8};
+  multi1d<int> nrow(Nd);
+  nrow = foo;
+  Layout::setLattSize(nrow);
+  Layout::create();
+
+  Q u(Nd);
+  for(int mu=0; mu < Nd; ++mu)
+  {
+    gaussian(u[mu]);
+    reunit(u[mu]);
+  }
+
+  Handle< FermState<T,Q,Q> > state(new PeriodicFermState<T,Q,Q>(u));
+  Handle< LinearOperator<T> > A(new UnprecWilsonLinOp(state, Real(0.2)));
+
+  SysSolverMGParams invParam;
+  invParam.RsdTarget = 1.0e-6;
+  invParam.MaxIter = 200;
+  invParam.Blocking.resize(Nd);
+  invParam.Blocking = 2;
+  invParam.NumNullVecs = 4;
+  invParam.SubspaceId = "t_mg_solver_subspace";
+
+  T chi;
+  gaussian(chi);
+
+  // The solver stops on the true residual, so that must be within the target
+  {
+    LinOpSysSolverMG solver(A, state, invParam);
+
+    T psi = zero;
+    SystemSolverResults_t res = solver(psi, chi);
+
+    check(res.n_count < invParam.MaxIter, "converged within MaxIter");
+    check(toDouble(trueResidual(*A, psi, chi)) <= toDouble(invParam.RsdTarget), "true residual within the target");
+  }
+
+  // A second solver on the same links keeps the null vectors
+  {
+    const MGSetup& kept = TheNamedObjMap::Instance().getData<MGSetup>(invParam.SubspaceId);
+    const MGTransfer* P_first = kept.P.operator->();
+
+    Handle< LinearOperator<T> > A2(new UnprecWilsonLinOp(state, Real(0.3)));
+    LinOpSysSolverMG solver(A2, state, invParam);
+
+    const MGSetup& reused = TheNamedObjMap::Instance().getData<MGSetup>(invParam.SubspaceId);
+    check(reused.P.operator->() == P_first, "null vectors reused on the same links");
+
+    T psi = zero;
+    SystemSolverResults_t res = solver(psi, chi);
+
+    check(res.n_count < invParam.MaxIter, "converged within MaxIter at another mass");
+    check(toDouble(trueResidual(*A2, psi, chi)) <= toDouble(invParam.RsdTarget), 
+	  "true residual within the target at another mass");
+  }
+
+  TheNamedObjMap::Instance().erase(invParam.SubspaceId);
+
+  Chroma::finalize();
+  exit(0);
+}
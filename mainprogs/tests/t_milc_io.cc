@@ -0,0 +1,133 @@
+// Test the round trip of a MILC gauge file and its checksums
+
+#include "chroma.h"
+#include "test_check.h"
+#include "io/milc_io.h"
+#include "io/slab_io.h"
+
+using namespace Chroma;
+
+//! Rotate left as in MILC
+unsigned int rotl(unsigned int val, int r)
+{
+  return (r == 0) ? val : ((val << r) | (val >> (32-r)));
+}
+
+//! MILC checksums summed one site at a time, the way MILC does it
+void serialChecksums(const multi1d<LatticeColorMatrixF>& u, 
+		     unsigned int& sum29, unsigned int& sum31)
+{
+  const int site_words = Nd*2*Nc*Nc;
+  sum29 = 0;
+  sum31 = 0;
+
+  for(int site=0; site < Layout::sitesOnNode(); ++site)
+  {
+    unsigned long lex = local_site(Layout::siteCoords(Layout::nodeNumber(), site), 
+				   Layout::lattSize());
+
+    for(int mu=0; mu < Nd; ++mu)
+    {
+      const unsigned int* val = (const unsigned int*)&(u[mu].elem(site).elem());
+
+      for(int k=0; k < 2*Nc*Nc; ++k)
+      {
+	unsigned long rank = lex*site_words + mu*2*Nc*Nc + k;
+	sum29 ^= rotl(val[k], rank % 29);
+	sum31 ^= rotl(val[k], rank % 31);
+      }
+    }
+  }
+
+  unsigned int sums[2] = {sum29, sum31};
+  globalXor(sums, 2);
+  sum29 = sums[0];
+  sum31 = sums[1];
+}
+
+int main(int argc, char *argv[])
+{
+  // Put the machine into a known state
+  Chroma::initialize(&argc, &argv);
+
+  // Setup the layout
+  const int foo[] = {4, 4, 4, 8};
+  multi1d<int> nrow(Nd);
+  nrow = foo;
+  Layout::setLattSize(nrow);
+  Layout::create();
+
+  const std::string file = "t_milc_io.milc";
+
+  multi1d<LatticeColorMatrix> u(Nd);
+  multi1d<LatticeColorMatrixF> u_single(Nd);
+  for(int mu=0; mu < Nd; ++mu)
+  {
+    gaussian(u[mu]);
+    reunit(u[mu]);
+    u_single[mu] = u[mu];
+  }
+
+  // The threaded checksums against the serial ones
+  unsigned int sum29, sum31;
+  milcChecksums(u_single, sum29, sum31);
+
+  unsigned int serial29, serial31;
+  serialChecksums(u_single, serial29, serial31);
+  check(sum29 == serial29 && sum31 == serial31, "threaded checksums match serial ones");
+
+  // Write, then look at the checksums in the header
+  MILCGauge_t header;
+  writeMILC(header, u, file);
+  {
+    BinaryFileReader bin(file);
+
+    int magic;
+    read(bin, magic);
+    check(magic == 20103, "magic number");
+
+    multi1d<int> file_nrow(Nd);
+    read(bin, file_nrow, Nd);
+    bool ok = true;
+    for(int mu=0; mu < Nd; ++mu)
+      if (file_nrow[mu] != nrow[mu])
+	ok = false;
+    check(ok, "lattice size in the header");
+
+    char date[64];
+    bin.readArray(date, 1, 64);
+
+    int order;
+    read(bin, order);
+
+    unsigned int file29, file31;
+    read(bin, file29);
+    read(bin, file31);
+    check(file29 == sum29 && file31 == sum31, "checksums in the header");
+
+    bin.close();
+  }
+
+  // Read back. The reader aborts itself on a checksum mismatch.
+  MILCGauge_t header_back;
+  multi1d<LatticeColorMatrixF> u_back(Nd);
+  readMILC(header_back, u_back, file);
+
+  Double diff = zero;
+  for(int mu=0; mu < Nd; ++mu)
+    diff += norm2(u_back[mu] - u_single[mu]);
+  check(toBool(diff == Double(0)), "links round trip");
+
+  bool ok = true;
+  for(int mu=0; mu < Nd; ++mu)
+    if (header_back.nrow[mu] != nrow[mu])
+      ok = false;
+  check(ok, "lattice size read back");
+
+  unsigned int back29, back31;
+  milcChecksums(u_back, back29, back31);
+  check(back29 == sum29 && back31 == sum31, "checksums of the links read back");
+
+  Chroma::finalize();
+  exit(0);
+}
@@ -0,0 +1,80 @@
+// Test the spilling of named objects to scratch under a memory budget
+
+#include "chroma.h"
+#include "test_check.h"
+
+using namespace Chroma;
+
+int main(int argc, char *argv[])
+{
+  // Put the machine into a known state
+  Chroma::initialize(&argc, &argv);
+
+  // Setup the layout
+  const int foo[] = {4, 4, 4, 8};
+  multi1d<int> nrow(Nd);
+  nrow = foo;
+  Layout::setLattSize(nrow);
+  Layout::create();
+
+  // A single object, spilled and reloaded by hand
+  {
+    NamedObject<LatticeFermion> obj;
+    gaussian(obj.getData());
+    LatticeFermion orig = obj.getData();
+
+    const size_t bytes = obj.spillBytes();
+    check(bytes == Layout::sitesOnNode() * sizeof(LatticeFermion::Subtype_t), "spill bytes of a field");
+
+    std::ostringstream file;
+    file << "./t_named_obj_spill_" << Layout::nodeNumber() << ".bin";
+    obj.spill(file.str());
+    check(! obj.resident(), "field not resident after spill");
+    check(obj.spillBytes() == bytes, "spill bytes kept after spill");
+
+    obj.reload();
+    check(obj.resident(), "field resident after reload");
+    check(toBool(norm2(obj.getData() - orig) == Double(0)), "field round trip");
+  }
+
+  // Objects spilled by the map to keep to a budget
+  NamedObjectMap map;
+
+  map.create<LatticeFermion>("psi");
+  gaussian(map.getData<LatticeFermion>("psi"));
+  LatticeFermion psi = map.getData<LatticeFermion>("psi");
+
+  map.create< multi1d<LatticeColorMatrix> >("u");
+  map.getData< multi1d<LatticeColorMatrix> >("u").resize(Nd);
+  for(int mu=0; mu < Nd; ++mu)
+    gaussian(map.getData< multi1d<LatticeColorMatrix> >("u")[mu]);
+  multi1d<LatticeColorMatrix> u = map.getData< multi1d<LatticeColorMatrix> >("u");
+
+  const size_t psi_bytes = Layout::sitesOnNode() * sizeof(LatticeFermion::Subtype_t);
+  const size_t u_bytes   = Nd * Layout::sitesOnNode() * sizeof(LatticeColorMatrix::Subtype_t);
+  check(map.residentBytes() == psi_bytes + u_bytes, "resident bytes before the budget");
+
+  // Room for the gauge field only: the older fermion goes to scratch
+  map.newTask();
+  map.setMemoryBudget(u_bytes, ".");
+  check(map.residentBytes() == u_bytes, "resident bytes drop when the fermion is spilled");
+
+  // Looking the fermion up brings it back and spills the gauge field
+  map.newTask();
+  check(toBool(norm2(map.getData<LatticeFermion>("psi") - psi) == Double(0)), "fermion round trip");
+  check(map.residentBytes() == psi_bytes, "resident bytes drop when the gauge field is spilled");
+
+  map.newTask();
+  const multi1d<LatticeColorMatrix>& u_back = map.getData< multi1d<LatticeColorMatrix> >("u");
+  check(u_back.size() == Nd, "gauge field size after reload");
+
+  Double diff = zero;
+  for(int mu=0; mu < Nd; ++mu)
+    diff += norm2(u_back[mu] - u[mu]);
+  check(toBool(diff == Double(0)), "gauge field round trip");
+
+  map.clear();
+
+  Chroma::finalize();
+  exit(0);
+}
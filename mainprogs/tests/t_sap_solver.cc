@@ -0,0 +1,77 @@
+// Test the SAP preconditioned clover solver by the true residual of its solutions
+
+#include "chroma.h"
+#include "test_check.h"
+#include "actions/ferm/fermstates/periodic_fermstate.h"
+#include "actions/ferm/linop/unprec_clover_linop_w.h"
+#include "actions/ferm/invert/syssolver_linop_sap_clover.h"
+
+using namespace Chroma;
+
+typedef LatticeFermion               T;
+typedef multi1d<LatticeColorMatrix>  Q;
+
+//! |chi - A psi| / |chi|
+Double trueResidual(const LinearOperator<T>& A, const T& psi, const T& chi)
+{
+  T r;
+  A(r, psi, PLUS);
+  r = chi - r;
+  return sqrt(norm2(r) / norm2(chi));
+}
+
+int main(int argc, char *argv[])
+{
+  // Put the machine into a known state
+  Chroma::initialize(&argc, &argv);
+
+  // Setup the layout
+  const int foo[] = {4, 4, 4, 8};
+  multi1d<int> nrow(Nd);
+  nrow = foo;
+  Layout::setLattSize(nrow);
+  Layout::create();
+
+  Q u(Nd);
+  for(int mu=0; mu < Nd; ++mu)
+  {
+    gaussian(u[mu]);
+    reunit(u[mu]);
+  }
+
+  Handle< FermState<T,Q,Q> > state(new PeriodicFermState<T,Q,Q>(u));
+
+  SysSolverSAPCloverParams invParam;
+  invParam.clovParams.Mass = 0.2;
+  invParam.clovParams.clovCoeffR = 1.0;
+  invParam.clovParams.clovCoeffT = 1.0;
+  invParam.RsdTarget = 1.0e-6;
+  invParam.MaxIter = 200;
+  invParam.Blocking.resize(Nd);
+  invParam.Blocking = 2;
+
+  Handle< LinearOperator<T> > A(new UnprecCloverLinOp(state, invParam.clovParams));
+
+  T chi;
+  gaussian(chi);
+
+  // The outer solver stops on the true residual, so that must be within
+  // the target with the blocks in either precision
+  for(int single=0; single < 2; ++single)
+  {
+    invParam.singlePrecBlocks = (single == 1);
+    const std::string prec = (single == 1) ? "single" : "double";
+
+    LinOpSysSolverSAPClover solver(A, state, invParam);
+
+    T psi = zero;
+    SystemSolverResults_t res = solver(psi, chi);
+
+    check(res.n_count < invParam.MaxIter, "converged within MaxIter, " + prec + " precision blocks");
+    check(toDouble(trueResidual(*A, psi, chi)) <= toDouble(invParam.RsdTarget), 
+	  "true residual within the target, " + prec + " precision blocks");
+  }
+
+  Chroma::finalize();
+  exit(0);
+}
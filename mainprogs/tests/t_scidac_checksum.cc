@@ -0,0 +1,113 @@
+// Test the threaded SciDAC checksum against the CRC32 reference and a serial sum
+
+#include "chroma.h"
+#include "test_check.h"
+#include "io/scidac_checksum.h"
+
+using namespace Chroma;
+
+//! Rotate left as in QIO
+unsigned int rotl(unsigned int val, int r)
+{
+  return (r == 0) ? val : ((val << r) | (val >> (32-r)));
+}
+
+//! SciDAC checksum of a record of fields summed one site at a time
+template<typename T>
+void serialChecksum(const multi1d< OLattice<T> >& x, ScidacChecksum_t& sum)
+{
+  typedef typename WordType<T>::Type_t W;
+
+  const int nw = sizeof(T) / sizeof(W);
+  sum.suma = 0;
+  sum.sumb = 0;
+
+  for(int site=0; site < Layout::sitesOnNode(); ++site)
+  {
+    int lex = local_site(Layout::siteCoords(Layout::nodeNumber(), site), Layout::lattSize());
+
+    // The words of the site big endian, byte by byte
+    std::vector<unsigned char> buf;
+    for(int i=0; i < x.size(); ++i)
+    {
+      const unsigned char* w = (const unsigned char*)&(x[i].elem(site));
+      for(int k=0; k < nw; ++k, w += sizeof(W))
+	for(int b=0; b < sizeof(W); ++b)
+	  buf.push_back(QDPUtil::big_endian() ? w[b] : w[sizeof(W)-1-b]);
+    }
+
+    unsigned int crc = scidacCRC32(0, &buf[0], buf.size());
+    sum.suma ^= rotl(crc, lex % 29);
+    sum.sumb ^= rotl(crc, lex % 31);
+  }
+
+  unsigned int sums[2] = {sum.suma, sum.sumb};
+  globalXor(sums, 2);
+  sum.suma = sums[0];
+  sum.sumb = sums[1];
+}
+
+int main(int argc, char *argv[])
+{
+  // Put the machine into a known state
+  Chroma::initialize(&argc, &argv);
+
+  // Setup the layout
+  const int foo[] = {4, 4, 4, 8};
+  multi1d<int> nrow(Nd);
+  nrow = foo;
+  Layout::setLattSize(nrow);
+  Layout::create();
+
+  // The standard check value of CRC32, in one go and in two pieces
+  {
+    const unsigned char msg[] = "123456789";
+    check(scidacCRC32(0, msg, 9) == 0xcbf43926U, "CRC32 check value");
+    check(scidacCRC32(scidacCRC32(0, msg, 4), msg+4, 5) == 0xcbf43926U, "CRC32 continued");
+    check(scidacCRC32(0, msg, 0) == 0, "CRC32 of nothing");
+  }
+
+  // A gauge field as one record
+  multi1d<LatticeColorMatrix> u(Nd);
+  for(int mu=0; mu < Nd; ++mu)
+    gaussian(u[mu]);
+
+  ScidacChecksum_t sum, serial;
+  scidacChecksum(u, sum);
+  serialChecksum(u, serial);
+  check(sum.suma == serial.suma && sum.sumb == serial.sumb, "threaded gauge checksum matches serial one");
+
+  // In single precision, as written by a single precision record
+  {
+    multi1d<LatticeColorMatrixF> uf(Nd);
+    for(int mu=0; mu < Nd; ++mu)
+      uf[mu] = u[mu];
+
+    scidacChecksum(uf, sum);
+    serialChecksum(uf, serial);
+    check(sum.suma == serial.suma && sum.sumb == serial.sumb, "threaded single precision checksum matches serial one");
+  }
+
+  // A single field is a record of one
+  {
+    LatticeFermion psi;
+    gaussian(psi);
+
+    multi1d<LatticeFermion> one(1);
+    one[0] = psi;
+
+    scidacChecksum(psi, sum);
+    serialChecksum(one, serial);
+    check(sum.suma == serial.suma && sum.sumb == serial.sumb, "threaded fermion checksum matches serial one");
+
+    // Any change shows up
+    psi = where(Layout::latticeCoordinate(0) == 0 && Layout::latticeCoordinate(Nd-1) == 0, 
+		Real(2)*psi, psi);
+    ScidacChecksum_t changed;
+    scidacChecksum(psi, changed);
+    check(changed.suma != sum.suma || changed.sumb != sum.sumb, "changed field has a different checksum");
+  }
+
+  Chroma::finalize();
+  exit(0);
+}
@@ -0,0 +1,114 @@
+// Test the round trip of a sharded key/value DB and its merge into one file
+
+#include "chroma.h"
+#include "test_check.h"
+#include "util/ferm/sharded_db.h"
+
+using namespace Chroma;
+
+typedef SerialDBKey<int>                 Key_t;
+typedef SerialDBData< multi1d<Real> >    Val_t;
+
+//! The value stored under key k
+multi1d<Real> value(int k)
+{
+  multi1d<Real> v(k % 7 + 1);
+  for(int j=0; j < v.size(); ++j)
+    v[j] = Real(1.5*k + j);
+  return v;
+}
+
+//! Does a value match the one stored under key k?
+bool sameValue(const multi1d<Real>& v, int k)
+{
+  multi1d<Real> w = value(k);
+  if (v.size() != w.size())
+    return false;
+
+  for(int j=0; j < v.size(); ++j)
+    if (toBool(v[j] != w[j]))
+      return false;
+
+  return true;
+}
+
+int main(int argc, char *argv[])
+{
+  // Put the machine into a known state
+  Chroma::initialize(&argc, &argv);
+
+  // Setup the layout
+  const int foo[] = {4, 4, 4, 8};
+  multi1d<int> nrow(Nd);
+  nrow = foo;
+  Layout::setLattSize(nrow);
+  Layout::create();
+
+  const std::string file = "t_sharded_db.sdb";
+  const std::string merged_file = "t_sharded_db.merged.sdb";
+  const std::string user_data = "<t_sharded_db>user data</t_sharded_db>";
+  const int num_keys = 200;
+
+  // Write with a shard on every node
+  {
+    ShardedStoreDB<Key_t,Val_t> db;
+    db.setNumShards(Layout::numNodes());
+    db.setMaxUserInfoLen(user_data.size());
+    db.open(file, O_RDWR | O_CREAT, 0664);
+    db.insertUserdata(user_data);
+
+    for(int k=0; k < num_keys; ++k)
+      db.insert(Key_t(k), Val_t(value(k)));
+
+    db.close();
+  }
+
+  // Read back, with the number of shards taken from the manifest
+  {
+    ShardedStoreDB<Key_t,Val_t> db;
+    db.open(file, O_RDONLY, 0400);
+    check(db.numShards() == Layout::numNodes(), "number of shards from the manifest");
+
+    std::string u;
+    db.getUserdata(u);
+    check(u == user_data, "user data");
+
+    std::vector<Key_t> keys;
+    db.keys(keys);
+    check(keys.size() == num_keys, "number of keys");
+
+    bool ok = true;
+    for(int k=0; k < num_keys; ++k)
+    {
+      Val_t v;
+      if (db.get(Key_t(k), v) != 0 || ! sameValue(v.data(), k))
+	ok = false;
+    }
+    check(ok, "values of every key");
+
+    check(! db.exist(Key_t(num_keys)), "missing key not found");
+  }
+
+  // Merge into one file and read that as an ordinary DB
+  mergeShardedDB<Key_t,Val_t>(file, merged_file);
+  {
+    BinaryStoreDB<Key_t,Val_t> db;
+    db.open(merged_file, O_RDONLY, 0400);
+
+    std::vector<Key_t> keys;
+    db.keys(keys);
+    check(keys.size() == num_keys, "number of keys after the merge");
+
+    bool ok = true;
+    for(int k=0; k < num_keys; ++k)
+    {
+      Val_t v;
+      if (db.get(Key_t(k), v) != 0 || ! sameValue(v.data(), k))
+	ok = false;
+    }
+    check(ok, "values of every key after the merge");
+  }
+
+  Chroma::finalize();
+  exit(0);
+}
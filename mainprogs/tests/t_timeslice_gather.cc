@@ -0,0 +1,69 @@
+// Test that a field gathered once splits into the time slice records QDP writes
+
+#include "chroma.h"
+#include "test_check.h"
+#include "qdp_disk_map_slice.h"
+#include "io/slab_io.h"
+
+using namespace Chroma;
+
+//! Does every slice of one gather match the TimeSliceIO record of that slice?
+template<typename T>
+bool sameSlices(OLattice<T>& f, const SiteSlab& slab)
+{
+  std::vector<char> buf;
+  gatherLexico(f, slab, buf);
+
+  const int Lt = Layout::lattSize()[Nd-1];
+  const size_t slice_bytes = sizeof(T) * (Layout::vol() / Lt);
+
+  int ok = 1;
+  for(int t=0; t < Lt; ++t)
+  {
+    BinaryBufferWriter bin;
+    write(bin, TimeSliceIO< OLattice<T> >(f, t));
+
+    if (Layout::primaryNode())
+    {
+      std::string rec = bin.strPrimaryNode();
+      if (rec.size() != slice_bytes || rec.compare(0, slice_bytes, &buf[t*slice_bytes], slice_bytes) != 0)
+	ok = 0;
+    }
+  }
+  QDPInternal::broadcast(ok);
+
+  return (ok == 1);
+}
+
+int main(int argc, char *argv[])
+{
+  // Put the machine into a known state
+  Chroma::initialize(&argc, &argv);
+
+  // Setup the layout
+  const int foo[] = {4, 4, 4, 8};
+  multi1d<int> nrow(Nd);
+  nrow = foo;
+  Layout::setLattSize(nrow);
+  Layout::create();
+
+  multi1d<int> lex(Layout::vol());
+  for(int i=0; i < lex.size(); ++i)
+    lex[i] = i;
+  SiteSlab slab(lex);
+
+  LatticeColorVector v;
+  gaussian(v);
+  check(sameSlices(v, slab), "colour vector slices");
+
+  LatticeColorMatrix u;
+  gaussian(u);
+  check(sameSlices(u, slab), "colour matrix slices");
+
+  LatticePropagator q;
+  gaussian(q);
+  check(sameSlices(q, slab), "propagator slices");
+
+  Chroma::finalize();
+  exit(0);
+}
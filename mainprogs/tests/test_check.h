@@ -0,0 +1,23 @@
+// -*- C++ -*-
+/*! \file
+ * \brief Pass/fail reporting shared by the self-checking test codes
+ */
+
+#ifndef __test_check_h__
+#define __test_check_h__
+
+#include "chroma.h"
+
+namespace Chroma
+{
+  //! Report a check and abort on failure
+  /*! \ingroup testsmain */
+  inline void check(bool ok, const std::string& what)
+  {
+    QDPIO::cout << what << ": " << ((ok) ? "PASSED" : "FAILED") << endl;
+    if (! ok)
+      QDP_abort(1);
+  }
+}
+
+#endif